@@ -0,0 +1,499 @@
+/*
+File:		AsyncLog.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@17:10
+Purpose:	Contains the asynchronous log manager which captures log records
+			into per-thread lock-free ring buffers and formats and writes them
+			on a background thread
+*/
+
+#ifndef LUNALL_ASYNC_LOG_H
+#define LUNALL_ASYNC_LOG_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace LunaLL {
+	// Enumeration of the severities of log records
+	enum LogLevel {
+		LOG_TRACE,
+		LOG_DEBUG,
+		LOG_INFO,
+		LOG_WARNING,
+		LOG_ERROR,
+		LOG_FATAL,
+		LOG_NONE,
+	};
+
+// The least severe level compiled into log statements, records below it cost
+// nothing at runtime
+#ifndef LUNALL_MINIMUM_LOG_LEVEL
+#ifdef NDEBUG
+#define LUNALL_MINIMUM_LOG_LEVEL LunaLL::LOG_INFO
+#else
+#define LUNALL_MINIMUM_LOG_LEVEL LunaLL::LOG_TRACE
+#endif
+#endif
+
+// Write a log record from a source at a level (TRACE, DEBUG, INFO, WARNING,
+// ERROR, or FATAL), the arguments are not evaluated when the level is
+// filtered out
+#define LUNALL_LOG(SRC, LVL, ...) do { \
+	if constexpr (LunaLL::LOG_##LVL >= LUNALL_MINIMUM_LOG_LEVEL) { \
+		if (LunaLL::AsyncLogManager::Log.isEnabled(LunaLL::LOG_##LVL)) { \
+			LunaLL::AsyncLogManager::Log.write(#SRC, LunaLL::LOG_##LVL, \
+				__VA_ARGS__); \
+		} \
+	} \
+} while (0)
+
+	// Settings of an asynchronous log manager's buffers and sinks
+	struct LogConfiguration {
+		// The least severe level written
+		LogLevel level = LOG_INFO;
+		// The size in bytes of each thread's ring buffer, rounded up to a
+		// power of two
+		size_t threadBufferSize = 1 << 16;
+		// The largest number of live threads with ring buffers, records from
+		// further threads are dropped until a thread with a buffer exits
+		unsigned int maximumThreadCount = 64;
+		// The longest time in milliseconds records wait before being written
+		unsigned int flushInterval = 10;
+		// Whether to write formatted records to the console
+		bool console = true;
+		// The files to write formatted records to
+		std::vector<std::string> textFileNames;
+		// The file to write binary records to, or empty for none
+		std::string binaryFileName = "";
+	};
+
+	// Counts of the records handled by an asynchronous log manager
+	struct LogStatistics {
+		// The number of records written to the sinks
+		uint64_t recordsWritten = 0;
+		// The number of records dropped because their thread's buffer was
+		// full or no buffer was available
+		uint64_t recordsDropped = 0;
+		// The number of batches of records written to the sinks
+		uint64_t batchesWritten = 0;
+		// The number of threads with ring buffers
+		unsigned int threadBufferCount = 0;
+	};
+
+	// A log which captures records on the calling thread into a lock-free
+	// ring buffer owned by that thread and formats and writes them in
+	// batches on a background thread, writing synchronously through the
+	// ActiasFW application's log until it is initialized
+	class AsyncLogManager {
+	public:
+		// The log written to by LUNALL_LOG
+		static AsyncLogManager Log;
+		// The first bytes of a binary log file
+		static const std::string BINARY_LOG_MAGIC;
+		// The version of the binary log format
+		static constexpr uint32_t BINARY_LOG_VERSION = 1;
+
+		/*
+		Stop this log's background thread if it is still running
+		*/
+		~AsyncLogManager();
+		/*
+		Open this log's sinks and start its background thread
+		Parameter: const LogConfiguration& configuration - The settings of this
+		log's buffers and sinks
+		Returns: bool - Whether every sink was opened
+		*/
+		bool initialize(const LogConfiguration&);
+		/*
+		Test whether records at a level are written
+		Parameter: LogLevel level - The level
+		Returns: bool - Whether the level is enabled
+		*/
+		bool isEnabled(LogLevel level) const {
+			return level >= m_level.load(std::memory_order_relaxed);
+		}
+		/*
+		Set the least severe level written
+		Parameter: LogLevel level - The new level
+		*/
+		void setLevel(LogLevel);
+		/*
+		Get the least severe level written
+		Returns: LogLevel - The level
+		*/
+		LogLevel getLevel() const;
+		/*
+		Capture a record into the calling thread's ring buffer, arithmetic
+		values, pointers, and strings are copied as they are, other values are
+		formatted on the calling thread with their << operator
+		Parameter: const char* source - The name of the record's source, which
+		must remain in memory while this log runs
+		Parameter: LogLevel level - The level of the record
+		Parameter: const T&... arguments - The values to write, concatenated
+		*/
+		template <typename... T>
+		void write(const char* source, LogLevel level,
+			const T&... arguments) {
+			encode(source, level, toEncodable(arguments)...);
+		}
+		/*
+		Block until every record captured before this call has been written
+		*/
+		void flush();
+		/*
+		Get counts of the records handled by this log
+		Returns: LogStatistics - This log's statistics
+		*/
+		LogStatistics getStatistics() const;
+		/*
+		Write the remaining records, stop this log's background thread and
+		close its sinks, no other thread may write to this log during this
+		call
+		*/
+		void destroy();
+		/*
+		Decode a binary log file into formatted records
+		Parameter: const std::string& fileName - The binary log file
+		Parameter: std::ostream& output - The stream to write the records to
+		Returns: bool - Whether the whole file was decoded
+		*/
+		static bool decode(const std::string&, std::ostream&);
+
+	private:
+		// Enumeration of the types of values encoded in a record
+		enum ArgumentType : uint8_t {
+			ARGUMENT_SIGNED,
+			ARGUMENT_UNSIGNED,
+			ARGUMENT_FLOATING,
+			ARGUMENT_BOOL,
+			ARGUMENT_CHAR,
+			ARGUMENT_STRING,
+			ARGUMENT_POINTER,
+		};
+
+		// The start of every record in a ring buffer
+		struct RecordHeader {
+			// The size of the record including this header, a multiple of 8
+			uint32_t size = 0;
+			// The level of the record, or PADDING_LEVEL if the rest of the
+			// buffer before its end is unused
+			uint8_t level = 0;
+			// The number of encoded values after this header
+			uint8_t argumentCount = 0;
+			// The size of the encoded values
+			uint16_t argumentSize = 0;
+			// The name of the record's source
+			const char* source = 0;
+			// The time of the record in nanoseconds since the epoch
+			int64_t timestamp = 0;
+		};
+
+		// A single producer, single consumer ring buffer of one thread's
+		// records
+		struct ThreadBuffer {
+			// The records
+			std::unique_ptr<uint8_t[]> data;
+			// The size of the data, a power of two
+			size_t capacity = 0;
+			// The index of this buffer's thread in the order threads first
+			// logged
+			uint32_t threadIndex = 0;
+			// The total bytes written by the producing thread
+			alignas(64) std::atomic<uint64_t> head = 0;
+			// The total bytes reserved by the producing thread, including the
+			// record being encoded
+			uint64_t reservedHead = 0;
+			// The consumer's total bytes read as last seen by the producer
+			uint64_t cachedTail = 0;
+			// The total bytes read by the background thread
+			alignas(64) std::atomic<uint64_t> tail = 0;
+			// The records dropped since the background thread last checked
+			std::atomic<uint64_t> dropped = 0;
+			// Whether the producing thread has exited
+			std::atomic<bool> closed = false;
+		};
+
+		// The largest encoded size of a record's values
+		static constexpr size_t MAXIMUM_ARGUMENT_SIZE = 0xFFFF;
+		// The level marking padding at the end of a ring buffer
+		static constexpr uint8_t PADDING_LEVEL = 0xFF;
+
+		// The least severe level written
+		std::atomic<int> m_level = LOG_INFO;
+		// The settings of this log's buffers and sinks
+		LogConfiguration m_configuration;
+		// Whether this log's background thread is running
+		std::atomic<bool> m_running = false;
+		// Incremented whenever this log is initialized so threads replace
+		// buffers from earlier runs
+		std::atomic<uint32_t> m_generation = 0;
+		// The ring buffers of every thread which has logged
+		std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+		// The number of threads given ring buffers in this run, which numbers
+		// their buffers
+		uint32_t m_threadCount = 0;
+		// Records dropped before reaching a thread's buffer, because they
+		// were too large or their thread had no buffer
+		std::atomic<uint64_t> m_unbufferedDropped = 0;
+		// The lock on the buffer list and flush counters
+		mutable std::mutex m_mutex;
+		// Signalled to wake the background thread
+		std::condition_variable m_wake;
+		// Signalled when the background thread finishes a batch
+		std::condition_variable m_flushed;
+		// The number of flushes requested
+		uint64_t m_flushesRequested = 0;
+		// The number of flushes completed
+		uint64_t m_flushesCompleted = 0;
+		// The background thread
+		std::thread m_thread;
+		// The text file sinks
+		std::vector<std::ofstream> m_textFiles;
+		// The binary file sink
+		std::ofstream m_binaryFile;
+		// The IDs of the sources defined in the binary file so far
+		std::unordered_map<const char*, uint16_t> m_binarySources;
+		// Counts of the records handled
+		std::atomic<uint64_t> m_recordsWritten = 0;
+		// Counts of the records dropped
+		std::atomic<uint64_t> m_recordsDropped = 0;
+		// Counts of the batches written
+		std::atomic<uint64_t> m_batchesWritten = 0;
+
+		/*
+		Convert a value to a type which can be encoded in a record
+		Parameter: const T& value - The value
+		Returns: The value itself, or the value formatted as a string
+		*/
+		template <typename T>
+		static decltype(auto) toEncodable(const T& value) {
+			if constexpr (std::is_arithmetic_v<T> || std::is_pointer_v<T>
+				|| std::is_array_v<T> || std::is_same_v<T, std::string>
+				|| std::is_same_v<T, std::string_view>) {
+				return (value);
+			}
+			else {
+				std::ostringstream stream;
+				stream << value;
+				return stream.str();
+			}
+		}
+		/*
+		Test whether a type is encoded as a single character
+		Returns: bool - Whether the type is a character
+		*/
+		template <typename T>
+		static constexpr bool isCharacter() {
+			return std::is_same_v<T, char> || std::is_same_v<T, signed char>
+				|| std::is_same_v<T, unsigned char>;
+		}
+		/*
+		Test whether a type is encoded as a string
+		Returns: bool - Whether the type is a string
+		*/
+		template <typename T>
+		static constexpr bool isString() {
+			typedef std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>
+				Element;
+			return std::is_same_v<T, std::string>
+				|| std::is_same_v<T, std::string_view>
+				|| ((std::is_pointer_v<std::decay_t<T>>)
+				&& isCharacter<Element>());
+		}
+		/*
+		Get a string value as a view
+		Parameter: const T& value - The string value
+		Returns: std::string_view - The view, empty if the value is null
+		*/
+		template <typename T>
+		static std::string_view getView(const T& value) {
+			if constexpr (std::is_pointer_v<T>) {
+				return value == 0 ? std::string_view()
+					: std::string_view((const char*)value);
+			}
+			else if constexpr (std::is_array_v<T>) {
+				return std::string_view((const char*)value);
+			}
+			else {
+				return std::string_view(value);
+			}
+		}
+		/*
+		Get the encoded size of a value
+		Parameter: const T& value - The value
+		Returns: size_t - The size in bytes including its type
+		*/
+		template <typename T>
+		static size_t getEncodedSize(const T& value) {
+			if constexpr (isString<T>()) {
+				return 1 + sizeof(uint32_t) + getView(value).size();
+			}
+			else if constexpr (std::is_same_v<T, bool> || isCharacter<T>()) {
+				return 2;
+			}
+			else {
+				return 1 + sizeof(uint64_t);
+			}
+		}
+		/*
+		Encode a value into a record
+		Parameter: uint8_t* output - The position to encode the value at
+		Parameter: const T& value - The value
+		Returns: uint8_t* - The position after the value
+		*/
+		template <typename T>
+		static uint8_t* encodeValue(uint8_t* output, const T& value) {
+			if constexpr (isString<T>()) {
+				std::string_view string = getView(value);
+				uint32_t size = (uint32_t)string.size();
+				*output++ = ARGUMENT_STRING;
+				std::memcpy(output, &size, sizeof(size));
+				std::memcpy(output + sizeof(size), string.data(), size);
+				return output + sizeof(size) + size;
+			}
+			else if constexpr (std::is_same_v<T, bool>) {
+				output[0] = ARGUMENT_BOOL;
+				output[1] = value ? 1 : 0;
+				return output + 2;
+			}
+			else if constexpr (isCharacter<T>()) {
+				output[0] = ARGUMENT_CHAR;
+				output[1] = (uint8_t)value;
+				return output + 2;
+			}
+			else {
+				uint64_t bits = 0;
+				if constexpr (std::is_floating_point_v<T>) {
+					*output++ = ARGUMENT_FLOATING;
+					double floating = (double)value;
+					std::memcpy(&bits, &floating, sizeof(bits));
+				}
+				else if constexpr (std::is_pointer_v<std::decay_t<T>>) {
+					*output++ = ARGUMENT_POINTER;
+					bits = (uint64_t)(uintptr_t)(const void*)value;
+				}
+				else if constexpr (std::is_signed_v<T>) {
+					*output++ = ARGUMENT_SIGNED;
+					bits = (uint64_t)(int64_t)value;
+				}
+				else {
+					*output++ = ARGUMENT_UNSIGNED;
+					bits = (uint64_t)value;
+				}
+				std::memcpy(output, &bits, sizeof(bits));
+				return output + sizeof(bits);
+			}
+		}
+		/*
+		Encode a record into the calling thread's ring buffer, or write it
+		synchronously if this log is not running
+		Parameter: const char* source - The name of the record's source
+		Parameter: LogLevel level - The level of the record
+		Parameter: const T&... arguments - The encodable values
+		*/
+		template <typename... T>
+		void encode(const char* source, LogLevel level,
+			const T&... arguments) {
+			const size_t argumentSize = (getEncodedSize(arguments) + ... + 0);
+			if (argumentSize > MAXIMUM_ARGUMENT_SIZE) {
+				m_unbufferedDropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			RecordHeader header;
+			header.size = (uint32_t)((sizeof(RecordHeader) + argumentSize + 7)
+				& ~(size_t)7);
+			header.level = (uint8_t)level;
+			header.argumentCount = (uint8_t)sizeof...(T);
+			header.argumentSize = (uint16_t)argumentSize;
+			header.source = source;
+			header.timestamp = getTimestamp();
+			ThreadBuffer* buffer = 0;
+			uint8_t* record = reserve(header.size, buffer);
+			if (record == 0) {
+				return;
+			}
+			std::memcpy(record, &header, sizeof(header));
+			uint8_t* output = record + sizeof(header);
+			((output = encodeValue(output, arguments)), ...);
+			commit(buffer, record);
+		}
+		/*
+		Get the current time in nanoseconds since the epoch
+		Returns: int64_t - The timestamp
+		*/
+		static int64_t getTimestamp();
+		/*
+		Reserve space for a record in the calling thread's ring buffer, or in
+		a scratch buffer if this log is not running
+		Parameter: uint32_t size - The size of the record
+		Parameter: ThreadBuffer*& buffer - Set to the ring buffer reserved in,
+		or 0 if the space is in the scratch buffer
+		Returns: uint8_t* - The reserved space, or 0 if the record was dropped
+		*/
+		uint8_t* reserve(uint32_t, ThreadBuffer*&);
+		/*
+		Publish a reserved record to the background thread, or write it
+		synchronously through the ActiasFW application's log if it was
+		reserved in the scratch buffer
+		Parameter: ThreadBuffer* buffer - The ring buffer reserved in
+		Parameter: uint8_t* record - The record
+		*/
+		void commit(ThreadBuffer*, uint8_t*);
+		/*
+		Get the calling thread's ring buffer, creating it if necessary
+		Returns: ThreadBuffer* - The buffer, or 0 if this thread may not have
+		one
+		*/
+		ThreadBuffer* getThreadBuffer();
+		/*
+		Format and write the records in every ring buffer until this log is
+		destroyed, run by the background thread
+		*/
+		void run();
+		/*
+		Format and write the records currently in every ring buffer
+		*/
+		void writeBatch();
+		/*
+		Append a formatted record to a string
+		Parameter: std::string& output - The string
+		Parameter: int64_t timestamp - The time of the record
+		Parameter: std::string_view source - The name of the record's source
+		Parameter: uint8_t level - The level of the record
+		Parameter: const uint8_t* arguments - The encoded values
+		Parameter: size_t argumentSize - The size of the encoded values
+		Returns: bool - Whether the values were decoded
+		*/
+		static bool format(std::string&, int64_t, std::string_view, uint8_t,
+			const uint8_t*, size_t);
+		/*
+		Append a record's formatted values to a string
+		Parameter: std::string& output - The string
+		Parameter: const uint8_t* arguments - The encoded values
+		Parameter: size_t argumentSize - The size of the encoded values
+		Returns: bool - Whether the values were decoded
+		*/
+		static bool formatArguments(std::string&, const uint8_t*, size_t);
+		/*
+		Append a formatted notice of dropped records to a string
+		Parameter: std::string& output - The string
+		Parameter: int64_t timestamp - The time the records were found dropped
+		Parameter: uint64_t count - The number of records dropped
+		*/
+		static void formatDropped(std::string&, int64_t, uint64_t);
+	};
+}
+
+#endif
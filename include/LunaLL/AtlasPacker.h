@@ -0,0 +1,87 @@
+/*
+File:		AtlasPacker.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@14:20
+Purpose:	Contains the shelf packer used to place small textures into shared
+			texture atlas pages
+*/
+
+#ifndef LUNALL_ATLAS_PACKER_H
+#define LUNALL_ATLAS_PACKER_H
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace LunaLL {
+	// Packs rectangles into square pages in rows of similar heights
+	class AtlasPacker {
+	public:
+		/*
+		Initialize this packer's memory
+		Parameter: unsigned int pageSize - The width and height of each page
+		*/
+		void initialize(unsigned int);
+		/*
+		Find space for a rectangle, adding a page if no page has room
+		Parameter: const glm::ivec2& dimensions - The width and height of the
+		rectangle
+		Parameter: unsigned int& page - Populated with the rectangle's page
+		Parameter: glm::ivec2& position - Populated with the position of the
+		rectangle's bottom left corner in its page
+		Returns: bool - Whether the rectangle fits in a page
+		*/
+		bool pack(const glm::ivec2&, unsigned int&, glm::ivec2&);
+		/*
+		Add a page which was packed elsewhere and accepts no new rectangles
+		Parameter: size_t usedArea - The area of the page already in use
+		Returns: unsigned int - The index of the new page
+		*/
+		unsigned int addClosedPage(size_t);
+		/*
+		Empty a page so new rectangles can be packed into it
+		Parameter: unsigned int page - The index of the page
+		Parameter: size_t usedArea - The area of the page which was in use
+		*/
+		void reopenPage(unsigned int, size_t);
+		/*
+		Get the width and height of this packer's pages
+		Returns: unsigned int - The page size
+		*/
+		unsigned int getPageSize() const;
+		/*
+		Get the number of pages in this packer
+		Returns: unsigned int - The page count
+		*/
+		unsigned int getPageCount() const;
+		/*
+		Get the fraction of the area of this packer's pages in use
+		Returns: double - The occupancy between 0.0 and 1.0
+		*/
+		double getOccupancy() const;
+
+	private:
+		// A row of rectangles in a page
+		struct Shelf {
+			// The page of this shelf
+			unsigned int page = 0;
+			// The bottom of this shelf in its page
+			int y = 0;
+			// The height of this shelf
+			int height = 0;
+			// The left edge of this shelf's free space
+			int x = 0;
+		};
+
+		// The width and height of each page
+		unsigned int m_pageSize = 0;
+		// The shelves in every page
+		std::vector<Shelf> m_shelves;
+		// The top of the highest shelf in each page
+		std::vector<int> m_pageHeights;
+		// The total area of the rectangles packed
+		size_t m_usedArea = 0;
+	};
+}
+
+#endif
@@ -0,0 +1,316 @@
+/*
+File:		AudioManager.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@21:55
+Purpose:	Contains the audio manager which streams music from disk, decodes
+			banks of sound effects in the background, and limits the voices of
+			each effect
+*/
+
+#ifndef LUNALL_AUDIO_MANAGER_H
+#define LUNALL_AUDIO_MANAGER_H
+
+#include <SoLoud/soloud.h>
+#include <SoLoud/soloud_wav.h>
+#include <SoLoud/soloud_wavstream.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace LunaLL {
+	// Enumeration of the loading states of a bank of sound effects
+	enum BankStatus {
+		BANK_UNLOADED,
+		BANK_LOADING,
+		BANK_LOADED,
+		BANK_FAILED,
+	};
+
+	// Settings of an audio manager's mixing and voice limits
+	struct AudioConfiguration {
+		// The initial sound effect volume between 0.0 and 1.0
+		float effectVolume = 1.0f;
+		// The initial music volume between 0.0 and 1.0
+		float musicVolume = 1.0f;
+		// The most voices mixed at once, the quietest voices beyond it keep
+		// their place without being mixed
+		unsigned int maximumActiveVoiceCount = 32;
+		// The number of voices each effect may play at once unless it is set
+		// for the effect
+		unsigned int defaultVoiceLimit = 4;
+		// The time in seconds within which plays of an effect after its first
+		// are merged into the first, or 0.0 to play each of them
+		double retriggerTime = 0.03;
+		// Whether to mix without an audio device
+		bool headless = false;
+	};
+
+	// Measurements of an audio manager's loaded audio and voices
+	struct AudioMetrics {
+		// The number of sound effects decoded in memory
+		size_t effectsLoaded = 0;
+		// The memory used by the decoded sound effects in bytes
+		size_t effectBytes = 0;
+		// The number of sound effects queued for decoding but not yet loaded
+		size_t effectsPending = 0;
+		// The number of sound effects which could not be decoded
+		size_t failures = 0;
+		// The total time spent decoding sound effects in the background
+		double decodeSeconds = 0.0;
+		// The longest time spent decoding a single sound effect
+		double maximumDecodeSeconds = 0.0;
+		// The memory the current music track would use if it was decoded
+		// instead of streamed in bytes
+		size_t musicDecodedBytes = 0;
+		// The number of sound effects played
+		size_t effectsPlayed = 0;
+		// The number of plays merged into a play of the same effect within
+		// the retrigger time
+		size_t effectsMerged = 0;
+		// The number of voices stopped to keep an effect within its limit
+		size_t voicesStolen = 0;
+		// The number of plays of effects which were not loaded yet
+		size_t effectsUnavailable = 0;
+	};
+
+	// A sound effect and music system for LunaLL applications used in place
+	// of the ActiasFW application's audio manager, music tracks are streamed
+	// from disk and sound effects are decoded in named banks on a background
+	// thread so playing them never decodes on the calling thread
+	class AudioManager {
+	public:
+		/*
+		Stop this audio manager's decoding thread if it is still running
+		*/
+		~AudioManager();
+		/*
+		Initialize the SoLoud library and start this audio manager's decoding
+		thread
+		Parameter: const AudioConfiguration& configuration - The settings of
+		this audio manager's mixing and voice limits
+		Returns: bool - Whether the SoLoud library could be initialized
+		*/
+		bool initialize(const AudioConfiguration& = AudioConfiguration());
+		/*
+		Queue a bank of sound effects to be decoded in the background, effects
+		already loaded by other banks are shared
+		Parameter: const std::string& name - The name of the bank
+		Parameter: const std::vector<std::string>& fileNames - The file names
+		of the bank's WAV effects
+		Returns: bool - Whether the bank was not already loaded or loading
+		*/
+		bool loadBank(const std::string&, const std::vector<std::string>&);
+		/*
+		Stop and free a bank's sound effects which are not in another bank
+		Parameter: const std::string& name - The name of the bank
+		Returns: bool - Whether the bank was loaded or loading
+		*/
+		bool unloadBank(const std::string&);
+		/*
+		Get the loading state of a bank as of the last update
+		Parameter: const std::string& name - The name of the bank
+		Returns: BankStatus - The state of the bank, BANK_FAILED if any of
+		its effects could not be decoded
+		*/
+		BankStatus getBankStatus(const std::string&) const;
+		/*
+		Get the fraction of a bank's sound effects loaded as of the last
+		update
+		Parameter: const std::string& name - The name of the bank
+		Returns: float - The fraction between 0.0 and 1.0
+		*/
+		float getBankProgress(const std::string&) const;
+		/*
+		Take the sound effects decoded in the background and forget the
+		voices which have ended, must be called once per frame on the thread
+		playing sounds
+		*/
+		void update();
+		/*
+		Test whether any sound effects are still queued for decoding
+		Returns: bool - Whether this audio manager is still loading
+		*/
+		bool isLoading() const;
+		/*
+		Block until every queued sound effect is decoded, then update
+		*/
+		void finishLoading();
+		/*
+		Set the number of voices a sound effect may play at once, the oldest
+		voice is stopped to play another beyond it
+		Parameter: const std::string& fileName - The file name of the effect
+		Parameter: unsigned int voiceLimit - The number of voices
+		*/
+		void setVoiceLimit(const std::string&, unsigned int);
+		/*
+		Get the number of voices a sound effect is playing as of the last
+		update or play
+		Parameter: const std::string& fileName - The file name of the effect
+		Returns: unsigned int - The number of voices
+		*/
+		unsigned int getVoiceCount(const std::string&) const;
+		/*
+		Play a sound effect by its file name, an effect in no bank is queued
+		in a bank named after its file name and not played
+		Parameter: const std::string& fileName - The file name of the effect
+		Parameter: float volume - The volume of this play between 0.0 and 1.0,
+		scaled by the effect volume
+		Parameter: float pan - The pan of this play between -1.0 (left) and
+		1.0 (right)
+		Returns: bool - Whether the effect was loaded and played or merged into
+		a play within the retrigger time
+		*/
+		bool playEffect(const std::string&, float = 1.0f, float = 0.0f);
+		/*
+		Test if the currently playing music track is paused if one is present
+		Returns: bool - Whether the music track is present and is paused
+		*/
+		bool isMusicPaused() const;
+		/*
+		Stream a music track from disk or resume the current music track
+		Parameter: const std::string& fileName - The file name of the music
+		track to play or empty string to resume the current track
+		Parameter: bool looping - Whether the new track loops
+		Returns: bool - Whether the music track could be played or resumed
+		*/
+		bool playMusic(const std::string& = "", bool = true);
+		/*
+		Pause the current music track if one is playing
+		Returns: bool - Whether the music track was present and could be paused
+		*/
+		bool pauseMusic();
+		/*
+		Stop the current music track and close its file
+		Returns: bool - Whether the music track was present and could be stopped
+		*/
+		bool stopMusic();
+		/*
+		Get the current sound effect volume
+		Returns: float - The sound effect volume between 0.0 and 1.0
+		*/
+		float getEffectVolume() const;
+		/*
+		Set the volume of sound effects played from now on
+		Parameter: float effectVolume - The new sound effect volume between 0.0
+		and 1.0
+		*/
+		void setEffectVolume(float);
+		/*
+		Get the current music volume
+		Returns: float - The music volume between 0.0 and 1.0
+		*/
+		float getMusicVolume() const;
+		/*
+		Set the music volume, including the current track's
+		Parameter: float musicVolume - The new music volume between 0.0 and 1.0
+		*/
+		void setMusicVolume(float);
+		/*
+		Get measurements of this audio manager's loaded audio and voices
+		Returns: const AudioMetrics& - This audio manager's metrics
+		*/
+		const AudioMetrics& getMetrics() const;
+		/*
+		Stop all sounds, stop the decoding thread, and free this audio
+		manager's memory
+		*/
+		void destroy();
+
+	private:
+		// A sound effect loaded by one or more banks
+		struct Effect {
+			// The decoded effect, or 0 until it is loaded
+			std::unique_ptr<SoLoud::Wav> wav;
+			// Whether the effect could not be decoded
+			bool failed = false;
+			// The number of banks holding the effect
+			unsigned int bankCount = 0;
+			// The number of voices the effect may play at once
+			unsigned int voiceLimit = 0;
+			// The SoLoud library's handles of the effect's voices, oldest
+			// first
+			std::vector<SoLoud::handle> voices;
+			// The time the effect last started a voice
+			std::chrono::steady_clock::time_point lastPlayed;
+		};
+
+		// A named set of sound effects loaded together
+		struct Bank {
+			// The file names of the bank's effects
+			std::vector<std::string> fileNames;
+		};
+
+		// A sound effect decoded in the background
+		struct DecodedEffect {
+			// The file name of the effect
+			std::string fileName = "";
+			// The decoded effect
+			std::unique_ptr<SoLoud::Wav> wav;
+			// The time spent decoding the effect
+			double decodeSeconds = 0.0;
+			// Whether the effect could be decoded
+			bool loaded = false;
+		};
+
+		// Whether this audio manager has been initialized
+		bool m_initialized = false;
+		// The settings of this audio manager's mixing and voice limits
+		AudioConfiguration m_configuration;
+		// The instance of the SoLoud library used by this audio manager
+		SoLoud::Soloud m_soloud;
+		// The sound effects of every bank by their file names
+		std::unordered_map<std::string, Effect> m_effects;
+		// The banks by their names
+		std::unordered_map<std::string, Bank> m_banks;
+		// The voice limits set for effects by their file names
+		std::unordered_map<std::string, unsigned int> m_voiceLimits;
+		// The current music track streamed from disk
+		std::unique_ptr<SoLoud::WavStream> m_music;
+		// The SoLoud library's handle for the current music track
+		SoLoud::handle m_musicHandle = 0;
+		// Whether a music track is present and is paused
+		bool m_musicPaused = false;
+		// The current sound effect volume
+		float m_effectVolume = 0.0f;
+		// The current music volume
+		float m_musicVolume = 0.0f;
+		// The decoding thread
+		std::thread m_thread;
+		// The lock on the request and decoded effect queues
+		mutable std::mutex m_mutex;
+		// Signalled when a request is queued or the thread must stop
+		std::condition_variable m_condition;
+		// Signalled when the decoding thread finishes an effect
+		std::condition_variable m_decodedCondition;
+		// The file names waiting to be decoded
+		std::deque<std::string> m_requests;
+		// The effects waiting to be taken by an update
+		std::deque<DecodedEffect> m_decoded;
+		// Whether the decoding thread is decoding an effect
+		bool m_decoding = false;
+		// Whether the decoding thread must stop
+		bool m_stopping = false;
+		// Measurements of this audio manager's audio and voices
+		AudioMetrics m_metrics;
+
+		/*
+		Decode requested effects until this audio manager is destroyed, run
+		by the decoding thread
+		*/
+		void decode();
+		/*
+		Stop an effect's voices and remove it, updating the metrics
+		Parameter: const std::string& fileName - The file name of the effect
+		*/
+		void removeEffect(const std::string&);
+	};
+}
+
+#endif
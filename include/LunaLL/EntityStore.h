@@ -0,0 +1,214 @@
+/*
+File:		EntityStore.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@20:45
+Purpose:	Contains the entity store which keeps the moving and animated
+			state of many entities in contiguous arrays and updates them in
+			parallel
+*/
+
+#ifndef LUNALL_ENTITY_STORE_H
+#define LUNALL_ENTITY_STORE_H
+
+#include "JobSystem.h"
+
+#include <ActiasFW/Graphics.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace LunaLL {
+	// A store of the positions, velocities, rotations, and animation timers
+	// of entities, each kept in its own contiguous array so updates run over
+	// plain arrays instead of calling each entity's update, entities update
+	// as ActiasFW animations do and the results do not depend on the number
+	// of threads updating them
+	class EntityStore {
+	public:
+		// The number of entities updated in each job, a multiple of the
+		// widest vector of floats
+		static constexpr size_t GRAIN_SIZE = 4096;
+
+		/*
+		Add an entity to this store, its animation plays if it has more than
+		one frame
+		Parameter: const glm::vec3& position - The position and depth of the
+		entity
+		Parameter: const glm::vec2& velocity - The velocity of the entity
+		Parameter: float rotationVelocity - The rotation velocity of the entity
+		in degrees
+		Parameter: unsigned int frameCount - The number of frames of the
+		entity's animation
+		Parameter: float frameTime - The number of updates to play each frame
+		of the entity's animation for, or 0.0 if it is not animated
+		Returns: size_t - The index of the entity
+		*/
+		size_t add(const glm::vec3&, const glm::vec2&, float = 0.0f,
+			unsigned int = 1, float = 0.0f);
+		/*
+		Add an entity to this store with a sprite's state
+		Parameter: const ActiasFW::Sprite& sprite - The sprite
+		Returns: size_t - The index of the entity
+		*/
+		size_t add(const ActiasFW::Sprite&);
+		/*
+		Add an entity to this store with an animation's state, including the
+		time its current frame has played for
+		Parameter: const ActiasFW::Animation& animation - The animation
+		Parameter: unsigned int frameCount - The number of frames of the
+		animation
+		Returns: size_t - The index of the entity
+		*/
+		size_t add(const ActiasFW::Animation&, unsigned int);
+		/*
+		Remove an entity from this store, moving the last entity to its index
+		Parameter: size_t index - The index of the entity
+		*/
+		void remove(size_t);
+		/*
+		Get the number of entities in this store
+		Returns: size_t - The number of entities
+		*/
+		size_t getSize() const;
+		/*
+		Allocate memory for a number of entities
+		Parameter: size_t capacity - The number of entities
+		*/
+		void reserve(size_t);
+		/*
+		Remove every entity from this store
+		*/
+		void clear();
+		/*
+		Update every entity's position, rotation, and animation in parallel on
+		the LunaLL job system, the jobs change only this store's arrays and
+		call no ActiasFW code
+		Parameter: float timeStep - The number of frames elapsed since the
+		last update
+		*/
+		void update(float);
+		/*
+		Update a range of entities' positions, rotations, and animations on
+		the calling thread
+		Parameter: size_t begin - The index of the first entity
+		Parameter: size_t end - One past the index of the last entity
+		Parameter: float timeStep - The number of frames elapsed since the
+		last update
+		*/
+		void update(size_t, size_t, float);
+		/*
+		Copy an entity's position and rotation to a sprite to draw it
+		Parameter: size_t index - The index of the entity
+		Parameter: ActiasFW::Sprite& sprite - The sprite
+		*/
+		void apply(size_t, ActiasFW::Sprite&) const;
+		/*
+		Copy an entity's position, rotation, and animation frame to an
+		animation to draw it
+		Parameter: size_t index - The index of the entity
+		Parameter: ActiasFW::Animation& animation - The animation
+		*/
+		void apply(size_t, ActiasFW::Animation&) const;
+		/*
+		Get an entity's position and depth
+		Parameter: size_t index - The index of the entity
+		Returns: glm::vec3 - The entity's position and depth
+		*/
+		glm::vec3 getPosition(size_t) const;
+		/*
+		Set an entity's position and depth
+		Parameter: size_t index - The index of the entity
+		Parameter: const glm::vec3& position - The new position and depth
+		*/
+		void setPosition(size_t, const glm::vec3&);
+		/*
+		Get an entity's velocity
+		Parameter: size_t index - The index of the entity
+		Returns: glm::vec2 - The entity's velocity
+		*/
+		glm::vec2 getVelocity(size_t) const;
+		/*
+		Set an entity's velocity
+		Parameter: size_t index - The index of the entity
+		Parameter: const glm::vec2& velocity - The new velocity
+		*/
+		void setVelocity(size_t, const glm::vec2&);
+		/*
+		Get an entity's rotation
+		Parameter: size_t index - The index of the entity
+		Returns: float - The entity's rotation in degrees
+		*/
+		float getRotation(size_t) const;
+		/*
+		Set an entity's rotation
+		Parameter: size_t index - The index of the entity
+		Parameter: float rotation - The new rotation in degrees
+		*/
+		void setRotation(size_t, float);
+		/*
+		Get an entity's rotation velocity
+		Parameter: size_t index - The index of the entity
+		Returns: float - The entity's rotation velocity in degrees
+		*/
+		float getRotationVelocity(size_t) const;
+		/*
+		Set an entity's rotation velocity
+		Parameter: size_t index - The index of the entity
+		Parameter: float rotationVelocity - The new rotation velocity in
+		degrees
+		*/
+		void setRotationVelocity(size_t, float);
+		/*
+		Get the current frame of an entity's animation
+		Parameter: size_t index - The index of the entity
+		Returns: unsigned int - The current frame
+		*/
+		unsigned int getCurrentFrame(size_t) const;
+		/*
+		Set the current frame of an entity's animation
+		Parameter: size_t index - The index of the entity
+		Parameter: unsigned int currentFrame - The new current frame
+		*/
+		void setCurrentFrame(size_t, unsigned int);
+		/*
+		Test whether an entity's animation is playing
+		Parameter: size_t index - The index of the entity
+		Returns: bool - Whether the animation is playing
+		*/
+		bool isPlaying(size_t) const;
+		/*
+		Start or stop playing an entity's animation
+		Parameter: size_t index - The index of the entity
+		Parameter: bool playing - Whether to play the animation
+		*/
+		void setPlaying(size_t, bool);
+
+	private:
+		// The horizontal positions of the entities
+		std::vector<float> m_positionsX;
+		// The vertical positions of the entities
+		std::vector<float> m_positionsY;
+		// The depths of the entities
+		std::vector<float> m_depths;
+		// The horizontal velocities of the entities
+		std::vector<float> m_velocitiesX;
+		// The vertical velocities of the entities
+		std::vector<float> m_velocitiesY;
+		// The rotations of the entities in degrees
+		std::vector<float> m_rotations;
+		// The rotation velocities of the entities in degrees
+		std::vector<float> m_rotationVelocities;
+		// The time each entity's current animation frame has played for
+		std::vector<float> m_timers;
+		// The number of updates each entity plays each animation frame for
+		std::vector<float> m_frameTimes;
+		// The current animation frame of each entity
+		std::vector<uint32_t> m_currentFrames;
+		// The number of animation frames of each entity
+		std::vector<uint32_t> m_frameCounts;
+		// Whether each entity's animation is playing
+		std::vector<uint8_t> m_playing;
+	};
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+File:		FileMapping.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@09:12
+Purpose:	Contains a read-only memory mapped file used to stream level data
+			from disk without reading it into memory up front
+*/
+
+#ifndef LUNALL_FILE_MAPPING_H
+#define LUNALL_FILE_MAPPING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace LunaLL {
+	// A read-only view of a file mapped into this process's address space
+	class FileMapping {
+	public:
+		/*
+		Construct an empty file mapping
+		*/
+		FileMapping() = default;
+		FileMapping(const FileMapping&) = delete;
+		FileMapping& operator = (const FileMapping&) = delete;
+		/*
+		Unmap this file mapping's file if one is open
+		*/
+		~FileMapping();
+		/*
+		Map a file into memory by its file name
+		Parameter: const std::string& fileName - The name of the file to map
+		Returns: bool - Whether the file could be opened and mapped
+		*/
+		bool open(const std::string&);
+		/*
+		Unmap this file mapping's file and close it if one is open
+		*/
+		void close();
+		/*
+		Test whether this file mapping currently has a file mapped
+		Returns: bool - Whether a file is mapped
+		*/
+		bool isOpen() const;
+		/*
+		Get the first byte of the mapped file
+		Returns: const uint8_t* - The mapped data or 0 if no file is mapped
+		*/
+		const uint8_t* getData() const;
+		/*
+		Get the size of the mapped file
+		Returns: size_t - The size of the mapped file in bytes
+		*/
+		size_t getSize() const;
+
+	private:
+		// The first byte of the mapped file
+		const uint8_t* m_data = 0;
+		// The size of the mapped file in bytes
+		size_t m_size = 0;
+		// The operating system's handle for the open file
+		void* m_fileHandle = 0;
+		// The operating system's handle for the file's mapping
+		void* m_mappingHandle = 0;
+	};
+}
+
+#endif
@@ -0,0 +1,157 @@
+/*
+File:		GlyphAtlas.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@15:40
+Purpose:	Contains the glyph atlases rasterized from fonts into single
+			textures and the cache of them by font and size
+*/
+
+#ifndef LUNALL_GLYPH_ATLAS_H
+#define LUNALL_GLYPH_ATLAS_H
+
+#include <GL/glew.h>
+#include <ft2build.h>
+#include <freetype/freetype.h>
+#include <glm/glm.hpp>
+
+#include <array>
+#include <string>
+#include <unordered_map>
+
+namespace LunaLL {
+	// The measurements of a single text character in a glyph atlas
+	struct GlyphMetrics {
+		// Whether the font has a visible glyph for this character
+		bool present = false;
+		// The width and height of the glyph in pixels
+		glm::vec2 dimensions = glm::vec2();
+		// The offset from the pen position to the glyph's left edge and from
+		// the baseline to its top edge in pixels
+		glm::vec2 bearing = glm::vec2();
+		// The distance to move the pen after this glyph in pixels
+		float advance = 0.0f;
+		// The texture coordinates of the glyph in its atlas
+		glm::vec4 textureBox = glm::vec4();
+	};
+
+	// Every glyph of a font at one pixel size rasterized into a single OpenGL
+	// texture, with its glyphs indexed directly by character
+	class GlyphAtlas {
+	public:
+		// The number of characters in each atlas, one per byte value read as
+		// a Latin-1 code point
+		static constexpr unsigned int GLYPH_COUNT = 256;
+		// The largest width and height of an atlas texture
+		static constexpr unsigned int MAXIMUM_DIMENSION = 4096;
+
+		/*
+		Rasterize a font's glyphs and pack them into this atlas's texture
+		Parameter: FT_Library freeType - The FreeType library to load the font
+		with
+		Parameter: const std::string& fontFileName - The file name of the font
+		Parameter: unsigned int pixelSize - The height in pixels to rasterize
+		the font at
+		Returns: bool - Whether the font was loaded and its glyphs fit in one
+		texture
+		*/
+		bool initialize(FT_Library, const std::string&, unsigned int);
+		/*
+		Get the measurements of a character's glyph
+		Parameter: char character - The character
+		Returns: const GlyphMetrics& - The glyph's measurements
+		*/
+		const GlyphMetrics& getGlyph(char character) const {
+			return m_glyphs[(unsigned char)character];
+		}
+		/*
+		Get the OpenGL texture holding this atlas's glyphs
+		Returns: GLuint - This atlas's texture, or 0 if it is not initialized
+		*/
+		GLuint getTexture() const;
+		/*
+		Get the width and height of this atlas's texture
+		Returns: const glm::ivec2& - This atlas's dimensions in pixels
+		*/
+		const glm::ivec2& getDimensions() const;
+		/*
+		Get the file name of this atlas's font
+		Returns: const std::string& - The font file name
+		*/
+		const std::string& getFontFileName() const;
+		/*
+		Get the height in pixels this atlas's font was rasterized at
+		Returns: unsigned int - The pixel size
+		*/
+		unsigned int getPixelSize() const;
+		/*
+		Get the distance from the baseline to the top of the font's tallest
+		glyphs
+		Returns: float - The ascender in pixels
+		*/
+		float getAscender() const;
+		/*
+		Get the distance from the baseline to the bottom of the font's lowest
+		glyphs, which is negative below the baseline
+		Returns: float - The descender in pixels
+		*/
+		float getDescender() const;
+		/*
+		Get the distance between the baselines of consecutive lines
+		Returns: float - The line height in pixels
+		*/
+		float getLineHeight() const;
+		/*
+		Delete this atlas's texture from OpenGL and free its memory
+		*/
+		void destroy();
+
+	private:
+		// The measurements of each character's glyph
+		std::array<GlyphMetrics, GLYPH_COUNT> m_glyphs;
+		// The OpenGL texture holding the glyphs
+		GLuint m_texture = 0;
+		// The width and height of the texture
+		glm::ivec2 m_dimensions = glm::ivec2();
+		// The file name of the font
+		std::string m_fontFileName = "";
+		// The height in pixels the font was rasterized at
+		unsigned int m_pixelSize = 0;
+		// The distance from the baseline to the top of the tallest glyphs
+		float m_ascender = 0.0f;
+		// The distance from the baseline to the bottom of the lowest glyphs
+		float m_descender = 0.0f;
+		// The distance between baselines
+		float m_lineHeight = 0.0f;
+	};
+
+	// A set of glyph atlases loaded by font file name and pixel size
+	class FontCache {
+	public:
+		/*
+		Initialize the FreeType library used to load this cache's fonts
+		Returns: bool - Whether FreeType was initialized
+		*/
+		bool initialize();
+		/*
+		Get the atlas of a font at a pixel size or attempt to rasterize it
+		Parameter: const std::string& fontFileName - The file name of the font
+		Parameter: unsigned int pixelSize - The height in pixels of the font
+		Returns: const GlyphAtlas* - The atlas, or 0 if the font could not be
+		loaded, the pointer remains valid until this cache is destroyed
+		*/
+		const GlyphAtlas* getAtlas(const std::string&, unsigned int);
+		/*
+		Delete every atlas in this cache and terminate FreeType
+		*/
+		void destroy();
+
+	private:
+		// The instance of the FreeType library used to load fonts
+		FT_Library m_freeType = 0;
+		// The atlases by font file name and pixel size, including uninitialized
+		// atlases of fonts which failed to load
+		std::unordered_map<std::string, GlyphAtlas> m_atlases;
+	};
+}
+
+#endif
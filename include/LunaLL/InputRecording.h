@@ -0,0 +1,282 @@
+/*
+File:		InputRecording.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@19:05
+Purpose:	Contains the recording of user input events and update time steps
+			per frame, the recorder which captures them from the application's
+			input manager, and their replay to input listeners
+*/
+
+#ifndef LUNALL_INPUT_RECORDING_H
+#define LUNALL_INPUT_RECORDING_H
+
+#include <ActiasFW/ActiasFW.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace LunaLL {
+	// Enumeration of the types of recorded input events, one for each
+	// callback of an input listener
+	enum InputEventType : uint8_t {
+		INPUT_KEY_PRESSED,
+		INPUT_KEY_RELEASED,
+		INPUT_CHARACTER_TYPED,
+		INPUT_MOUSE_BUTTON_PRESSED,
+		INPUT_MOUSE_BUTTON_RELEASED,
+		INPUT_MOUSE_CURSOR_MOVED,
+		INPUT_MOUSE_SCROLLED,
+		INPUT_CONTROLLER_CONNECTED,
+		INPUT_CONTROLLER_DISCONNECTED,
+		INPUT_CONTROLLER_BUTTON_PRESSED,
+		INPUT_CONTROLLER_BUTTON_RELEASED,
+		INPUT_CONTROLLER_AXIS_MOVED,
+		INPUT_EVENT_TYPE_COUNT,
+	};
+
+	// A single recorded input event
+	struct InputEvent {
+		// The type of the event
+		InputEventType type = INPUT_KEY_PRESSED;
+		// The key, character, mouse button, controller button, or controller
+		// axis of the event
+		int32_t code = 0;
+		// The controller of the event
+		int32_t controller = 0;
+		// The cursor movement, scroll distance, or axis movement of the event
+		glm::vec2 value = glm::vec2();
+	};
+
+	// The input events delivered before a frame processed input and the time
+	// steps of the frame's updates
+	struct InputFrame {
+		// The events in the order they were delivered
+		std::vector<InputEvent> events;
+		// The time step of each update in the frame
+		std::vector<float> timeSteps;
+	};
+
+	// A recorded session of input events and update time steps, frame by
+	// frame, which can be saved and replayed deterministically
+	class InputRecording {
+	public:
+		// The first bytes of a recording file
+		static const std::string MAGIC;
+		// The version of the recording file format
+		static constexpr uint32_t VERSION = 1;
+
+		/*
+		Start a new frame at the end of this recording
+		Returns: InputFrame& - The new frame
+		*/
+		InputFrame& addFrame();
+		/*
+		Get the frames of this recording
+		Returns: const std::vector<InputFrame>& - The frames
+		*/
+		const std::vector<InputFrame>& getFrames() const;
+		/*
+		Get the total number of events in this recording
+		Returns: size_t - The number of events
+		*/
+		size_t getEventCount() const;
+		/*
+		Write this recording to a file
+		Parameter: const std::string& fileName - The file to write
+		Returns: bool - Whether the file was written
+		*/
+		bool save(const std::string&) const;
+		/*
+		Replace this recording with one read from a file
+		Parameter: const std::string& fileName - The file to read
+		Returns: bool - Whether the file was a valid recording
+		*/
+		bool load(const std::string&);
+		/*
+		Remove every frame from this recording
+		*/
+		void clear();
+		/*
+		Deliver a frame's events to an input listener in their recorded order
+		Parameter: const InputFrame& frame - The frame
+		Parameter: ActiasFW::InputListener& listener - The listener
+		*/
+		static void dispatch(const InputFrame&, ActiasFW::InputListener&);
+
+	private:
+		// The recorded frames
+		std::vector<InputFrame> m_frames;
+	};
+
+	// An input listener which records the events of the application's input
+	// manager into a recording, the events delivered before each call to
+	// beginFrame are recorded in the frame it starts
+	class InputRecorder : public ActiasFW::InputListener {
+	public:
+		/*
+		Construct a recorder which is not recording
+		*/
+		InputRecorder() = default;
+		InputRecorder(const InputRecorder&) = delete;
+		InputRecorder& operator = (const InputRecorder&) = delete;
+		/*
+		Stop recording so the application's input manager does not keep this
+		recorder as a listener
+		*/
+		~InputRecorder();
+		/*
+		Start recording into a recording, which must remain in memory until
+		recording stops
+		Parameter: InputRecording& recording - The recording to add frames to
+		Returns: bool - Whether this recorder could listen to the application's
+		input manager
+		*/
+		bool start(InputRecording&);
+		/*
+		Start a frame of the recording holding the events delivered since the
+		last frame started
+		*/
+		void beginFrame();
+		/*
+		Record the time step of an update in the current frame
+		Parameter: float timeStep - The time step
+		*/
+		void addTimeStep(float);
+		/*
+		Stop recording and stop listening to the application's input manager
+		*/
+		void stop();
+		/*
+		Test whether this recorder is recording
+		Returns: bool - Whether this recorder is recording
+		*/
+		bool isRecording() const;
+
+		/*
+		Record a key press
+		Parameter: ActiasFW::KeyCode key - The key pressed
+		*/
+		void keyPressed(ActiasFW::KeyCode) override;
+		/*
+		Record a key release
+		Parameter: ActiasFW::KeyCode key - The key released
+		*/
+		void keyReleased(ActiasFW::KeyCode) override;
+		/*
+		Record a typed character
+		Parameter: char character - The character typed
+		*/
+		void characterTyped(char) override;
+		/*
+		Record a mouse button press
+		Parameter: ActiasFW::MouseButtonCode button - The button pressed
+		*/
+		void mouseButtonPressed(ActiasFW::MouseButtonCode) override;
+		/*
+		Record a mouse button release
+		Parameter: ActiasFW::MouseButtonCode button - The button released
+		*/
+		void mouseButtonReleased(ActiasFW::MouseButtonCode) override;
+		/*
+		Record a movement of the mouse cursor
+		Parameter: const glm::vec2& distance - The distance the cursor moved
+		*/
+		void mouseCursorMoved(const glm::vec2&) override;
+		/*
+		Record a movement of the mouse's scroll wheel
+		Parameter: const glm::vec2& distance - The distance scrolled
+		*/
+		void mouseScrolled(const glm::vec2&) override;
+		/*
+		Record a controller connection
+		Parameter: ActiasFW::Controller controller - The controller connected
+		*/
+		void controllerConnected(ActiasFW::Controller) override;
+		/*
+		Record a controller disconnection
+		Parameter: ActiasFW::Controller controller - The controller
+		disconnected
+		*/
+		void controllerDisconnected(ActiasFW::Controller) override;
+		/*
+		Record a controller button press
+		Parameter: ActiasFW::Controller controller - The controller
+		Parameter: ActiasFW::ControllerButtonCode button - The button pressed
+		*/
+		void controllerButtonPressed(ActiasFW::Controller,
+			ActiasFW::ControllerButtonCode) override;
+		/*
+		Record a controller button release
+		Parameter: ActiasFW::Controller controller - The controller
+		Parameter: ActiasFW::ControllerButtonCode button - The button released
+		*/
+		void controllerButtonReleased(ActiasFW::Controller,
+			ActiasFW::ControllerButtonCode) override;
+		/*
+		Record a movement of a controller axis
+		Parameter: ActiasFW::Controller controller - The controller
+		Parameter: ActiasFW::ControllerAxisCode axis - The axis moved
+		Parameter: float distance - The distance the axis moved
+		*/
+		void controllerAxisMoved(ActiasFW::Controller,
+			ActiasFW::ControllerAxisCode, float) override;
+
+	private:
+		// The recording frames are added to, or 0 if not recording
+		InputRecording* m_recording = 0;
+		// The frame time steps are added to, or 0 before the first frame,
+		// valid until the next frame starts
+		InputFrame* m_frame = 0;
+		// The events delivered since the last frame started
+		std::vector<InputEvent> m_pendingEvents;
+
+		/*
+		Record an event for the next frame if recording
+		Parameter: InputEventType type - The type of the event
+		Parameter: int32_t code - The event's key, button, character, or axis
+		Parameter: int32_t controller - The event's controller
+		Parameter: const glm::vec2& value - The event's movement
+		*/
+		void record(InputEventType, int32_t, int32_t, const glm::vec2&);
+	};
+
+	// A scene whose input is recorded frame by frame with its update time
+	// steps while its recorder is recording
+	template <typename S>
+	class RecordedScene : public S {
+	public:
+		/*
+		Get the recorder of this scene's input
+		Returns: InputRecorder& - The recorder
+		*/
+		InputRecorder& getInputRecorder() {
+			return m_recorder;
+		}
+
+	protected:
+		/*
+		Start a recorded frame and process input
+		Returns: bool - Whether to continue the application running the scene
+		*/
+		bool processInput() override {
+			m_recorder.beginFrame();
+			return S::processInput();
+		}
+		/*
+		Record an update's time step and update the scene's logic
+		Parameter: float timeStep - The number of frames elapsed since the
+		last update
+		*/
+		void update(float timeStep) override {
+			m_recorder.addTimeStep(timeStep);
+			S::update(timeStep);
+		}
+
+	private:
+		// The recorder of this scene's input
+		InputRecorder m_recorder;
+	};
+}
+
+#endif
@@ -0,0 +1,195 @@
+/*
+File:		JobSystem.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@20:10
+Purpose:	Contains the job system which runs parallel loops over ranges of
+			entities on a pool of work-stealing threads
+*/
+
+#ifndef LUNALL_JOB_SYSTEM_H
+#define LUNALL_JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LunaLL {
+	// Settings of a job system's thread pool
+	struct JobConfiguration {
+		// The number of threads running jobs including the thread waiting on
+		// them, or 0 for one for each hardware thread
+		unsigned int threadCount = 0;
+		// The number of times an idle worker thread looks for jobs before it
+		// sleeps
+		unsigned int spinCount = 64;
+	};
+
+	// A pool of worker threads which run parallel loops, each loop is split
+	// into jobs by halving its range and idle threads steal the largest
+	// remaining halves from the other threads' queues, the thread waiting on
+	// a loop runs its jobs too
+	class JobSystem {
+	public:
+		// The job system used by LunaLL's parallel updates
+		static JobSystem Jobs;
+
+		/*
+		Stop this job system's worker threads if they are still running
+		*/
+		~JobSystem();
+		/*
+		Start this job system's worker threads, loops run serially on the
+		calling thread until it is initialized and when it is initialized with
+		one thread
+		Parameter: const JobConfiguration& configuration - The settings of
+		this job system's thread pool
+		Returns: bool - Whether every worker thread was started
+		*/
+		bool initialize(const JobConfiguration& = JobConfiguration());
+		/*
+		Get the number of threads running this job system's jobs, including
+		the thread waiting on them
+		Returns: unsigned int - The number of threads
+		*/
+		unsigned int getThreadCount() const;
+		/*
+		Call a function on consecutive sub-ranges of a range in parallel and
+		wait for every call to return, the sub-ranges are the same for any
+		number of threads so a function which only writes the elements of its
+		sub-range gives the same results on any number of threads
+		Parameter: size_t begin - The first index of the range
+		Parameter: size_t end - One past the last index of the range
+		Parameter: size_t grainSize - The size of each sub-range but the last
+		Parameter: const F& function - The function to call with the first
+		index and one past the last index of each sub-range
+		*/
+		template <typename F>
+		void parallelFor(size_t begin, size_t end, size_t grainSize,
+			const F& function) {
+			run(begin, end, grainSize, &function,
+				[](const void* data, size_t first, size_t last) {
+					(*(const F*)data)(first, last);
+				});
+		}
+		/*
+		Update each entity of a list in parallel, an entity's update must only
+		change that entity, which ActiasFW does not document for its entities
+		but the job benchmark checks for its animations on every thread count
+		Parameter: std::vector<T>& entities - The entities to update
+		Parameter: float timeStep - The number of frames elapsed since the
+		last update
+		Parameter: size_t grainSize - The number of entities updated in each
+		job
+		*/
+		template <typename T>
+		void updateEntities(std::vector<T>& entities, float timeStep,
+			size_t grainSize = 1024) {
+			parallelFor(0, entities.size(), grainSize,
+				[&entities, timeStep](size_t first, size_t last) {
+					for (size_t i = first; i < last; i++) {
+						entities[i].update(timeStep);
+					}
+				});
+		}
+		/*
+		Stop and join this job system's worker threads, no loop may be running
+		during this call
+		*/
+		void destroy();
+
+	private:
+		// A range of a parallel loop
+		struct Job {
+			// Call the loop's function on a sub-range
+			void (*function)(const void*, size_t, size_t) = 0;
+			// The loop's function
+			const void* data = 0;
+			// The first index of the range
+			size_t begin = 0;
+			// One past the last index of the range
+			size_t end = 0;
+			// The size of each sub-range
+			size_t grainSize = 0;
+			// The number of the loop's sub-ranges not yet run
+			std::atomic<size_t>* remaining = 0;
+		};
+
+		// The jobs queued by one thread, the owner takes jobs from the back
+		// and other threads steal from the front
+		struct alignas(64) JobQueue {
+			// The lock on the jobs
+			std::mutex mutex;
+			// The jobs
+			std::deque<Job> jobs;
+		};
+
+		// The settings of this job system's thread pool
+		JobConfiguration m_configuration;
+		// Whether this job system's worker threads are running
+		std::atomic<bool> m_running = false;
+		// The queue of each worker thread, then the queue shared by threads
+		// outside the pool
+		std::vector<std::unique_ptr<JobQueue>> m_queues;
+		// The worker threads
+		std::vector<std::thread> m_threads;
+		// The number of jobs in every queue
+		std::atomic<size_t> m_queuedJobs = 0;
+		// The number of worker threads sleeping
+		std::atomic<unsigned int> m_sleepingThreads = 0;
+		// The lock worker threads sleep on
+		std::mutex m_sleepMutex;
+		// Signalled to wake sleeping worker threads
+		std::condition_variable m_wake;
+
+		/*
+		Run a parallel loop and wait for it to finish
+		Parameter: size_t begin - The first index of the range
+		Parameter: size_t end - One past the last index of the range
+		Parameter: size_t grainSize - The size of each sub-range
+		Parameter: const void* data - The loop's function
+		Parameter: void (*function)(const void*, size_t, size_t) - Calls the
+		loop's function on a sub-range
+		*/
+		void run(size_t, size_t, size_t, const void*,
+			void (*)(const void*, size_t, size_t));
+		/*
+		Get the queue of the calling thread
+		Returns: unsigned int - The index of the queue
+		*/
+		unsigned int getQueue() const;
+		/*
+		Add a job to a queue and wake a sleeping worker thread
+		Parameter: unsigned int queue - The index of the queue
+		Parameter: const Job& job - The job
+		*/
+		void push(unsigned int, const Job&);
+		/*
+		Take a job from a queue's back, or steal one from another queue's
+		front if it is empty
+		Parameter: unsigned int queue - The index of the calling thread's
+		queue
+		Parameter: Job& job - Set to the job taken
+		Returns: bool - Whether a job was taken
+		*/
+		bool take(unsigned int, Job&);
+		/*
+		Run a job, splitting off and queueing the upper half of its range until
+		it is a single sub-range
+		Parameter: unsigned int queue - The index of the calling thread's
+		queue
+		Parameter: Job job - The job
+		*/
+		void execute(unsigned int, Job);
+		/*
+		Run jobs on a worker thread until this job system is destroyed
+		Parameter: unsigned int queue - The index of the worker's queue
+		*/
+		void work(unsigned int);
+	};
+}
+
+#endif
@@ -0,0 +1,365 @@
+/*
+File:		Level.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@09:31
+Purpose:	Contains the versioned, chunked binary level format produced by
+			LunaLE and the utilities to write it and to stream it into
+			ActiasFW applications
+*/
+
+#ifndef LUNALL_LEVEL_H
+#define LUNALL_LEVEL_H
+
+#include "FileMapping.h"
+
+#include <ActiasFW/Graphics.h>
+
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace LunaLL {
+	// The identifier at the start of every level file
+	constexpr char LEVEL_FILE_MAGIC[4] = { 'L', 'L', 'V', 'L' };
+	// The newest version of the level format this library can read and write
+	constexpr uint32_t LEVEL_FORMAT_VERSION = 1;
+	// The tile kind index marking a position in a level as empty
+	constexpr uint16_t EMPTY_TILE = 0xFFFF;
+
+	/*
+	Level file layout (version 1, all values little endian):
+	Header (64 bytes)
+		char[4] magic, u32 version, u32 header size, u32 chunk size,
+		u32 width, u32 height (in tiles), f32 x, f32 y, f32 depth,
+		f32 tile width, f32 tile height, u32 tile kind count,
+		u64 tile kind table offset, u64 chunk index offset
+	Tile kind table (one entry per tile kind)
+		u32 texture file name length, char[] texture file name,
+		f32[4] texture box, i32[2] frame dimensions, f32 frame time
+	Chunk index (one 16 byte entry per chunk, row major from the bottom left)
+		u64 data offset, u32 data size, u32 encoding
+	Chunk data
+		CHUNK_RAW: u16 tile kind per tile, chunk size squared, row major
+		CHUNK_RUN_LENGTH: (u16 run length, u16 tile kind) pairs
+	*/
+
+	// The ways the tiles of a chunk can be stored in a level file
+	enum ChunkEncoding {
+		CHUNK_EMPTY,
+		CHUNK_RAW,
+		CHUNK_RUN_LENGTH,
+	};
+
+	// The ways a level can be loaded into memory
+	enum LevelLoadMode {
+		// Fully load small levels and stream large levels
+		LOAD_AUTOMATIC,
+		// Decode every chunk of the level when it is initialized
+		LOAD_FULL,
+		// Decode only the chunks of the level near the camera
+		LOAD_STREAMED,
+	};
+
+	// A kind of tile which can be placed in a level
+	struct TileKind {
+		// The file name of this tile kind's texture
+		std::string textureFileName = "";
+		// The texture coordinates of this tile kind (x, y, width, height)
+		glm::vec4 textureBox = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+		// The number of frames of animation in the texture horizontally and
+		// vertically
+		glm::ivec2 frameDimensions = glm::ivec2(1, 1);
+		// The number of updates to play each frame of animation for
+		float frameTime = 0.0f;
+	};
+
+	// The properties shared by every tile in a level
+	struct LevelProperties {
+		// The position of the bottom left corner of the level and its depth
+		glm::vec3 position = glm::vec3();
+		// The width and height of the level in tiles
+		glm::uvec2 dimensions = glm::uvec2();
+		// The width and height of each tile in the level
+		glm::vec2 tileDimensions = glm::vec2(1.0f, 1.0f);
+		// The width and height in tiles of each chunk of the level
+		unsigned int chunkSize = 64;
+	};
+
+	// Writes levels to disk in the chunked binary level format
+	class LevelWriter {
+	public:
+		/*
+		Initialize this level writer's memory
+		Parameter: const LevelProperties& properties - The properties of the
+		level to write
+		Returns: bool - Whether the properties describe a valid level
+		*/
+		bool initialize(const LevelProperties&);
+		/*
+		Add a kind of tile to the level
+		Parameter: const TileKind& tileKind - The tile kind to add
+		Returns: uint16_t - The index of the new tile kind or EMPTY_TILE if the
+		level has no room for more tile kinds
+		*/
+		uint16_t addTileKind(const TileKind&);
+		/*
+		Encode the level and write it to disk one chunk at a time
+		Parameter: const std::string& fileName - The file to write to
+		Parameter: const std::function<uint16_t(unsigned int, unsigned int)>&
+		getTile - Returns the tile kind at a tile position in the level
+		Returns: bool - Whether the level was written successfully
+		*/
+		bool write(const std::string&,
+			const std::function<uint16_t(unsigned int, unsigned int)>&);
+
+	private:
+		// Whether this level writer has been initialized
+		bool m_initialized = false;
+		// The properties of the level to write
+		LevelProperties m_properties;
+		// The tile kinds in the level to write
+		std::vector<TileKind> m_tileKinds;
+	};
+
+	// A level file mapped into memory which decodes its chunks on demand
+	class LevelFile {
+	public:
+		/*
+		Map a level file into memory and read its header
+		Parameter: const std::string& fileName - The level file to open
+		Returns: bool - Whether the file is a valid level of a supported version
+		*/
+		bool open(const std::string&);
+		/*
+		Unmap this level file and free its memory
+		*/
+		void close();
+		/*
+		Test whether this level file is open
+		Returns: bool - Whether this level file is open
+		*/
+		bool isOpen() const;
+		/*
+		Get the format version this level file was written in
+		Returns: uint32_t - This level file's version
+		*/
+		uint32_t getVersion() const;
+		/*
+		Get the properties of the level in this file
+		Returns: const LevelProperties& - The level's properties
+		*/
+		const LevelProperties& getProperties() const;
+		/*
+		Get the tile kinds used in the level in this file
+		Returns: const std::vector<TileKind>& - The level's tile kinds
+		*/
+		const std::vector<TileKind>& getTileKinds() const;
+		/*
+		Get the number of chunks in the level horizontally and vertically
+		Returns: const glm::uvec2& - The level's chunk counts
+		*/
+		const glm::uvec2& getChunkCounts() const;
+		/*
+		Test whether a chunk of the level contains no tiles
+		Parameter: const glm::uvec2& chunk - The coordinates of the chunk
+		Returns: bool - Whether the chunk is empty or out of range
+		*/
+		bool isChunkEmpty(const glm::uvec2&) const;
+		/*
+		Decode the tile kinds of a chunk of the level
+		Parameter: const glm::uvec2& chunk - The coordinates of the chunk
+		Parameter: std::vector<uint16_t>& tiles - Populated with the chunk's
+		tile kinds in row major order, or cleared if the chunk is empty
+		Returns: bool - Whether the chunk exists and was decoded successfully
+		*/
+		bool decodeChunk(const glm::uvec2&, std::vector<uint16_t>&) const;
+
+	private:
+		// This level file's mapping into memory
+		FileMapping m_mapping;
+		// The format version this level file was written in
+		uint32_t m_version = 0;
+		// The properties of the level in this file
+		LevelProperties m_properties;
+		// The tile kinds used in the level in this file
+		std::vector<TileKind> m_tileKinds;
+		// The number of chunks in the level horizontally and vertically
+		glm::uvec2 m_chunkCounts = glm::uvec2();
+		// The chunk index in the mapped file
+		const uint8_t* m_chunkIndex = 0;
+
+		/*
+		Read a chunk's index entry from the mapped file
+		Parameter: const glm::uvec2& chunk - The coordinates of the chunk
+		Parameter: uint64_t& offset - Populated with the chunk's data offset
+		Parameter: uint32_t& size - Populated with the chunk's data size
+		Parameter: uint32_t& encoding - Populated with the chunk's encoding
+		Returns: bool - Whether the chunk is in range
+		*/
+		bool getChunkEntry(const glm::uvec2&, uint64_t&, uint32_t&,
+			uint32_t&) const;
+	};
+
+	// Statistics on the chunks decoded by a level
+	struct LevelStatistics {
+		// The number of chunks decoded since the level was initialized
+		size_t chunksDecoded = 0;
+		// The number of chunks evicted since the level was initialized
+		size_t chunksEvicted = 0;
+		// The number of chunks which failed to decode since the level was
+		// initialized, each counted once
+		size_t chunksFailed = 0;
+		// The total time spent decoding chunks in seconds
+		double totalDecodeTime = 0.0;
+		// The longest time spent decoding a single chunk in seconds
+		double maximumDecodeTime = 0.0;
+	};
+
+	// A level of tiles loaded from a level file which keeps only the chunks
+	// near the camera resident in memory
+	class Level {
+	public:
+		// The largest level in tiles which is fully loaded in LOAD_AUTOMATIC
+		// mode
+		static constexpr size_t FULL_LOAD_TILE_LIMIT = 256 * 256;
+
+		/*
+		Open a level file and load it into memory
+		Parameter: const std::string& fileName - The level file to load
+		Parameter: LevelLoadMode loadMode - How to load the level
+		Returns: bool - Whether the level file could be opened
+		*/
+		bool initialize(const std::string&, LevelLoadMode = LOAD_AUTOMATIC);
+		/*
+		Load the chunks visible through a camera, evict distant chunks, and
+		update the level's animated tiles in parallel on the LunaLL job system
+		Parameter: const ActiasFW::Camera& camera - The camera viewing the level
+		Parameter: float timeStep - The number of frames elapsed since the last
+		update
+		*/
+		void update(const ActiasFW::Camera&, float);
+		/*
+		Load the chunks overlapping a box, evict distant chunks, and update the
+		level's animated tiles in parallel on the LunaLL job system
+		Parameter: const glm::vec4& visibleBox - The box in world coordinates
+		visible to the player (x, y, width, height)
+		Parameter: float timeStep - The number of frames elapsed since the last
+		update
+		*/
+		void update(const glm::vec4&, float);
+		/*
+		Submit the tiles of the level's resident chunks to be drawn this frame
+		Parameter: ActiasFW::GLSLShader& shader - The shader to draw with
+		*/
+		void draw(ActiasFW::GLSLShader&);
+		/*
+		Submit the tiles of the level's resident chunks to be drawn this frame
+		with the default shader
+		*/
+		void draw();
+		/*
+		Free this level's tiles and close its level file
+		*/
+		void destroy();
+		/*
+		Test whether this level streams its chunks from its level file
+		Returns: bool - Whether this level is streamed
+		*/
+		bool isStreamed() const;
+		/*
+		Get the number of chunks around the visible box kept in memory
+		Returns: unsigned int - This level's streaming margin in chunks
+		*/
+		unsigned int getStreamingMargin() const;
+		/*
+		Set the number of chunks around the visible box kept in memory
+		Parameter: unsigned int streamingMargin - The new streaming margin in
+		chunks
+		*/
+		void setStreamingMargin(unsigned int);
+		/*
+		Get the maximum number of chunks outside the visible box decoded in
+		each update
+		Returns: unsigned int - This level's prefetch budget
+		*/
+		unsigned int getPrefetchBudget() const;
+		/*
+		Set the maximum number of chunks outside the visible box decoded in
+		each update
+		Parameter: unsigned int prefetchBudget - The new prefetch budget
+		*/
+		void setPrefetchBudget(unsigned int);
+		/*
+		Get the number of chunks currently decoded in memory
+		Returns: size_t - The number of resident chunks
+		*/
+		size_t getResidentChunkCount() const;
+		/*
+		Get statistics on the chunks this level has decoded
+		Returns: const LevelStatistics& - This level's statistics
+		*/
+		const LevelStatistics& getStatistics() const;
+		/*
+		Get this level's level file
+		Returns: const LevelFile& - This level's file
+		*/
+		const LevelFile& getFile() const;
+
+	private:
+		// The tiles decoded from one chunk of a level
+		struct Chunk {
+			// The static tiles in this chunk
+			std::vector<ActiasFW::Sprite> sprites;
+			// The animated tiles in this chunk
+			std::vector<ActiasFW::Animation> animations;
+			// The update in which this chunk was last near the visible box
+			size_t lastUsed = 0;
+		};
+
+		// Whether this level has been initialized
+		bool m_initialized = false;
+		// This level's file
+		LevelFile m_file;
+		// Whether this level streams its chunks from its level file
+		bool m_streamed = false;
+		// The number of chunks around the visible box kept in memory
+		unsigned int m_streamingMargin = 1;
+		// The maximum number of chunks outside the visible box decoded in each
+		// update
+		unsigned int m_prefetchBudget = 4;
+		// The chunks currently decoded in memory by their chunk keys
+		std::unordered_map<uint64_t, Chunk> m_chunks;
+		// The keys of the chunks which failed to decode, which are not tried
+		// again until this level is initialized again
+		std::unordered_set<uint64_t> m_failedChunks;
+		// The number of updates since this level was initialized
+		size_t m_updateCount = 0;
+		// Reused storage for decoding the tile kinds of a chunk
+		std::vector<uint16_t> m_decodeBuffer;
+		// Reused list of the resident chunks with animated tiles
+		std::vector<std::vector<ActiasFW::Animation>*> m_animatedChunks;
+		// Statistics on the chunks this level has decoded
+		LevelStatistics m_statistics;
+
+		/*
+		Decode a chunk from this level's file and create its tiles
+		Parameter: const glm::uvec2& chunk - The coordinates of the chunk
+		Returns: bool - Whether the chunk was decoded successfully
+		*/
+		bool loadChunk(const glm::uvec2&);
+		/*
+		Destroy the tiles of a chunk before it is removed from this level's
+		resident chunks
+		Parameter: Chunk& chunk - The chunk to release
+		*/
+		static void ReleaseChunk(Chunk&);
+		/*
+		Get the key of a chunk in the resident chunk map
+		Parameter: const glm::uvec2& chunk - The coordinates of the chunk
+		Returns: uint64_t - The chunk's key
+		*/
+		static uint64_t GetChunkKey(const glm::uvec2&);
+	};
+}
+
+#endif
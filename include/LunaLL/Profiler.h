@@ -0,0 +1,499 @@
+/*
+File:		Profiler.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@18:40
+Purpose:	Contains the frame profiler which times scoped zones and frame
+			phases into per-frame histograms and exports Chrome traces
+*/
+
+#ifndef LUNALL_PROFILER_H
+#define LUNALL_PROFILER_H
+
+#include <ActiasFW/ActiasFW.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace LunaLL {
+// Join two tokens after expanding them
+#define LUNALL_PROFILE_JOIN(A, B) LUNALL_PROFILE_JOIN_EXPANDED(A, B)
+#define LUNALL_PROFILE_JOIN_EXPANDED(A, B) A##B
+
+// Time the rest of the enclosing scope as a zone with a name, which must be
+// a string literal
+#define LUNALL_PROFILE_ZONE(NAME) \
+	static const unsigned int LUNALL_PROFILE_JOIN(lunallZone, __LINE__) \
+		= LunaLL::FrameProfiler::Profiler.getZone(NAME); \
+	LunaLL::ProfileZone LUNALL_PROFILE_JOIN(lunallZoneScope, __LINE__)( \
+		LUNALL_PROFILE_JOIN(lunallZone, __LINE__))
+
+	// A histogram of durations in logarithmic buckets, each within about
+	// 4.5% of the durations counted in it
+	class FrameHistogram {
+	public:
+		// The number of buckets for each doubling of duration
+		static constexpr unsigned int BUCKETS_PER_OCTAVE = 8;
+		// The number of buckets, covering one microsecond to over a minute
+		static constexpr unsigned int BUCKET_COUNT = 1
+			+ 26 * BUCKETS_PER_OCTAVE;
+
+		/*
+		Count a duration in this histogram
+		Parameter: double milliseconds - The duration
+		*/
+		void add(double);
+		/*
+		Get an estimate of a percentile of the counted durations
+		Parameter: double percentile - The percentile between 0.0 and 100.0
+		Returns: double - The duration in milliseconds, or 0.0 if none were
+		counted
+		*/
+		double getPercentile(double) const;
+		/*
+		Get the number of durations counted
+		Returns: uint64_t - The count
+		*/
+		uint64_t getCount() const;
+		/*
+		Get the mean of the counted durations
+		Returns: double - The mean in milliseconds
+		*/
+		double getMean() const;
+		/*
+		Get the longest counted duration
+		Returns: double - The longest duration in milliseconds
+		*/
+		double getMaximum() const;
+		/*
+		Remove every counted duration
+		*/
+		void clear();
+
+	private:
+		// The number of durations in each bucket
+		std::array<uint64_t, BUCKET_COUNT> m_buckets = {};
+		// The number of durations counted
+		uint64_t m_count = 0;
+		// The sum of the counted durations in milliseconds
+		double m_total = 0.0;
+		// The longest counted duration in milliseconds
+		double m_maximum = 0.0;
+	};
+
+	// Settings of a frame profiler
+	struct ProfilerConfiguration {
+		// Whether zones are timed
+		bool enabled = true;
+		// Whether each zone is kept as a trace event to export
+		bool tracing = true;
+		// The most trace events kept, later events are only counted
+		size_t maximumTraceEvents = 1 << 20;
+	};
+
+	// A profiler of frames and named zones within them, which counts the time
+	// each zone takes per frame into a histogram and keeps each zone as a
+	// trace event to export in the Chrome trace format
+	class FrameProfiler {
+	public:
+		// The profiler timed by LUNALL_PROFILE_ZONE and profiled scenes
+		static FrameProfiler Profiler;
+		// The zone of each whole frame
+		static constexpr unsigned int FRAME_ZONE = 0;
+		// The zone of a scene's input processing and input listener callbacks
+		static constexpr unsigned int INPUT_ZONE = 1;
+		// The zone of a scene's updates
+		static constexpr unsigned int UPDATE_ZONE = 2;
+		// The zone of a scene's drawing
+		static constexpr unsigned int DRAW_ZONE = 3;
+		// The zone between a scene's drawing and its next frame, covering the
+		// graphics manager's end, the buffer swap, event polling, and waiting
+		// but not the input listener callbacks run while polling
+		static constexpr unsigned int PRESENT_ZONE = 4;
+
+		/*
+		Construct a frame profiler with the frame phases' zones
+		*/
+		FrameProfiler();
+		/*
+		Clear this profiler's histograms and trace and start timing
+		Parameter: const ProfilerConfiguration& configuration - The settings
+		of this profiler
+		*/
+		void initialize(const ProfilerConfiguration& = ProfilerConfiguration());
+		/*
+		Test whether this profiler times zones
+		Returns: bool - Whether this profiler is enabled
+		*/
+		bool isEnabled() const {
+			return m_enabled.load(std::memory_order_relaxed);
+		}
+		/*
+		Set whether this profiler times zones
+		Parameter: bool enabled - Whether to enable this profiler
+		*/
+		void setEnabled(bool);
+		/*
+		Get the ID of a zone by its name, adding the zone if it is new, zones
+		are kept for the life of the program
+		Parameter: const std::string& name - The name of the zone
+		Returns: unsigned int - The ID of the zone
+		*/
+		unsigned int getZone(const std::string&);
+		/*
+		Start a frame, ending the last frame if it was not ended
+		*/
+		void beginFrame();
+		/*
+		End the current frame, counting the time of the frame and of each zone
+		timed in it into their histograms
+		*/
+		void endFrame();
+		/*
+		Count a timed zone in the current frame, zones are gathered per thread
+		and merged when the frame ends
+		Parameter: unsigned int zone - The ID of the zone
+		Parameter: int64_t start - The time the zone started from getTime
+		Parameter: int64_t end - The time the zone ended from getTime
+		*/
+		void addZone(unsigned int, int64_t, int64_t);
+		/*
+		Get the number of zones
+		Returns: unsigned int - The number of zones
+		*/
+		unsigned int getZoneCount() const;
+		/*
+		Get the name of a zone
+		Parameter: unsigned int zone - The ID of the zone
+		Returns: std::string - The name of the zone
+		*/
+		std::string getZoneName(unsigned int) const;
+		/*
+		Get the histogram of the time a zone took in each frame it was timed
+		in, the frame zone's histogram holds the times of whole frames
+		Parameter: unsigned int zone - The ID of the zone
+		Returns: FrameHistogram - A copy of the zone's histogram
+		*/
+		FrameHistogram getHistogram(unsigned int) const;
+		/*
+		Get the number of frames ended since this profiler was initialized
+		Returns: uint64_t - The number of frames
+		*/
+		uint64_t getFrameCount() const;
+		/*
+		Get the number of trace events not kept because the trace was full
+		Returns: uint64_t - The number of events
+		*/
+		uint64_t getDroppedTraceEventCount() const;
+		/*
+		Write the trace events to a file in the Chrome trace event format,
+		which can be opened in chrome://tracing or Perfetto
+		Parameter: const std::string& fileName - The file to write
+		Returns: bool - Whether the file was written
+		*/
+		bool exportChromeTrace(const std::string&) const;
+		/*
+		Clear this profiler's histograms and trace and stop timing
+		*/
+		void destroy();
+		/*
+		Get the current time
+		Returns: int64_t - The time in nanoseconds on a steady clock
+		*/
+		static int64_t getTime();
+
+	private:
+		// A single timed zone kept for export
+		struct TraceEvent {
+			// The ID of the zone
+			unsigned int zone = 0;
+			// The index of the thread the zone was timed on
+			unsigned int thread = 0;
+			// The time the zone started
+			int64_t start = 0;
+			// The duration of the zone
+			int64_t duration = 0;
+		};
+
+		// The zones timed by one thread since the last frame ended
+		struct ThreadZones {
+			// The lock on these zones, only contended while a frame ends
+			std::mutex mutex;
+			// The time each zone took
+			std::vector<int64_t> totals;
+			// Whether each zone was timed
+			std::vector<bool> timed;
+			// The trace events kept
+			std::vector<TraceEvent> trace;
+			// Whether the timing thread has exited
+			std::atomic<bool> closed = false;
+		};
+
+		// Whether zones are timed
+		std::atomic<bool> m_enabled = false;
+		// The settings of this profiler, only changed while it is initialized
+		ProfilerConfiguration m_configuration;
+		// The lock on this profiler's zones, histograms, and trace
+		mutable std::mutex m_mutex;
+		// The names of the zones by their IDs
+		std::vector<std::string> m_zoneNames;
+		// The number of zones, read without the lock
+		std::atomic<unsigned int> m_zoneCount = 0;
+		// Incremented whenever this profiler is destroyed so threads replace
+		// their zones from earlier runs
+		std::atomic<uint32_t> m_generation = 0;
+		// The zones of every thread which has timed a zone in this run
+		std::vector<std::shared_ptr<ThreadZones>> m_threadZones;
+		// The time each zone took in the current frame
+		std::vector<int64_t> m_frameTotals;
+		// Whether each zone was timed in the current frame
+		std::vector<bool> m_frameTimed;
+		// The histograms of each zone's time per frame
+		std::vector<FrameHistogram> m_histograms;
+		// The time the current frame started, or 0 if no frame is running
+		int64_t m_frameStart = 0;
+		// The number of frames ended
+		uint64_t m_frameCount = 0;
+		// The time this profiler was initialized
+		int64_t m_startTime = 0;
+		// The kept trace events of ended frames
+		std::vector<TraceEvent> m_trace;
+		// The number of trace events kept, including those of the current
+		// frame not yet merged into the trace
+		std::atomic<size_t> m_traceEventCount = 0;
+		// The number of trace events not kept
+		std::atomic<uint64_t> m_droppedTraceEvents = 0;
+
+		/*
+		Add a zone, the lock must be held
+		Parameter: const std::string& name - The name of the zone
+		Returns: unsigned int - The ID of the zone
+		*/
+		unsigned int addZoneName(const std::string&);
+		/*
+		Get the calling thread's zones in this run of this profiler, adding
+		them if this thread has not timed a zone in it
+		Returns: ThreadZones& - The calling thread's zones
+		*/
+		ThreadZones& getThreadZones();
+		/*
+		Keep a trace event if the trace is not full, otherwise count it as
+		dropped
+		Parameter: std::vector<TraceEvent>& trace - The trace to keep the
+		event in
+		Parameter: const TraceEvent& event - The event
+		*/
+		void addTraceEvent(std::vector<TraceEvent>&, const TraceEvent&);
+	};
+
+	// Times the scope it is declared in as a zone of the frame profiler
+	class ProfileZone {
+	public:
+		/*
+		Start timing a zone if the frame profiler is enabled
+		Parameter: unsigned int zone - The ID of the zone
+		*/
+		explicit ProfileZone(unsigned int zone) : m_zone(zone) {
+			if (FrameProfiler::Profiler.isEnabled()) {
+				m_start = FrameProfiler::getTime();
+			}
+		}
+		/*
+		Count the zone in the frame profiler's current frame
+		*/
+		~ProfileZone() {
+			if (m_start != 0) {
+				FrameProfiler::Profiler.addZone(m_zone, m_start,
+					FrameProfiler::getTime());
+			}
+		}
+
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone& operator = (const ProfileZone&) = delete;
+
+	private:
+		// The ID of the zone
+		unsigned int m_zone = 0;
+		// The time the zone started, or 0 if it is not timed
+		int64_t m_start = 0;
+	};
+
+	// A scene whose frames and input, update, and draw phases are timed by
+	// the frame profiler, frames start when the application processes input
+	// and input listener callbacks are timed in the input zone
+	template <typename S>
+	class ProfiledScene : public S {
+	public:
+		/*
+		Pass a key press to the scene in the input zone
+		Parameter: ActiasFW::KeyCode key - The key pressed
+		*/
+		void keyPressed(ActiasFW::KeyCode key) override {
+			timeInput([&]() { S::keyPressed(key); });
+		}
+		/*
+		Pass a key release to the scene in the input zone
+		Parameter: ActiasFW::KeyCode key - The key released
+		*/
+		void keyReleased(ActiasFW::KeyCode key) override {
+			timeInput([&]() { S::keyReleased(key); });
+		}
+		/*
+		Pass a typed character to the scene in the input zone
+		Parameter: char character - The character typed
+		*/
+		void characterTyped(char character) override {
+			timeInput([&]() { S::characterTyped(character); });
+		}
+		/*
+		Pass a mouse button press to the scene in the input zone
+		Parameter: ActiasFW::MouseButtonCode button - The button pressed
+		*/
+		void mouseButtonPressed(ActiasFW::MouseButtonCode button) override {
+			timeInput([&]() { S::mouseButtonPressed(button); });
+		}
+		/*
+		Pass a mouse button release to the scene in the input zone
+		Parameter: ActiasFW::MouseButtonCode button - The button released
+		*/
+		void mouseButtonReleased(ActiasFW::MouseButtonCode button) override {
+			timeInput([&]() { S::mouseButtonReleased(button); });
+		}
+		/*
+		Pass a movement of the mouse cursor to the scene in the input zone
+		Parameter: const glm::vec2& distance - The distance the cursor moved
+		*/
+		void mouseCursorMoved(const glm::vec2& distance) override {
+			timeInput([&]() { S::mouseCursorMoved(distance); });
+		}
+		/*
+		Pass a movement of the mouse's scroll wheel to the scene in the input
+		zone
+		Parameter: const glm::vec2& distance - The distance scrolled
+		*/
+		void mouseScrolled(const glm::vec2& distance) override {
+			timeInput([&]() { S::mouseScrolled(distance); });
+		}
+		/*
+		Pass a controller connection to the scene in the input zone
+		Parameter: ActiasFW::Controller controller - The controller connected
+		*/
+		void controllerConnected(ActiasFW::Controller controller) override {
+			timeInput([&]() { S::controllerConnected(controller); });
+		}
+		/*
+		Pass a controller disconnection to the scene in the input zone
+		Parameter: ActiasFW::Controller controller - The controller
+		disconnected
+		*/
+		void controllerDisconnected(ActiasFW::Controller controller) override {
+			timeInput([&]() { S::controllerDisconnected(controller); });
+		}
+		/*
+		Pass a controller button press to the scene in the input zone
+		Parameter: ActiasFW::Controller controller - The controller
+		Parameter: ActiasFW::ControllerButtonCode button - The button pressed
+		*/
+		void controllerButtonPressed(ActiasFW::Controller controller,
+			ActiasFW::ControllerButtonCode button) override {
+			timeInput([&]() {
+				S::controllerButtonPressed(controller, button);
+			});
+		}
+		/*
+		Pass a controller button release to the scene in the input zone
+		Parameter: ActiasFW::Controller controller - The controller
+		Parameter: ActiasFW::ControllerButtonCode button - The button released
+		*/
+		void controllerButtonReleased(ActiasFW::Controller controller,
+			ActiasFW::ControllerButtonCode button) override {
+			timeInput([&]() {
+				S::controllerButtonReleased(controller, button);
+			});
+		}
+		/*
+		Pass a movement of a controller axis to the scene in the input zone
+		Parameter: ActiasFW::Controller controller - The controller
+		Parameter: ActiasFW::ControllerAxisCode axis - The axis moved
+		Parameter: float distance - The distance the axis moved
+		*/
+		void controllerAxisMoved(ActiasFW::Controller controller,
+			ActiasFW::ControllerAxisCode axis, float distance) override {
+			timeInput([&]() {
+				S::controllerAxisMoved(controller, axis, distance);
+			});
+		}
+
+	protected:
+		/*
+		End the last frame, start a new frame, and process input in its zone
+		Returns: bool - Whether to continue the application running the scene
+		*/
+		bool processInput() override {
+			FrameProfiler& profiler = FrameProfiler::Profiler;
+			if (m_presentStart != 0 && profiler.isEnabled()) {
+				profiler.addZone(FrameProfiler::PRESENT_ZONE, m_presentStart,
+					FrameProfiler::getTime());
+			}
+			m_presentStart = 0;
+			profiler.beginFrame();
+			ProfileZone zone(FrameProfiler::INPUT_ZONE);
+			return S::processInput();
+		}
+		/*
+		Update the scene's logic in the update zone
+		Parameter: float timeStep - The number of frames elapsed since the
+		last update
+		*/
+		void update(float timeStep) override {
+			ProfileZone zone(FrameProfiler::UPDATE_ZONE);
+			S::update(timeStep);
+		}
+		/*
+		Draw the scene's graphics in the draw zone
+		*/
+		void draw() override {
+			{
+				ProfileZone zone(FrameProfiler::DRAW_ZONE);
+				S::draw();
+			}
+			m_presentStart = FrameProfiler::getTime();
+		}
+
+	private:
+		// The start of the present zone's time not yet counted, or 0 if the
+		// frame was not drawn
+		int64_t m_presentStart = 0;
+
+		/*
+		Run an input listener callback in the input zone, splitting it out of
+		the present zone when it is delivered while polling events
+		Parameter: const F& callback - The callback
+		*/
+		template <typename F>
+		void timeInput(const F& callback) {
+			FrameProfiler& profiler = FrameProfiler::Profiler;
+			if (!profiler.isEnabled()) {
+				callback();
+				return;
+			}
+			const int64_t start = FrameProfiler::getTime();
+			if (m_presentStart != 0) {
+				profiler.addZone(FrameProfiler::PRESENT_ZONE, m_presentStart,
+					start);
+			}
+			callback();
+			const int64_t end = FrameProfiler::getTime();
+			profiler.addZone(FrameProfiler::INPUT_ZONE, start, end);
+			if (m_presentStart != 0) {
+				m_presentStart = end;
+			}
+		}
+	};
+}
+
+#endif
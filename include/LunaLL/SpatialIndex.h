@@ -0,0 +1,441 @@
+/*
+File:		SpatialIndex.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@13:10
+Purpose:	Contains a loose grid spatial index over entities and sprites for
+			viewport culling, picking, and intersection queries
+*/
+
+#ifndef LUNALL_SPATIAL_INDEX_H
+#define LUNALL_SPATIAL_INDEX_H
+
+#include <ActiasFW/Graphics.h>
+
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace LunaLL {
+	// A loose grid of entities by their bounding boxes, each entity is stored
+	// in the cell containing its center and queries are widened by the
+	// largest entity extent
+	class SpatialIndex {
+	public:
+		// The ID returned when an entity could not be inserted
+		static constexpr unsigned int INVALID_ID = 0xFFFFFFFF;
+		// The largest magnitude of a cell coordinate, boxes beyond it are
+		// kept in the outermost cells
+		static constexpr int CELL_LIMIT = 1 << 30;
+
+		/*
+		Construct an empty spatial index
+		*/
+		SpatialIndex() = default;
+		SpatialIndex(const SpatialIndex&) = delete;
+		SpatialIndex& operator = (const SpatialIndex&) = delete;
+		/*
+		Initialize this spatial index's memory
+		Parameter: const glm::vec2& cellDimensions - The width and height of
+		each cell of the grid, a few times the size of a typical entity
+		*/
+		void initialize(const glm::vec2&);
+		/*
+		Insert an entity into this index with a bounding box
+		Parameter: ActiasFW::Entity& entity - The entity to insert
+		Parameter: const glm::vec4& box - The entity's bounding box (x, y,
+		width, height)
+		Returns: unsigned int - The ID of the entity in this index, or
+		INVALID_ID if the box is not finite
+		*/
+		unsigned int insert(ActiasFW::Entity&, const glm::vec4&);
+		/*
+		Insert a sprite into this index using its position and dimensions as
+		its bounding box
+		Parameter: ActiasFW::Sprite& sprite - The sprite to insert
+		Returns: unsigned int - The ID of the sprite in this index, or
+		INVALID_ID if its bounding box is not finite
+		*/
+		unsigned int insert(ActiasFW::Sprite&);
+		/*
+		Move an entity in this index to a new bounding box
+		Parameter: unsigned int ID - The ID of the entity
+		Parameter: const glm::vec4& box - The entity's new bounding box
+		Returns: bool - Whether the entity was in this index and the box is
+		finite
+		*/
+		bool update(unsigned int, const glm::vec4&);
+		/*
+		Move a sprite in this index to its current position and dimensions
+		Parameter: unsigned int ID - The ID of the sprite
+		Returns: bool - Whether the sprite was in this index and its bounding
+		box is finite
+		*/
+		bool update(unsigned int);
+		/*
+		Remove an entity from this index
+		Parameter: unsigned int ID - The ID of the entity
+		Returns: bool - Whether the entity was in this index
+		*/
+		bool remove(unsigned int);
+		/*
+		Find the entities whose bounding boxes overlap a box
+		Parameter: const glm::vec4& box - The box to test (x, y, width, height)
+		Parameter: std::vector<unsigned int>& IDs - Populated with the IDs of
+		the overlapping entities
+		*/
+		void query(const glm::vec4&, std::vector<unsigned int>&) const;
+		/*
+		Find the entities whose bounding boxes contain a point
+		Parameter: const glm::vec2& point - The point to test
+		Parameter: std::vector<unsigned int>& IDs - Populated with the IDs of
+		the entities containing the point
+		*/
+		void query(const glm::vec2&, std::vector<unsigned int>&) const;
+		/*
+		Find the entities visible through a camera
+		Parameter: const ActiasFW::Camera& camera - The camera to test
+		Parameter: std::vector<unsigned int>& IDs - Populated with the IDs of
+		the visible entities
+		*/
+		void query(const ActiasFW::Camera&, std::vector<unsigned int>&) const;
+		/*
+		Call a function on every entity whose bounding box overlaps a box
+		Parameter: const glm::vec4& box - The box to test (x, y, width, height)
+		Parameter: F function - Called with the ID of each overlapping entity
+		*/
+		template <typename F>
+		void forEach(const glm::vec4& box, F function) const {
+			forEachCell(box, [this, &box, &function](
+				const std::vector<unsigned int>& cell) {
+				for (unsigned int ID : cell) {
+					const glm::vec4& other = m_entries[ID].box;
+					if (box.x < other.x + other.z && other.x < box.x + box.z
+						&& box.y < other.y + other.w
+						&& other.y < box.y + box.w) {
+						function(ID);
+					}
+				}
+			});
+		}
+		/*
+		Find the entities whose bounding boxes overlap an entity in this index
+		Parameter: unsigned int ID - The ID of the entity to test
+		Parameter: std::vector<unsigned int>& IDs - Populated with the IDs of
+		the other overlapping entities
+		*/
+		void findIntersections(unsigned int, std::vector<unsigned int>&) const;
+		/*
+		Find every pair of entities in this index whose bounding boxes overlap
+		Parameter: std::vector<std::pair<unsigned int, unsigned int>>& pairs -
+		Populated with the IDs of each overlapping pair, lowest ID first
+		*/
+		void findIntersections(
+			std::vector<std::pair<unsigned int, unsigned int>>&) const;
+		/*
+		Submit the sprites in this index visible through a camera to be drawn
+		this frame
+		Parameter: const ActiasFW::Camera& camera - The camera to cull with
+		Parameter: ActiasFW::GLSLShader& shader - The shader to draw with
+		*/
+		void submit(const ActiasFW::Camera&, ActiasFW::GLSLShader&);
+		/*
+		Submit the sprites in this index visible through the shader's camera to
+		be drawn this frame
+		Parameter: ActiasFW::GLSLShader& shader - The shader to draw with
+		*/
+		void submit(ActiasFW::GLSLShader&);
+		/*
+		Submit the sprites in this index visible through the default camera to
+		be drawn this frame with the default shader
+		*/
+		void submit();
+		/*
+		Remove every entity from this index and free its memory
+		*/
+		void destroy();
+		/*
+		Get an entity in this index by its ID
+		Parameter: unsigned int ID - The ID of the entity
+		Returns: ActiasFW::Entity* - The entity or 0 if the ID is not in use
+		*/
+		ActiasFW::Entity* getEntity(unsigned int) const;
+		/*
+		Get a sprite in this index by its ID
+		Parameter: unsigned int ID - The ID of the sprite
+		Returns: ActiasFW::Sprite* - The sprite or 0 if the ID is not in use or
+		was not inserted as a sprite
+		*/
+		ActiasFW::Sprite* getSprite(unsigned int) const;
+		/*
+		Get the bounding box of an entity in this index by its ID
+		Parameter: unsigned int ID - The ID of the entity
+		Returns: const glm::vec4& - The entity's bounding box
+		*/
+		const glm::vec4& getBox(unsigned int) const;
+		/*
+		Get the number of entities in this index
+		Returns: size_t - The number of entities
+		*/
+		size_t getSize() const;
+		/*
+		Get a token which expires when this index is destroyed or goes out of
+		scope, for detecting IDs and pointers to this index which are stale
+		Returns: std::weak_ptr<const bool> - This index's lifetime token
+		*/
+		std::weak_ptr<const bool> getLifetime() const;
+
+	private:
+		// An entity in a spatial index
+		struct Entry {
+			// The entity, or 0 if this entry is free
+			ActiasFW::Entity* entity = 0;
+			// The entity as a sprite, or 0 if it was not inserted as one
+			ActiasFW::Sprite* sprite = 0;
+			// The entity's bounding box
+			glm::vec4 box = glm::vec4();
+			// The key of the cell containing the entity's center
+			uint64_t cell = 0;
+			// The position of the entity's ID in its cell
+			size_t cellIndex = 0;
+		};
+
+		// The width and height of each cell of the grid
+		glm::vec2 m_cellDimensions = glm::vec2(1.0f, 1.0f);
+		// The entities in this index by their IDs
+		std::vector<Entry> m_entries;
+		// The IDs of free entries in this index
+		std::vector<unsigned int> m_freeIDs;
+		// The IDs of the entities in each occupied cell by cell key
+		std::unordered_map<uint64_t, std::vector<unsigned int>> m_cells;
+		// The largest half width and half height of any entity inserted since
+		// this index was initialized
+		glm::vec2 m_maximumHalfExtent = glm::vec2();
+		// The number of entities in this index
+		size_t m_size = 0;
+		// Replaced whenever this index is destroyed, expiring the tokens given
+		// out before
+		std::shared_ptr<const bool> m_lifetime = std::make_shared<bool>(true);
+
+		/*
+		Test whether every component of a box is finite
+		Parameter: const glm::vec4& box - The box to test
+		Returns: bool - Whether the box is finite
+		*/
+		static bool IsFinite(const glm::vec4& box) {
+			return std::isfinite(box.x) && std::isfinite(box.y)
+				&& std::isfinite(box.z) && std::isfinite(box.w);
+		}
+		/*
+		Get the coordinates of the cell containing a point, clamped to the
+		cell limit
+		Parameter: const glm::vec2& point - The point, which must be finite
+		Returns: glm::ivec2 - The cell coordinates
+		*/
+		glm::ivec2 getCell(const glm::vec2&) const;
+		/*
+		Get the key of the cell containing a point
+		Parameter: const glm::vec2& point - The point
+		Returns: uint64_t - The cell key
+		*/
+		uint64_t getCellKey(const glm::vec2&) const;
+		/*
+		Add an entry's ID to the cell containing its center
+		Parameter: unsigned int ID - The ID of the entry
+		*/
+		void link(unsigned int);
+		/*
+		Remove an entry's ID from its cell
+		Parameter: unsigned int ID - The ID of the entry
+		*/
+		void unlink(unsigned int);
+		/*
+		Call a function on every occupied cell which may hold entities
+		overlapping a box
+		Parameter: const glm::vec4& box - The box to test
+		Parameter: F function - Called with each cell's entity IDs
+		*/
+		template <typename F>
+		void forEachCell(const glm::vec4& box, F function) const {
+			if (m_cells.empty() || !IsFinite(box)) {
+				return;
+			}
+			const glm::ivec2 minimum = getCell(glm::vec2(box)
+				- m_maximumHalfExtent);
+			const glm::ivec2 maximum = getCell(glm::vec2(box)
+				+ glm::vec2(box.z, box.w) + m_maximumHalfExtent);
+			double cellCount = ((double)maximum.x - minimum.x + 1.0)
+				* ((double)maximum.y - minimum.y + 1.0);
+			if (cellCount > (double)m_cells.size()) {
+				// Visit the occupied cells directly when the box covers more
+				// cells than are occupied
+				for (const std::pair<const uint64_t, std::vector<unsigned int>>&
+					cell : m_cells) {
+					function(cell.second);
+				}
+				return;
+			}
+			for (int y = minimum.y; y <= maximum.y; y++) {
+				for (int x = minimum.x; x <= maximum.x; x++) {
+					std::unordered_map<uint64_t, std::vector<unsigned int>>
+						::const_iterator it = m_cells.find(
+						((uint64_t)(uint32_t)y << 32) | (uint32_t)x);
+					if (it != m_cells.end()) {
+						function(it->second);
+					}
+				}
+			}
+		}
+	};
+
+	// A sprite, animation, or other sprite type which keeps its bounding box
+	// in a spatial index up to date as it moves and resizes, an indexed sprite
+	// cannot be copied and is inserted into its index again when it is moved
+	template <typename T = ActiasFW::Sprite>
+	class IndexedSprite : public T {
+	public:
+		/*
+		Construct a sprite outside of any spatial index
+		*/
+		IndexedSprite() = default;
+		IndexedSprite(const IndexedSprite&) = delete;
+		IndexedSprite& operator = (const IndexedSprite&) = delete;
+		/*
+		Move another sprite's state into this sprite, taking its place in its
+		spatial index
+		Parameter: IndexedSprite&& sprite - The sprite to move, left outside
+		of any spatial index
+		*/
+		IndexedSprite(IndexedSprite&& sprite) : T(std::move(sprite)) {
+			SpatialIndex* index = sprite.getIndex();
+			sprite.leaveIndex();
+			if (index != 0) {
+				setIndex(*index);
+			}
+		}
+		/*
+		Move another sprite's state into this sprite, leaving this sprite's
+		spatial index and taking the other sprite's place in its index
+		Parameter: IndexedSprite&& sprite - The sprite to move, left outside
+		of any spatial index
+		Returns: IndexedSprite& - This sprite
+		*/
+		IndexedSprite& operator = (IndexedSprite&& sprite) {
+			if (&sprite == this) {
+				return *this;
+			}
+			SpatialIndex* index = sprite.getIndex();
+			sprite.leaveIndex();
+			leaveIndex();
+			T::operator = (std::move(sprite));
+			if (index != 0) {
+				setIndex(*index);
+			}
+			return *this;
+		}
+		/*
+		Remove this sprite from its spatial index
+		*/
+		~IndexedSprite() {
+			leaveIndex();
+		}
+		/*
+		Insert this sprite into a spatial index once it has been initialized,
+		removing it from any previous index
+		Parameter: SpatialIndex& index - The index to insert into
+		Returns: unsigned int - The ID of this sprite in the index
+		*/
+		unsigned int setIndex(SpatialIndex& index) {
+			leaveIndex();
+			m_indexID = index.insert(*this);
+			if (m_indexID != SpatialIndex::INVALID_ID) {
+				m_index = &index;
+				m_indexLifetime = index.getLifetime();
+			}
+			return m_indexID;
+		}
+		/*
+		Get the spatial index holding this sprite
+		Returns: SpatialIndex* - This sprite's index, or 0 if it is in no index
+		or its index was destroyed or went out of scope since it was inserted
+		*/
+		SpatialIndex* getIndex() const {
+			return m_index != 0 && !m_indexLifetime.expired() ? m_index : 0;
+		}
+		/*
+		Get the ID of this sprite in its spatial index
+		Returns: unsigned int - This sprite's ID or SpatialIndex::INVALID_ID
+		*/
+		unsigned int getIndexID() const {
+			return getIndex() != 0 ? m_indexID : SpatialIndex::INVALID_ID;
+		}
+		/*
+		Update this sprite and move it in its spatial index if it moved
+		Parameter: float timeStep - The number of frames elapsed since the last
+		update
+		*/
+		void update(float timeStep) override {
+			T::update(timeStep);
+			if (this->getVelocity() != glm::vec2()) {
+				updateIndex();
+			}
+		}
+		/*
+		Remove this sprite from its spatial index and free its memory
+		*/
+		void destroy() override {
+			leaveIndex();
+			T::destroy();
+		}
+		/*
+		Set this sprite's position and depth and move it in its spatial index
+		Parameter: const glm::vec3& position - The new position and depth
+		*/
+		void setPosition(const glm::vec3& position) override {
+			T::setPosition(position);
+			updateIndex();
+		}
+		/*
+		Set this sprite's dimensions and resize it in its spatial index
+		Parameter: const glm::vec2& dimensions - The new width and height
+		*/
+		void setDimensions(const glm::vec2& dimensions) override {
+			T::setDimensions(dimensions);
+			updateIndex();
+		}
+
+	private:
+		// The spatial index holding this sprite
+		SpatialIndex* m_index = 0;
+		// The ID of this sprite in its spatial index
+		unsigned int m_indexID = SpatialIndex::INVALID_ID;
+		// The lifetime token of the spatial index when this sprite was
+		// inserted, its index pointer and ID are stale once it expires
+		std::weak_ptr<const bool> m_indexLifetime;
+
+		/*
+		Move this sprite to its bounding box in its spatial index if its ID is
+		still current
+		*/
+		void updateIndex() {
+			SpatialIndex* index = getIndex();
+			if (index != 0) {
+				index->update(m_indexID);
+			}
+		}
+		/*
+		Remove this sprite from its spatial index if its ID is still current
+		and forget the index
+		*/
+		void leaveIndex() {
+			SpatialIndex* index = getIndex();
+			if (index != 0) {
+				index->remove(m_indexID);
+			}
+			m_index = 0;
+			m_indexID = SpatialIndex::INVALID_ID;
+		}
+	};
+}
+
+#endif
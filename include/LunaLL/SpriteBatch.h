@@ -0,0 +1,311 @@
+/*
+File:		SpriteBatch.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@11:20
+Purpose:	Contains a retained sprite batch which keeps sprite geometry in a
+			single vertex buffer and re-encodes only the sprites which change
+*/
+
+#ifndef LUNALL_SPRITE_BATCH_H
+#define LUNALL_SPRITE_BATCH_H
+
+#include "TextureCache.h"
+
+#include <ActiasFW/Graphics.h>
+
+#include <cstdint>
+
+namespace LunaLL {
+	// A single vertex of a sprite drawn by a sprite batch
+	struct SpriteVertex {
+		// The position and depth of this vertex
+		glm::vec3 position = glm::vec3();
+		// The texture coordinates of this vertex
+		glm::vec2 textureCoordinates = glm::vec2();
+		// The RGBA color of this vertex
+		glm::vec4 color = glm::vec4();
+	};
+
+	// A textured quad drawn by a sprite batch without a sprite, such as a text
+	// glyph
+	struct SpriteBatchQuad {
+		// The position and depth of the quad's bottom left corner
+		glm::vec3 position = glm::vec3();
+		// The width and height of the quad
+		glm::vec2 dimensions = glm::vec2();
+		// The texture coordinates of the quad (x, y, width, height)
+		glm::vec4 textureBox = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+		// The RGBA color of the quad
+		glm::vec4 color = glm::vec4(1.0f);
+	};
+
+	// A contiguous range of a sprite batch's indices drawn with one shader and
+	// one texture
+	struct SpriteBatchCommand {
+		// The index of the shader to draw with in the batch's shaders
+		unsigned int shader = 0;
+		// The OpenGL texture to draw with
+		GLuint texture = 0;
+		// The first index in the batch's index buffer to draw
+		size_t firstIndex = 0;
+		// The number of indices to draw
+		size_t indexCount = 0;
+	};
+
+	// Statistics on the most recent build and render of a sprite batch
+	struct SpriteBatchStatistics {
+		// The number of sprites in the batch
+		size_t spriteCount = 0;
+		// The number of sprites re-encoded in the last build
+		size_t spritesEncoded = 0;
+		// Whether the draw order was rebuilt in the last build
+		bool orderRebuilt = false;
+		// The number of draw calls made in the last render
+		size_t drawCalls = 0;
+		// The number of bytes uploaded to OpenGL in the last render
+		size_t bytesUploaded = 0;
+	};
+
+	// A retained batch of sprites drawn with as few draw calls as possible,
+	// sorted by shader, depth, and texture, sprites whose textures share an
+	// atlas page are drawn together
+	class SpriteBatch {
+	public:
+		// The sizes in floats of the vertex attributes of a SpriteVertex,
+		// shaders drawing a sprite batch must be initialized with these
+		static const std::vector<unsigned int> VERTEX_ATTRIBUTE_SIZES;
+		// The ID returned when a sprite could not be added to a batch
+		static constexpr unsigned int INVALID_ID = 0xFFFFFFFF;
+
+		/*
+		Initialize this sprite batch's memory
+		Parameter: TextureCache& textures - The cache to load this batch's
+		textures from in the background
+		*/
+		void initialize(TextureCache&);
+		/*
+		Add a sprite to this batch, the sprite must remain in memory until it
+		is removed
+		Parameter: ActiasFW::Sprite& sprite - The sprite to add
+		Parameter: ActiasFW::GLSLShader& shader - The shader to draw the sprite
+		with
+		Returns: unsigned int - The ID of the sprite in this batch
+		*/
+		unsigned int add(ActiasFW::Sprite&, ActiasFW::GLSLShader&);
+		/*
+		Add a set of sprites to this batch, the sprites must remain in memory
+		until they are removed
+		Parameter: std::vector<T>& sprites - The sprites to add
+		Parameter: ActiasFW::GLSLShader& shader - The shader to draw the
+		sprites with
+		Parameter: std::vector<unsigned int>& IDs - Populated with the IDs of
+		the sprites in this batch
+		*/
+		template <typename T>
+		void add(std::vector<T>& sprites, ActiasFW::GLSLShader& shader,
+			std::vector<unsigned int>& IDs) {
+			IDs.reserve(IDs.size() + sprites.size());
+			for (T& sprite : sprites) {
+				IDs.push_back(add(sprite, shader));
+			}
+		}
+		/*
+		Add a quad to this batch drawn with an OpenGL texture which is not
+		loaded by the texture cache
+		Parameter: const SpriteBatchQuad& quad - The quad to add
+		Parameter: GLuint texture - The OpenGL texture to draw the quad with
+		Parameter: ActiasFW::GLSLShader& shader - The shader to draw the quad
+		with
+		Returns: unsigned int - The ID of the quad in this batch
+		*/
+		unsigned int addQuad(const SpriteBatchQuad&, GLuint,
+			ActiasFW::GLSLShader&);
+		/*
+		Change a quad in this batch, which is re-encoded in the next build only
+		if it differs from its current state
+		Parameter: unsigned int ID - The ID of the quad
+		Parameter: const SpriteBatchQuad& quad - The quad's new state
+		Parameter: GLuint texture - The OpenGL texture to draw the quad with
+		Returns: bool - Whether the ID belongs to a quad in this batch
+		*/
+		bool setQuad(unsigned int, const SpriteBatchQuad&, GLuint);
+		/*
+		Remove a sprite or quad from this batch by its ID
+		Parameter: unsigned int ID - The ID of the sprite to remove
+		Returns: bool - Whether the sprite was in this batch
+		*/
+		bool remove(unsigned int);
+		/*
+		Force a sprite in this batch to be re-encoded in the next build
+		Parameter: unsigned int ID - The ID of the sprite
+		*/
+		void invalidate(unsigned int);
+		/*
+		Re-encode the sprites in this batch which have moved, resized, rotated,
+		or changed color or texture and the sprites whose textures finished
+		loading, and rebuild the draw order if necessary, uses no OpenGL calls
+		*/
+		void build();
+		/*
+		Upload the changed vertices and indices of this batch and draw it
+		*/
+		void render();
+		/*
+		Delete this batch's OpenGL buffers and free its memory
+		*/
+		void destroy();
+		/*
+		Get the vertices of every sprite in this batch
+		Returns: const std::vector<SpriteVertex>& - This batch's vertices
+		*/
+		const std::vector<SpriteVertex>& getVertices() const;
+		/*
+		Get the indices of this batch's vertices in draw order
+		Returns: const std::vector<GLuint>& - This batch's indices
+		*/
+		const std::vector<GLuint>& getIndices() const;
+		/*
+		Get the draw commands built for this batch
+		Returns: const std::vector<SpriteBatchCommand>& - This batch's commands
+		*/
+		const std::vector<SpriteBatchCommand>& getCommands() const;
+		/*
+		Get statistics on this batch's most recent build and render
+		Returns: const SpriteBatchStatistics& - This batch's statistics
+		*/
+		const SpriteBatchStatistics& getStatistics() const;
+
+	private:
+		// A sprite or quad in a sprite batch and the state it was last encoded
+		// with
+		struct Entry {
+			// Whether this entry's slot holds a sprite or quad
+			bool used = false;
+			// The sprite, or 0 if this entry is a quad
+			ActiasFW::Sprite* sprite = 0;
+			// The index of the sprite's shader in the batch's shaders
+			unsigned int shader = 0;
+			// The index of the sprite's texture in the batch's texture names
+			unsigned int texture = 0;
+			// Whether the sprite must be re-encoded in the next build
+			bool dirty = true;
+			// The encoded position and depth
+			glm::vec3 position = glm::vec3();
+			// The encoded dimensions
+			glm::vec2 dimensions = glm::vec2();
+			// The encoded rotation in degrees
+			float rotation = 0.0f;
+			// The encoded texture coordinates
+			glm::vec4 textureBox = glm::vec4();
+			// The encoded color
+			glm::vec4 color = glm::vec4();
+			// The encoded horizontal reflection
+			bool reflectedHorizontally = false;
+			// The encoded vertical reflection
+			bool reflectedVertically = false;
+		};
+
+		// The texture cache to load this batch's textures from
+		TextureCache* m_textures = 0;
+		// The sprites in this batch by their IDs
+		std::vector<Entry> m_entries;
+		// The IDs of free entries in this batch
+		std::vector<unsigned int> m_freeIDs;
+		// The shaders used by this batch
+		std::vector<ActiasFW::GLSLShader*> m_shaders;
+		// The file names of the textures used by this batch, empty for
+		// textures not loaded by the texture cache
+		std::vector<std::string> m_textureNames;
+		// Whether each of this batch's textures is an OpenGL texture not
+		// loaded by the texture cache, as an empty file name is also valid
+		std::vector<bool> m_rawTextures;
+		// The indices of texture names in the texture name list
+		std::unordered_map<std::string, unsigned int> m_textureIndices;
+		// The indices of the textures not loaded by the texture cache in the
+		// texture name list
+		std::unordered_map<GLuint, unsigned int> m_rawTextureIndices;
+		// The regions of this batch's textures the sprites were encoded with
+		std::vector<TextureRegion> m_textureRegions;
+		// The texture cache's region generation when the regions were read
+		unsigned int m_textureGeneration = 0;
+		// Four vertices for each entry in this batch
+		std::vector<SpriteVertex> m_vertices;
+		// The indices of this batch's vertices in draw order
+		std::vector<GLuint> m_indices;
+		// The draw commands built for this batch
+		std::vector<SpriteBatchCommand> m_commands;
+		// The IDs of the sprites in draw order
+		std::vector<unsigned int> m_order;
+		// Whether the draw order must be rebuilt in the next build
+		bool m_orderChanged = false;
+		// The first vertex changed since the last upload
+		size_t m_firstDirtyVertex = SIZE_MAX;
+		// One past the last vertex changed since the last upload
+		size_t m_lastDirtyVertex = 0;
+		// Whether the indices changed since the last upload
+		bool m_indicesDirty = false;
+		// The ID of the OpenGL vertex array object used to draw this batch
+		GLuint m_VAOID = 0;
+		// The ID of the OpenGL vertex buffer object holding this batch's
+		// vertices
+		GLuint m_VBOID = 0;
+		// The ID of the OpenGL index buffer object holding this batch's
+		// indices
+		GLuint m_IBOID = 0;
+		// The size of the vertex buffer in bytes
+		size_t m_vertexBufferSize = 0;
+		// The size of the index buffer in bytes
+		size_t m_indexBufferSize = 0;
+		// Statistics on this batch's most recent build and render
+		SpriteBatchStatistics m_statistics;
+
+		/*
+		Get the index of a shader in this batch, adding it if necessary
+		Parameter: ActiasFW::GLSLShader& shader - The shader
+		Returns: unsigned int - The index of the shader
+		*/
+		unsigned int getShaderIndex(ActiasFW::GLSLShader&);
+		/*
+		Get the index of a texture name in this batch, adding it if necessary
+		Parameter: const std::string& textureFileName - The texture name
+		Returns: unsigned int - The index of the texture name
+		*/
+		unsigned int getTextureIndex(const std::string&);
+		/*
+		Get the index of a texture not loaded by the texture cache in this
+		batch, adding it if necessary
+		Parameter: GLuint texture - The OpenGL texture
+		Returns: unsigned int - The index of the texture
+		*/
+		unsigned int getTextureIndex(GLuint);
+		/*
+		Reread the regions of this batch's textures and mark the sprites whose
+		textures moved to be re-encoded
+		*/
+		void updateTextureRegions();
+		/*
+		Encode a sprite's vertices from its current state or a quad's vertices
+		from its entry
+		Parameter: unsigned int ID - The ID of the sprite
+		*/
+		void encode(unsigned int);
+		/*
+		Sort the sprites by shader, depth, and OpenGL texture and rebuild the
+		indices and draw commands
+		*/
+		void buildOrder();
+		/*
+		Write data into an OpenGL buffer, orphaning it when it must grow or
+		when most of it is being replaced
+		Parameter: GLenum target - The buffer's binding target
+		Parameter: const void* data - The buffer's full contents
+		Parameter: size_t size - The size of the data in bytes
+		Parameter: size_t& capacity - The buffer's capacity in bytes
+		Parameter: size_t first - The first changed byte
+		Parameter: size_t last - One past the last changed byte
+		*/
+		void upload(GLenum, const void*, size_t, size_t&, size_t, size_t);
+	};
+}
+
+#endif
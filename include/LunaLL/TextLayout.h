@@ -0,0 +1,253 @@
+/*
+File:		TextLayout.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@16:05
+Purpose:	Contains the cache of text laid out into glyph quads and the text
+			blocks which draw laid out text through a sprite batch
+*/
+
+#ifndef LUNALL_TEXT_LAYOUT_H
+#define LUNALL_TEXT_LAYOUT_H
+
+#include "GlyphAtlas.h"
+#include "SpriteBatch.h"
+
+#include <string_view>
+
+namespace LunaLL {
+	// The box of a single glyph of laid out text and its place in its atlas
+	struct TextQuad {
+		// The position and dimensions of the glyph (x, y, width, height)
+		glm::vec4 box = glm::vec4();
+		// The texture coordinates of the glyph in its atlas
+		glm::vec4 textureBox = glm::vec4();
+	};
+
+	// Statistics on the lookups in a text layout cache
+	struct TextLayoutStatistics {
+		// The number of layouts in the cache
+		size_t layoutCount = 0;
+		// The number of lookups which reused a cached layout
+		size_t hits = 0;
+		// The number of lookups which laid out their text
+		size_t misses = 0;
+		// The number of glyph quads laid out
+		size_t glyphsLaidOut = 0;
+	};
+
+	// A set of laid out text reused across frames, keyed by the atlas, text,
+	// box, scale, and alignment it was laid out with
+	class TextLayoutCache {
+	public:
+		/*
+		Initialize this cache's memory
+		Parameter: unsigned int retainedFrames - The number of updates a layout
+		is kept for after its last use
+		*/
+		void initialize(unsigned int = 60);
+		/*
+		Get the glyph quads of text laid out inside a box, laying it out if it
+		is not in this cache, lines break only at newline characters
+		Parameter: const GlyphAtlas& atlas - The atlas of the text's font
+		Parameter: const std::string& text - The text to lay out
+		Parameter: const glm::vec4& box - The box to lay the text out in (x, y,
+		width, height)
+		Parameter: float scale - The scale of the text relative to the atlas's
+		pixel size
+		Parameter: ActiasFW::Alignment horizontalAlignment - The horizontal
+		alignment of each line in the box, NO_ALIGNMENT aligns to the left
+		Parameter: ActiasFW::Alignment verticalAlignment - The vertical
+		alignment of the text in the box, NO_ALIGNMENT aligns to the bottom
+		Returns: const std::vector<TextQuad>& - The quads of the text's visible
+		glyphs, valid until the next update
+		*/
+		const std::vector<TextQuad>& getLayout(const GlyphAtlas&,
+			const std::string&, const glm::vec4&, float, ActiasFW::Alignment,
+			ActiasFW::Alignment);
+		/*
+		Advance this cache by one frame, removing the layouts which have not
+		been used for the retained number of frames once every retained number
+		of frames
+		*/
+		void update();
+		/*
+		Get statistics on this cache's lookups
+		Returns: const TextLayoutStatistics& - This cache's statistics
+		*/
+		const TextLayoutStatistics& getStatistics() const;
+		/*
+		Free this cache's memory
+		*/
+		void destroy();
+		/*
+		Lay out text inside a box without caching it
+		Parameter: const GlyphAtlas& atlas - The atlas of the text's font
+		Parameter: std::string_view text - The text to lay out
+		Parameter: const glm::vec4& box - The box to lay the text out in
+		Parameter: float scale - The scale of the text
+		Parameter: ActiasFW::Alignment horizontalAlignment - The horizontal
+		alignment of each line in the box
+		Parameter: ActiasFW::Alignment verticalAlignment - The vertical
+		alignment of the text in the box
+		Parameter: std::vector<TextQuad>& quads - Populated with the quads of
+		the text's visible glyphs
+		*/
+		static void layout(const GlyphAtlas&, std::string_view,
+			const glm::vec4&, float, ActiasFW::Alignment, ActiasFW::Alignment,
+			std::vector<TextQuad>&);
+
+	private:
+		// The parameters text was laid out with
+		template <typename S>
+		struct BasicKey {
+			// The atlas of the text's font
+			const GlyphAtlas* atlas = 0;
+			// The text
+			S text = S();
+			// The box the text was laid out in
+			glm::vec4 box = glm::vec4();
+			// The scale of the text
+			float scale = 0.0f;
+			// The horizontal alignment of the text
+			ActiasFW::Alignment horizontalAlignment = ActiasFW::NO_ALIGNMENT;
+			// The vertical alignment of the text
+			ActiasFW::Alignment verticalAlignment = ActiasFW::NO_ALIGNMENT;
+		};
+		// The key of a cached layout, owning its text
+		typedef BasicKey<std::string> Key;
+		// A key used to find a layout without copying its text
+		typedef BasicKey<std::string_view> KeyView;
+
+		// Hashes keys and key views alike so views can find layouts
+		struct KeyHash {
+			typedef void is_transparent;
+			template <typename S>
+			size_t operator () (const BasicKey<S>& key) const {
+				size_t hash = std::hash<std::string_view>()(key.text);
+				const auto combine = [&hash](size_t value) {
+					hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6)
+						+ (hash >> 2);
+				};
+				combine(std::hash<const void*>()(key.atlas));
+				for (int i = 0; i < 4; i++) {
+					combine(std::hash<float>()(key.box[i]));
+				}
+				combine(std::hash<float>()(key.scale));
+				combine((size_t)key.horizontalAlignment << 8
+					| (size_t)key.verticalAlignment);
+				return hash;
+			}
+		};
+
+		// Compares keys and key views alike
+		struct KeyEqual {
+			typedef void is_transparent;
+			template <typename A, typename B>
+			bool operator () (const BasicKey<A>& a, const BasicKey<B>& b)
+				const {
+				return a.atlas == b.atlas && a.box == b.box
+					&& a.scale == b.scale
+					&& a.horizontalAlignment == b.horizontalAlignment
+					&& a.verticalAlignment == b.verticalAlignment
+					&& std::string_view(a.text) == std::string_view(b.text);
+			}
+		};
+
+		// Text laid out into glyph quads
+		struct Layout {
+			// The quads of the text's visible glyphs
+			std::vector<TextQuad> quads;
+			// The frame this layout was last used in
+			unsigned int lastUsed = 0;
+		};
+
+		// The cached layouts by their keys
+		std::unordered_map<Key, Layout, KeyHash, KeyEqual> m_layouts;
+		// The number of updates a layout is kept for after its last use
+		unsigned int m_retainedFrames = 0;
+		// The number of updates since this cache was initialized
+		unsigned int m_frame = 0;
+		// Statistics on this cache's lookups
+		TextLayoutStatistics m_statistics;
+	};
+
+	// Text drawn through a sprite batch as one quad per glyph, which updates
+	// its quads only when its text or appearance changes and keeps the quads
+	// of its longest text until it is destroyed
+	class TextBlock {
+	public:
+		/*
+		Initialize this text block's memory
+		Parameter: SpriteBatch& batch - The batch to draw the text with
+		Parameter: TextLayoutCache& layouts - The cache to lay the text out
+		with
+		Parameter: ActiasFW::GLSLShader& shader - The shader to draw the text
+		with
+		*/
+		void initialize(SpriteBatch&, TextLayoutCache&, ActiasFW::GLSLShader&);
+		/*
+		Set the text of this block and how to draw it, updating the block's
+		quads in its batch only if anything changed
+		Parameter: const std::string& text - The text to draw
+		Parameter: const glm::vec4& box - The box to draw the text inside of
+		(x, y, width, height)
+		Parameter: float depth - The depth to draw the text at
+		Parameter: float scale - The scale of the text relative to the atlas's
+		pixel size
+		Parameter: const glm::vec4& color - The color of the text (RGBA)
+		Parameter: const GlyphAtlas& atlas - The atlas of the text's font
+		Parameter: ActiasFW::Alignment horizontalAlignment - The horizontal
+		alignment of the text in its box
+		Parameter: ActiasFW::Alignment verticalAlignment - The vertical
+		alignment of the text in its box
+		*/
+		void set(const std::string&, const glm::vec4&, float, float,
+			const glm::vec4&, const GlyphAtlas&, ActiasFW::Alignment,
+			ActiasFW::Alignment);
+		/*
+		Remove this block's quads from its batch and free its memory
+		*/
+		void destroy();
+		/*
+		Get the text of this block
+		Returns: const std::string& - This block's text
+		*/
+		const std::string& getText() const;
+		/*
+		Get the number of visible glyph quads this block has in its batch
+		Returns: size_t - The number of glyphs
+		*/
+		size_t getGlyphCount() const;
+
+	private:
+		// The batch drawing this block's text
+		SpriteBatch* m_batch = 0;
+		// The cache laying out this block's text
+		TextLayoutCache* m_layouts = 0;
+		// The shader drawing this block's text
+		ActiasFW::GLSLShader* m_shader = 0;
+		// The IDs of this block's glyph quads in its batch, including quads
+		// hidden since its text shrank
+		std::vector<unsigned int> m_IDs;
+		// The number of visible glyph quads
+		size_t m_glyphCount = 0;
+		// The text of this block
+		std::string m_text = "";
+		// The box this block's text is drawn in
+		glm::vec4 m_box = glm::vec4();
+		// The depth this block's text is drawn at
+		float m_depth = 0.0f;
+		// The scale of this block's text
+		float m_scale = 0.0f;
+		// The color of this block's text
+		glm::vec4 m_color = glm::vec4();
+		// The atlas of this block's font
+		const GlyphAtlas* m_atlas = 0;
+		// The horizontal alignment of this block's text
+		ActiasFW::Alignment m_horizontalAlignment = ActiasFW::NO_ALIGNMENT;
+		// The vertical alignment of this block's text
+		ActiasFW::Alignment m_verticalAlignment = ActiasFW::NO_ALIGNMENT;
+	};
+}
+
+#endif
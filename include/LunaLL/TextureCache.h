@@ -0,0 +1,270 @@
+/*
+File:		TextureCache.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@11:05
+Purpose:	Contains the cache of OpenGL textures decoded from PNG files used
+			by LunaLL's renderers
+*/
+
+#ifndef LUNALL_TEXTURE_CACHE_H
+#define LUNALL_TEXTURE_CACHE_H
+
+#include "AtlasPacker.h"
+
+#include <GL/glew.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace LunaLL {
+	// The area of an OpenGL texture holding an image loaded by a texture cache
+	struct TextureRegion {
+		// The OpenGL texture holding the image, the placeholder texture until
+		// the image is loaded
+		GLuint texture = 0;
+		// The texture coordinates of the image in the texture
+		glm::vec4 box = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+		// Whether the image has been loaded
+		bool loaded = false;
+	};
+
+	// Settings of a texture cache's background loading and atlasing
+	struct TextureCacheConfiguration {
+		// The number of threads decoding textures, 0 to use one less than the
+		// number of hardware threads
+		unsigned int decodeThreadCount = 0;
+		// Whether to pack small textures into shared atlas pages
+		bool atlasing = true;
+		// The width and height of each atlas page in pixels
+		unsigned int atlasPageSize = 2048;
+		// The largest width or height of a texture packed into an atlas page
+		unsigned int maximumAtlasedSize = 256;
+		// The directory to save packed atlas pages in and load them from on
+		// the next run, or empty to disable the disk cache
+		std::string cacheDirectory = "";
+	};
+
+	// Measurements of a texture cache's background loading and atlasing
+	struct TextureCacheMetrics {
+		// The number of textures decoded in the background
+		size_t texturesDecoded = 0;
+		// The total time spent decoding textures across all threads
+		double decodeSeconds = 0.0;
+		// The longest time spent decoding a single texture
+		double maximumDecodeSeconds = 0.0;
+		// The number of textures and atlas pages uploaded to OpenGL
+		size_t texturesUploaded = 0;
+		// The total time spent uploading textures on the OpenGL thread
+		double uploadSeconds = 0.0;
+		// The longest time spent uploading a single texture
+		double maximumUploadSeconds = 0.0;
+		// The number of textures and cached atlas pages queued for decoding
+		// but not yet uploaded
+		size_t texturesPending = 0;
+		// The number of textures which could not be decoded
+		size_t failures = 0;
+		// The number of textures packed into atlas pages
+		size_t texturesAtlased = 0;
+		// The number of atlas pages
+		unsigned int atlasPages = 0;
+		// The fraction of the atlas pages' area in use, including padding
+		double atlasOccupancy = 0.0;
+		// The number of atlas pages loaded from the disk cache
+		unsigned int cachedPagesLoaded = 0;
+	};
+
+	// A set of OpenGL textures loaded from PNG files by their file names,
+	// either synchronously or by background decoding threads with small
+	// textures packed into shared atlas pages
+	class TextureCache {
+	public:
+		// The name of the atlas manifest in the disk cache directory
+		static const std::string ATLAS_MANIFEST_FILE_NAME;
+
+		/*
+		Stop this cache's decoding threads if they are still running and free
+		its textures
+		*/
+		~TextureCache();
+		/*
+		Initialize this cache's placeholder texture and decoding threads and
+		load the atlas pages in the disk cache which are still current
+		Parameter: const TextureCacheConfiguration& configuration - The
+		settings of this cache's background loading
+		*/
+		void initialize(const TextureCacheConfiguration&
+			= TextureCacheConfiguration());
+		/*
+		Get an OpenGL texture ID by its file name or attempt to decode it from
+		disk and load it into OpenGL, blocking until it is loaded, textures
+		loaded this way are never packed into an atlas
+		Parameter: const std::string& fileName - The file name of the texture
+		Returns: GLuint - The OpenGL texture ID or 0 if the texture could not be
+		loaded
+		*/
+		GLuint getTexture(const std::string&);
+		/*
+		Get the region of a texture by its file name, queueing it to be decoded
+		in the background if it has not been requested before, the region
+		refers to the placeholder texture until the texture is uploaded in an
+		update, the reference remains valid until this cache is destroyed
+		Parameter: const std::string& fileName - The file name of the texture
+		Returns: const TextureRegion& - The region of the texture
+		*/
+		const TextureRegion& getRegion(const std::string&);
+		/*
+		Upload the textures decoded in the background to OpenGL, must be called
+		on the OpenGL thread once per frame
+		Parameter: double uploadBudget - The time in seconds to spend uploading
+		textures, at least one texture is uploaded per update
+		*/
+		void update(double = 0.002);
+		/*
+		Get whether any requested textures have not been uploaded yet
+		Returns: bool - Whether this cache is still loading
+		*/
+		bool isLoading() const;
+		/*
+		Get a counter incremented whenever a texture region changes, for
+		detecting when regions must be reread
+		Returns: unsigned int - This cache's region generation
+		*/
+		unsigned int getGeneration() const;
+		/*
+		Write this cache's atlas pages and their manifest to the disk cache
+		directory, must be called on the OpenGL thread
+		Returns: bool - Whether the atlas pages were saved
+		*/
+		bool saveAtlasCache();
+		/*
+		Get measurements of this cache's background loading and atlasing
+		Returns: const TextureCacheMetrics& - This cache's metrics
+		*/
+		const TextureCacheMetrics& getMetrics() const;
+		/*
+		Stop this cache's decoding threads, delete all of its textures from
+		OpenGL and free its memory
+		*/
+		void destroy();
+
+	private:
+		// A file to decode in the background
+		struct DecodeRequest {
+			// The file name of the PNG
+			std::string fileName = "";
+			// The atlas page the PNG holds if it is from the disk cache, or -1
+			int page = -1;
+		};
+
+		// A PNG decoded in the background
+		struct DecodedImage {
+			// The request the image was decoded for
+			DecodeRequest request;
+			// The RGBA pixels of the image starting at its bottom row
+			std::vector<unsigned char> pixels;
+			// The width and height of the pixels
+			glm::ivec2 dimensions = glm::ivec2();
+			// Whether the pixels are surrounded by a border of copied edge
+			// pixels for packing into an atlas page
+			bool padded = false;
+			// The time spent decoding the image
+			double decodeSeconds = 0.0;
+			// The lodepng error code, 0 if the image was decoded
+			unsigned int error = 0;
+		};
+
+		// The placement of a texture in an atlas page
+		struct AtlasEntry {
+			// The atlas page holding the texture
+			unsigned int page = 0;
+			// The position and dimensions of the texture in the page in
+			// pixels, excluding padding
+			glm::ivec4 rectangle = glm::ivec4();
+			// The last write time of the texture's file when it was packed
+			int64_t timestamp = 0;
+		};
+
+		// The settings of this cache's background loading
+		TextureCacheConfiguration m_configuration;
+		// The set of textures loaded by OpenGL associated with their file names
+		std::unordered_map<std::string, GLuint> m_textures;
+		// The regions of textures requested for background loading
+		std::unordered_map<std::string, TextureRegion> m_regions;
+		// The textures loaded in the background too large for atlas pages
+		std::vector<GLuint> m_unatlasedTextures;
+		// The OpenGL textures of the atlas pages, 0 for pages not yet loaded
+		std::vector<GLuint> m_pages;
+		// The packer placing textures in the atlas pages
+		AtlasPacker m_packer;
+		// The placements of textures in the atlas pages by their file names
+		std::unordered_map<std::string, AtlasEntry> m_atlasEntries;
+		// The texture shown in place of textures still loading
+		GLuint m_placeholder = 0;
+		// The threads decoding textures
+		std::vector<std::thread> m_threads;
+		// The lock on the request and decoded image queues
+		std::mutex m_mutex;
+		// Signalled when a request is queued or the threads must stop
+		std::condition_variable m_condition;
+		// The files waiting to be decoded
+		std::deque<DecodeRequest> m_requests;
+		// The images waiting to be uploaded
+		std::deque<DecodedImage> m_decoded;
+		// Whether the decoding threads must stop
+		bool m_stopping = false;
+		// Incremented whenever a region changes
+		unsigned int m_generation = 0;
+		// Measurements of this cache's loading and atlasing
+		TextureCacheMetrics m_metrics;
+
+		/*
+		Decode requested files until this cache is destroyed, run by each
+		decoding thread
+		*/
+		void decode();
+		/*
+		Queue a file to be decoded in the background
+		Parameter: const DecodeRequest& request - The file to decode
+		*/
+		void request(const DecodeRequest&);
+		/*
+		Upload a decoded image to OpenGL and point its regions at it
+		Parameter: DecodedImage& image - The image to upload
+		*/
+		void upload(DecodedImage&);
+		/*
+		Upload a decoded image to its own OpenGL texture outside the atlas
+		pages and point its region at it
+		Parameter: const std::string& fileName - The file name of the image
+		Parameter: const DecodedImage& image - The image to upload
+		*/
+		void uploadTexture(const std::string&, const DecodedImage&);
+		/*
+		Point a region at its placement in an atlas page
+		Parameter: TextureRegion& region - The region
+		Parameter: const AtlasEntry& entry - The placement of the texture
+		*/
+		void setRegion(TextureRegion&, const AtlasEntry&);
+		/*
+		Read the atlas manifest in the disk cache and queue its current pages to
+		be decoded
+		*/
+		void loadAtlasCache();
+		/*
+		Create an OpenGL texture from RGBA pixels starting at their bottom row
+		Parameter: const glm::ivec2& dimensions - The width and height of the
+		pixels
+		Parameter: const unsigned char* pixels - The pixels, or 0 to leave the
+		texture's contents undefined
+		Returns: GLuint - The OpenGL texture ID
+		*/
+		static GLuint createTexture(const glm::ivec2&, const unsigned char*);
+	};
+}
+
+#endif
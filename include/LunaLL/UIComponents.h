@@ -0,0 +1,457 @@
+/*
+File:		UIComponents.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@23:45
+Purpose:	Contains the virtualized list box and carousel UI components which
+			keep components only for the values they show
+*/
+
+#ifndef LUNALL_UI_COMPONENTS_H
+#define LUNALL_UI_COMPONENTS_H
+
+#include "UIGroup.h"
+
+namespace LunaLL {
+	// A list box UI component which holds its values as text and draws them
+	// on a fixed set of rows, recycled as the list scrolls, so its cost
+	// depends on the number of values shown rather than the number held
+	class UIListBox : public UIComponent {
+	public:
+		// Event ID number for list box values changed
+		const static unsigned int ValueSetEventID = 0;
+
+		/*
+		Construct a list box outside of any UI group, it cannot be copied or
+		moved since its group's batch holds the addresses of its sprites
+		*/
+		UIListBox() = default;
+		UIListBox(const UIListBox&) = delete;
+		UIListBox& operator = (const UIListBox&) = delete;
+		UIListBox(UIListBox&&) = delete;
+		UIListBox& operator = (UIListBox&&) = delete;
+
+		/*
+		Initialize this list box's memory
+		Parameter: const glm::vec3& position - The normalized position and depth
+		of this list box relative to the window's dimensions
+		Parameter: const glm::vec2& dimensions - The normalized dimensions of
+		this list box relative to the window's dimensions
+		Parameter: const std::string& textureFileName - The file name of the
+		texture for this list box's background
+		Parameter: const std::vector<std::string>& values - The initial set of
+		values in this list box
+		Parameter: unsigned int valueCount - The number of values which appear
+		on the background of this list box
+		Parameter: const std::string& valueTextureFileName - The file name of
+		the texture to appear on the rows of this list box containing two
+		frames left to right for unselected and selected rows
+		Parameter: ActiasFW::Alignment horizontalTextAlignment - The horizontal
+		alignment of the text appearing on this list box's rows
+		Parameter: ActiasFW::Alignment verticalTextAlignment - The vertical
+		alignment of the text appearing on this list box's rows
+		*/
+		void initialize(const glm::vec3&, const glm::vec2&,
+			const std::string&, const std::vector<std::string>&, unsigned int,
+			const std::string&, ActiasFW::Alignment = ActiasFW::ALIGN_LEFT,
+			ActiasFW::Alignment = ActiasFW::ALIGN_CENTER);
+		/*
+		Get the set of values in this list box
+		Returns: const std::vector<std::string>& - This list box's values
+		*/
+		const std::vector<std::string>& getValues() const;
+		/*
+		Replace the values in this list box, clearing its selection and
+		scrolling it to the top
+		Parameter: const std::vector<std::string>& values - The new values
+		*/
+		void setValues(const std::vector<std::string>&);
+		/*
+		Get the value in this list box at a given index or empty string
+		Parameter: unsigned int index - The index of the value to get
+		Returns: std::string - The value at the given index
+		*/
+		std::string getValue(unsigned int) const;
+		/*
+		Get the index of a value in this list box or -1
+		Parameter: const std::string& value - The value to get the index of
+		Returns: int - The index of the value
+		*/
+		int getValueIndex(const std::string&) const;
+		/*
+		Add a value to this list box
+		Parameter: const std::string& value - The value to add
+		Parameter: int index - The index at which to add the value or -1 for the
+		end
+		Returns: bool - Whether the value could be added
+		*/
+		bool addValue(const std::string&, int = -1);
+		/*
+		Remove the first instance of a value from this list box
+		Parameter: const std::string& value - The value to remove
+		Returns: bool - Whether the value was present and could be removed
+		*/
+		bool removeValue(const std::string&);
+		/*
+		Remove the value at a given index in this list box
+		Parameter: unsigned int index - The index of the value to remove
+		Returns: bool - Whether the value was present and could be removed
+		*/
+		bool removeValue(unsigned int);
+		/*
+		Get the currently selected value in this list box or empty string
+		Returns: std::string - This list box's current value
+		*/
+		std::string getCurrentValue() const;
+		/*
+		Set the current value selected in this list box
+		Parameter: const std::string& value - The value to select
+		*/
+		void setCurrentValue(const std::string&);
+		/*
+		Get the index of the currently selected value in this list box or -1
+		Returns: int - The index of this list box's currently selected value
+		*/
+		int getCurrentValueIndex() const;
+		/*
+		Set the index of the currently selected value in this list box
+		Parameter: int index - The index of the value to select, or -1 to
+		select none
+		*/
+		void setCurrentValueIndex(int);
+		/*
+		Get the number of values appearing on the background of this list box
+		Returns: unsigned int - This list box's value count
+		*/
+		unsigned int getValueCount() const;
+		/*
+		Set the number of values appearing on the background of this list box
+		Parameter: unsigned int valueCount - This list box's new value count
+		*/
+		void setValueCount(unsigned int);
+		/*
+		Get the index of the value appearing at the top of this list box
+		Returns: unsigned int - This list box's top index
+		*/
+		unsigned int getTopValueIndex() const;
+		/*
+		Scroll this list box so a value appears at its top, limited so the
+		last page of values fills it
+		Parameter: unsigned int topValueIndex - This list box's new top index
+		*/
+		void setTopValueIndex(unsigned int);
+		/*
+		Get the horizontal alignment of this list box's values' text
+		Returns: ActiasFW::Alignment - This list box's horizontal text
+		alignment
+		*/
+		ActiasFW::Alignment getHorizontalTextAlignment() const;
+		/*
+		Set the horizontal alignment of this list box's values' text
+		Parameter: ActiasFW::Alignment horizontalTextAlignment - This list
+		box's new horizontal text alignment
+		*/
+		void setHorizontalTextAlignment(ActiasFW::Alignment);
+		/*
+		Get the vertical alignment of this list box's values' text
+		Returns: ActiasFW::Alignment - This list box's vertical text alignment
+		*/
+		ActiasFW::Alignment getVerticalTextAlignment() const;
+		/*
+		Set the vertical alignment of this list box's values' text
+		Parameter: ActiasFW::Alignment verticalTextAlignment - This list box's
+		new vertical text alignment
+		*/
+		void setVerticalTextAlignment(ActiasFW::Alignment);
+		/*
+		Get the number of rows this list box has built to show its values
+		Returns: size_t - The number of rows
+		*/
+		size_t getRowCount() const;
+		/*
+		Get the text of a value shown on one of this list box's rows as of its
+		last build
+		Parameter: size_t row - The index of the row from the top
+		Returns: const std::string& - The row's text, empty if the row shows no
+		value
+		*/
+		const std::string& getRowText(size_t) const;
+
+	protected:
+		// A row of a list box showing one of its values
+		struct Row {
+			// The row's background
+			ActiasFW::Sprite sprite;
+			// The ID of the row's background in the group's batch
+			unsigned int spriteID = SpriteBatch::INVALID_ID;
+			// The text of the value shown on the row
+			TextBlock text;
+		};
+
+		// The sprite representing this list box's background
+		ActiasFW::Sprite m_backgroundSprite;
+		// The ID of this list box's background in the group's batch
+		unsigned int m_backgroundID = SpriteBatch::INVALID_ID;
+		// The file name of the texture to apply to this list box's rows
+		std::string m_valueTextureFileName = "";
+		// The set of values contained in this list box
+		std::vector<std::string> m_values;
+		// The rows showing the values from the top index down
+		std::vector<Row> m_rows;
+		// The index of the currently selected value or -1
+		int m_currentValueIndex = -1;
+		// The number of values appearing on the background of this list box
+		unsigned int m_valueCount = 0;
+		// The index of the value appearing at the top of this list box
+		unsigned int m_topValueIndex = 0;
+		// The horizontal alignment of this list box's values' text
+		ActiasFW::Alignment m_horizontalTextAlignment = ActiasFW::NO_ALIGNMENT;
+		// The vertical alignment of this list box's values' text
+		ActiasFW::Alignment m_verticalTextAlignment = ActiasFW::NO_ALIGNMENT;
+
+		/*
+		Rebind this list box's rows to the values from its top index and
+		write their graphics
+		*/
+		virtual void build() override;
+		/*
+		Scroll this list box with the mouse's scroll wheel and select the
+		value clicked on
+		*/
+		virtual void processInput() override;
+		/*
+		Update this list box's logic (not used)
+		Parameter: float - Unused number of frames elapsed since the last update
+		*/
+		virtual void update(float) override;
+		/*
+		Remove this list box's rows and background from its group's batch
+		*/
+		virtual void destroy() override;
+		/*
+		Remove this list box's rows from its group's batch and free them
+		*/
+		void destroyRows();
+	};
+
+	// A carousel UI component showing one of its values at a time between
+	// last and next buttons, which keeps its values indexed so looking one up
+	// does not search them
+	class UICarousel : public UIComponent {
+	public:
+		// Event ID number for carousel values being changed
+		const static unsigned int ValueSetEventID = 0;
+
+		/*
+		Construct a carousel outside of any UI group, it cannot be copied or
+		moved since its group's batch holds the addresses of its sprites
+		*/
+		UICarousel() = default;
+		UICarousel(const UICarousel&) = delete;
+		UICarousel& operator = (const UICarousel&) = delete;
+		UICarousel(UICarousel&&) = delete;
+		UICarousel& operator = (UICarousel&&) = delete;
+
+		/*
+		Initialize this carousel's memory
+		Parameter: const glm::vec3& position - The normalized position and depth
+		of this carousel relative to the window's dimensions
+		Parameter: const glm::vec2& dimensions - The normalized dimensions of
+		this carousel relative to the window's dimensions
+		Parameter: const std::string& textureFileName - The file name of the
+		texture to show on this carousel's background
+		Parameter: const std::vector<std::string>& values - The initial set of
+		values to appear in this carousel, repeated values are ignored
+		Parameter: const std::string& value - The initial value to appear in
+		this carousel
+		Parameter: float buttonWidth - The normalized width of the last and next
+		buttons of this carousel relative to its background
+		Parameter: const std::string& buttonTextureFileName - The file name of
+		the texture to appear on this carousel's last and next buttons
+		containing three frames left to right for unselected, selected, and
+		clicked button states
+		Parameter: ActiasFW::Alignment horizontalTextAlignment - The horizontal
+		alignment of this carousel's value on its background
+		Parameter: ActiasFW::Alignment verticalTextAlignment - The vertical
+		alignment of this carousel's value on its background
+		*/
+		void initialize(const glm::vec3&, const glm::vec2&,
+			const std::string&, const std::vector<std::string>&,
+			const std::string&, float, const std::string&,
+			ActiasFW::Alignment = ActiasFW::ALIGN_CENTER,
+			ActiasFW::Alignment = ActiasFW::ALIGN_CENTER);
+		/*
+		Get the set of values in this carousel
+		Returns: const std::vector<std::string>& - This carousel's values
+		*/
+		const std::vector<std::string>& getValues() const;
+		/*
+		Get the value of this carousel at a given index
+		Parameter: unsigned int index - The index to get
+		Returns: std::string - This carousel's value at the given index or
+		empty string
+		*/
+		std::string getValue(unsigned int) const;
+		/*
+		Get the index of a value in this carousel
+		Parameter: const std::string& value - The value to get the index of
+		Returns: int - The index of the given value or -1
+		*/
+		int getValueIndex(const std::string&) const;
+		/*
+		Add a value to this carousel at a given index
+		Parameter: const std::string& value - The value to add
+		Parameter: int index - The index at which to add the value or -1 for the
+		end
+		Returns: bool - Whether the value was not already present and could be
+		added
+		*/
+		bool addValue(const std::string&, int = -1);
+		/*
+		Remove a value from this carousel
+		Parameter: const std::string& value - The value to remove
+		Returns: bool - Whether the value was present and could be removed
+		*/
+		bool removeValue(const std::string&);
+		/*
+		Remove a value from this carousel by its index
+		Parameter: unsigned int index - The index of the value to remove
+		Returns: bool - Whether the value was present and could be removed
+		*/
+		bool removeValue(unsigned int);
+		/*
+		Remove all values from this carousel
+		*/
+		void clear();
+		/*
+		Get the current value of this carousel
+		Returns: std::string - This carousel's current value or empty string
+		*/
+		std::string getCurrentValue() const;
+		/*
+		Set the current value of this carousel if it is present
+		Parameter: const std::string& value - This carousel's new current value
+		*/
+		void setCurrentValue(const std::string&);
+		/*
+		Get the index of the current value of this carousel
+		Returns: unsigned int - The index of this carousel's current value
+		*/
+		unsigned int getCurrentValueIndex() const;
+		/*
+		Set the index of the current value of this carousel if it is present
+		Parameter: unsigned int index - The new index of this carousel's current
+		value
+		*/
+		void setCurrentValueIndex(unsigned int);
+		/*
+		Get the normalized width of this carousel's buttons relative to its
+		background
+		Returns: float - This carousel's button width
+		*/
+		float getButtonWidth() const;
+		/*
+		Set the normalized width of this carousel's buttons relative to its
+		background
+		Parameter: float buttonWidth - This carousel's new button width
+		*/
+		void setButtonWidth(float);
+		/*
+		Get the horizontal alignment of this carousel's value text on its
+		background
+		Returns: ActiasFW::Alignment - This carousel's horizontal text
+		alignment
+		*/
+		ActiasFW::Alignment getHorizontalTextAlignment() const;
+		/*
+		Set the horizontal alignment of this carousel's value text on its
+		background
+		Parameter: ActiasFW::Alignment horizontalTextAlignment - This
+		carousel's new horizontal text alignment
+		*/
+		void setHorizontalTextAlignment(ActiasFW::Alignment);
+		/*
+		Get the vertical alignment of this carousel's value text on its
+		background
+		Returns: ActiasFW::Alignment - This carousel's vertical text alignment
+		*/
+		ActiasFW::Alignment getVerticalTextAlignment() const;
+		/*
+		Set the vertical alignment of this carousel's value text on its
+		background
+		Parameter: ActiasFW::Alignment verticalTextAlignment - This carousel's
+		new vertical text alignment
+		*/
+		void setVerticalTextAlignment(ActiasFW::Alignment);
+
+	protected:
+		// A last or next button of a carousel
+		struct Button {
+			// The button's background
+			ActiasFW::Sprite sprite;
+			// The ID of the button's background in the group's batch
+			unsigned int spriteID = SpriteBatch::INVALID_ID;
+			// Whether the button is selected (moused over)
+			bool selected = false;
+			// Whether the button is clicked (moused over with the mouse
+			// button down)
+			bool clicked = false;
+		};
+
+		// The sprite representing this carousel's background
+		ActiasFW::Sprite m_backgroundSprite;
+		// The ID of this carousel's background in the group's batch
+		unsigned int m_backgroundID = SpriteBatch::INVALID_ID;
+		// The text of this carousel's current value
+		TextBlock m_text;
+		// The values in this carousel
+		std::vector<std::string> m_values;
+		// The indices of this carousel's values by the values
+		std::unordered_map<std::string, unsigned int> m_valueIndices;
+		// The index of this carousel's current value
+		unsigned int m_currentValueIndex = 0;
+		// This carousel's last value button
+		Button m_lastButton;
+		// This carousel's next value button
+		Button m_nextButton;
+		// The normalized width of this carousel's buttons
+		float m_buttonWidth = 0.0f;
+		// The horizontal alignment of this carousel's value text
+		ActiasFW::Alignment m_horizontalTextAlignment = ActiasFW::NO_ALIGNMENT;
+		// The vertical alignment of this carousel's value text
+		ActiasFW::Alignment m_verticalTextAlignment = ActiasFW::NO_ALIGNMENT;
+
+		/*
+		Write this carousel's background, buttons, and current value
+		*/
+		virtual void build() override;
+		/*
+		Process user input to this carousel's buttons
+		*/
+		virtual void processInput() override;
+		/*
+		Update this carousel's logic (not used)
+		Parameter: float - Unused number of frames elapsed since the last update
+		*/
+		virtual void update(float) override;
+		/*
+		Remove this carousel's graphics from its group's batch
+		*/
+		virtual void destroy() override;
+		/*
+		Process the mouse's input to one of this carousel's buttons
+		Parameter: Button& button - The button
+		Parameter: const glm::vec4& box - The button's box in pixels
+		Parameter: const glm::vec2& cursor - The mouse cursor's position in
+		pixels from the window's bottom left corner
+		Returns: bool - Whether the button was clicked and released
+		*/
+		bool processButton(Button&, const glm::vec4&, const glm::vec2&);
+		/*
+		Update the indices of this carousel's values from an index on
+		Parameter: size_t first - The first index to update
+		*/
+		void reindex(size_t);
+	};
+}
+
+#endif
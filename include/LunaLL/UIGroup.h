@@ -0,0 +1,382 @@
+/*
+File:		UIGroup.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@23:20
+Purpose:	Contains the retained UI components drawn through a sprite batch and
+			the groups which rebuild only the components which changed
+*/
+
+#ifndef LUNALL_UI_GROUP_H
+#define LUNALL_UI_GROUP_H
+
+#include "TextLayout.h"
+
+namespace LunaLL {
+	// Forward declare the UI group class
+	class UIGroup;
+
+	// An abstract receiver of the events triggered by the components of LunaLL
+	// UI groups
+	class UIEventListener {
+	public:
+		/*
+		A component of a UI group has triggered an event
+		Parameter: unsigned int groupID - The ID number of the group
+		Parameter: unsigned int componentID - The ID number of the component
+		Parameter: unsigned int eventID - The ID number of the event type
+		*/
+		virtual void UIEvent(unsigned int, unsigned int, unsigned int) = 0;
+	};
+
+	// Statistics on the most recent build of a UI group
+	struct UIGroupStatistics {
+		// The number of components in the group
+		size_t componentCount = 0;
+		// The number of components rebuilt in the last build
+		size_t componentsBuilt = 0;
+		// The number of sprites and glyphs in the group's batch
+		size_t spriteCount = 0;
+		// The number of sprites and glyphs re-encoded in the last build
+		size_t spritesEncoded = 0;
+	};
+
+	// An abstract UI component which keeps its geometry in its group's sprite
+	// batch and is rebuilt only when it is marked dirty, used in place of the
+	// ActiasFW UI components which resubmit their graphics every frame
+	class UIComponent {
+	public:
+		// The depth between the layers of a component's graphics
+		static constexpr float LAYER_DEPTH = 0.001f;
+
+		/*
+		Allow derived components to be deleted through a UI component pointer
+		*/
+		virtual ~UIComponent() = default;
+		/*
+		Get the UI group which controls this component
+		Returns: UIGroup* - This component's parent, or 0 if it is in no group
+		*/
+		UIGroup* getParent() const;
+		/*
+		Get the ID number of this component in its group
+		Returns: unsigned int - This component's ID
+		*/
+		unsigned int getID() const;
+		/*
+		Test whether this component is enabled
+		Returns: bool - Whether this component is enabled
+		*/
+		bool isEnabled() const;
+		/*
+		Set whether this component is enabled
+		Parameter: bool enabled - Whether this component should be enabled
+		*/
+		virtual void setEnabled(bool);
+		/*
+		Test whether this component is visible
+		Returns: bool - Whether this component is visible
+		*/
+		bool isVisible() const;
+		/*
+		Set whether this component is visible
+		Parameter: bool visible - Whether this component should be visible
+		*/
+		virtual void setVisible(bool);
+		/*
+		Get the normalized position and depth of this component relative to
+		the window's dimensions
+		Returns: const glm::vec3& - This component's position
+		*/
+		const glm::vec3& getPosition() const;
+		/*
+		Set the normalized position and depth of this component relative to
+		the window's dimensions
+		Parameter: const glm::vec3& position - This component's new position
+		*/
+		virtual void setPosition(const glm::vec3&);
+		/*
+		Get the normalized dimensions of this component relative to the
+		window's dimensions
+		Returns: const glm::vec2& - This component's dimensions
+		*/
+		const glm::vec2& getDimensions() const;
+		/*
+		Set the normalized dimensions of this component relative to the
+		window's dimensions
+		Parameter: const glm::vec2& dimensions - This component's new
+		dimensions
+		*/
+		virtual void setDimensions(const glm::vec2&);
+		/*
+		Test whether this component will be rebuilt in its group's next build
+		Returns: bool - Whether this component is dirty
+		*/
+		bool isDirty() const;
+		/*
+		Mark this component to be rebuilt in its group's next build
+		*/
+		void markDirty();
+
+	protected:
+		// Allow the UIGroup class to access protected memory
+		friend class UIGroup;
+		// This component's parent UI group
+		UIGroup* m_parent = 0;
+		// The ID number of this component
+		unsigned int m_ID = 0;
+		// Whether this component is enabled
+		bool m_enabled = true;
+		// Whether this component is visible
+		bool m_visible = true;
+		// The normalized position and depth of this component
+		glm::vec3 m_position = glm::vec3();
+		// The normalized dimensions of this component
+		glm::vec2 m_dimensions = glm::vec2();
+		// Whether this component must be rebuilt in its group's next build
+		bool m_dirty = false;
+
+		/*
+		Get the box this component covers in the window
+		Returns: glm::vec4 - This component's box in pixels (x, y, width,
+		height)
+		*/
+		glm::vec4 getBox() const;
+		/*
+		Add a sprite of this component to its group's batch if it is not
+		already in it
+		Parameter: ActiasFW::Sprite& sprite - The sprite, which must remain in
+		memory until it is removed
+		Parameter: unsigned int& ID - The sprite's ID in the batch, set when it
+		is added
+		*/
+		void addSprite(ActiasFW::Sprite&, unsigned int&);
+		/*
+		Remove a sprite of this component from its group's batch if it is in
+		it
+		Parameter: unsigned int& ID - The sprite's ID in the batch, reset when
+		it is removed
+		*/
+		void removeSprite(unsigned int&);
+		/*
+		Write this component's graphics into its group's sprite batch, only
+		called while it is dirty
+		*/
+		virtual void build() = 0;
+		/*
+		Process user input to this component
+		*/
+		virtual void processInput() = 0;
+		/*
+		Update this component's logic
+		Parameter: float timeStep - The number of frames elapsed since the last
+		update
+		*/
+		virtual void update(float) = 0;
+		/*
+		Remove this component's graphics from its group's sprite batch and
+		free its memory
+		*/
+		virtual void destroy() = 0;
+	};
+
+	// A group of retained UI components drawn through one sprite batch, which
+	// tracks the components whose state changed and rebuilds only their
+	// geometry before drawing
+	class UIGroup {
+	public:
+		/*
+		Initialize this UI group's memory
+		Parameter: TextureCache& textures - The cache to load the components'
+		textures from
+		Parameter: const GlyphAtlas& atlas - The atlas of the font to draw text
+		on the components with
+		Parameter: ActiasFW::GLSLShader& shader - The shader to draw the
+		components with, initialized with the sprite batch's vertex attributes
+		Parameter: float textScale - The scale of the components' text relative
+		to the atlas's pixel size
+		Parameter: const glm::vec4& textColor - The color of the components'
+		text
+		Parameter: UIEventListener* listener - The listener to pass the
+		components' events to, or 0
+		Parameter: unsigned int ID - The ID number of this group
+		Returns: bool - Whether this group was not already initialized
+		*/
+		bool initialize(TextureCache&, const GlyphAtlas&, ActiasFW::GLSLShader&,
+			float, const glm::vec4&, UIEventListener* = 0, unsigned int = 0);
+		/*
+		Add a component to this group and mark it dirty, the component must
+		remain in memory until it is removed
+		Parameter: UIComponent& component - The component to add
+		Returns: bool - Whether the component was in no group and was added
+		*/
+		bool addComponent(UIComponent&);
+		/*
+		Remove a component from this group and destroy it
+		Parameter: UIComponent& component - The component to remove
+		Returns: bool - Whether the component was in this group and was removed
+		*/
+		bool removeComponent(UIComponent&);
+		/*
+		Process user input to the enabled, visible components of this group if
+		it is enabled and visible
+		*/
+		void processInput();
+		/*
+		Update the logic of the components in this group, marking all of them
+		dirty if the window was resized
+		Parameter: float timeStep - The number of frames elapsed since the last
+		update
+		*/
+		void update(float);
+		/*
+		Rebuild the components of this group which are dirty and re-encode
+		their changed geometry, uses no OpenGL calls, a component which marks
+		itself dirty while building is built again in the next build
+		*/
+		void build();
+		/*
+		Build this group and draw its batch if it is visible
+		*/
+		void draw();
+		/*
+		A component in this group has triggered an event, pass it to this
+		group's listener
+		Parameter: unsigned int componentID - The ID number of the component
+		Parameter: unsigned int eventID - The ID number of the event type
+		*/
+		void UIEvent(unsigned int, unsigned int);
+		/*
+		Destroy all the components in this group and free its memory
+		Returns: bool - Whether this group was initialized
+		*/
+		bool destroy();
+		/*
+		Get the ID number of this group
+		Returns: unsigned int - This group's ID
+		*/
+		unsigned int getID() const;
+		/*
+		Test whether this group's components are enabled
+		Returns: bool - Whether this group is enabled
+		*/
+		bool isEnabled() const;
+		/*
+		Set whether this group's components are enabled
+		Parameter: bool enabled - Whether to enable this group
+		*/
+		void setEnabled(bool);
+		/*
+		Test whether this group's components are visible
+		Returns: bool - Whether this group is visible
+		*/
+		bool isVisible() const;
+		/*
+		Set whether this group's components are visible
+		Parameter: bool visible - Whether to make this group visible
+		*/
+		void setVisible(bool);
+		/*
+		Get the dimensions of the window this group's components are placed in
+		Returns: const glm::ivec2& - The window's dimensions in pixels
+		*/
+		const glm::ivec2& getWindowDimensions() const;
+		/*
+		Set the dimensions of the window this group's components are placed
+		in, marking all of them dirty if they changed
+		Parameter: const glm::ivec2& windowDimensions - The window's dimensions
+		in pixels
+		*/
+		void setWindowDimensions(const glm::ivec2&);
+		/*
+		Get the atlas of the font text is drawn with on this group's
+		components
+		Returns: const GlyphAtlas& - This group's glyph atlas
+		*/
+		const GlyphAtlas& getAtlas() const;
+		/*
+		Get the shader this group's components are drawn with
+		Returns: ActiasFW::GLSLShader& - This group's shader
+		*/
+		ActiasFW::GLSLShader& getShader();
+		/*
+		Get the scale of the text on this group's components
+		Returns: float - This group's text scale
+		*/
+		float getTextScale() const;
+		/*
+		Set the scale of the text on this group's components, marking all of
+		them dirty
+		Parameter: float textScale - This group's new text scale
+		*/
+		void setTextScale(float);
+		/*
+		Get the color of the text on this group's components
+		Returns: const glm::vec4& - This group's text color
+		*/
+		const glm::vec4& getTextColor() const;
+		/*
+		Set the color of the text on this group's components, marking all of
+		them dirty
+		Parameter: const glm::vec4& textColor - This group's new text color
+		*/
+		void setTextColor(const glm::vec4&);
+		/*
+		Get the sprite batch holding this group's geometry
+		Returns: SpriteBatch& - This group's batch
+		*/
+		SpriteBatch& getBatch();
+		/*
+		Get the cache laying out the text on this group's components
+		Returns: TextLayoutCache& - This group's layout cache
+		*/
+		TextLayoutCache& getLayouts();
+		/*
+		Get statistics on this group's most recent build
+		Returns: const UIGroupStatistics& - This group's statistics
+		*/
+		const UIGroupStatistics& getStatistics() const;
+
+	private:
+		// Allow the UIComponent class to queue itself to be rebuilt
+		friend class UIComponent;
+		// Whether this group has been initialized
+		bool m_initialized = false;
+		// This group's ID number
+		unsigned int m_ID = 0;
+		// The listener to pass the components' events to
+		UIEventListener* m_listener = 0;
+		// The components in this group
+		std::vector<UIComponent*> m_components;
+		// The components to rebuild in the next build
+		std::vector<UIComponent*> m_dirtyComponents;
+		// The next ID to assign to an added component
+		unsigned int m_nextID = 0;
+		// The batch holding the components' geometry
+		SpriteBatch m_batch;
+		// The cache laying out the components' text
+		TextLayoutCache m_layouts;
+		// The atlas of the components' font
+		const GlyphAtlas* m_atlas = 0;
+		// The shader drawing the components
+		ActiasFW::GLSLShader* m_shader = 0;
+		// The scale of the components' text
+		float m_textScale = 0.0f;
+		// The color of the components' text
+		glm::vec4 m_textColor = glm::vec4();
+		// Whether this group's components are enabled
+		bool m_enabled = false;
+		// Whether this group's components are visible
+		bool m_visible = false;
+		// The dimensions of the window the components are placed in
+		glm::ivec2 m_windowDimensions = glm::ivec2();
+		// Statistics on this group's most recent build
+		UIGroupStatistics m_statistics;
+
+		/*
+		Mark every component in this group dirty
+		*/
+		void markAllDirty();
+	};
+}
+
+#endif
@@ -0,0 +1,34 @@
+/*
+File:		Viewport.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@09:20
+Purpose:	Contains utilities for finding the region of the world visible
+			through an ActiasFW camera
+*/
+
+#ifndef LUNALL_VIEWPORT_H
+#define LUNALL_VIEWPORT_H
+
+#include <ActiasFW/Graphics.h>
+
+namespace LunaLL {
+	/*
+	Get the box in world coordinates visible through a camera's projection
+	matrix
+	Parameter: const ActiasFW::Camera& camera - The camera to test
+	Returns: glm::vec4 - The visible box (x, y, width, height)
+	*/
+	glm::vec4 getVisibleBox(const ActiasFW::Camera&);
+	/*
+	Test whether two boxes overlap
+	Parameter: const glm::vec4& a - The first box (x, y, width, height)
+	Parameter: const glm::vec4& b - The second box (x, y, width, height)
+	Returns: bool - Whether the boxes overlap
+	*/
+	inline bool boxesOverlap(const glm::vec4& a, const glm::vec4& b) {
+		return a.x < b.x + b.z && b.x < a.x + a.z
+			&& a.y < b.y + b.w && b.y < a.y + a.w;
+	}
+}
+
+#endif
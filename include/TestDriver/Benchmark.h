@@ -0,0 +1,214 @@
+/*
+File:		Benchmark.h
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@10:02
+Purpose:	Contains the timing and reporting utilities shared by the
+			TestDriver benchmarks and the benchmarks' entry points
+*/
+
+#ifndef TESTDRIVER_BENCHMARK_H
+#define TESTDRIVER_BENCHMARK_H
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace TestDriver {
+	// A stopwatch measuring elapsed wall clock time
+	class Timer {
+	public:
+		/*
+		Construct a timer and start it
+		*/
+		Timer();
+		/*
+		Restart this timer from zero
+		*/
+		void restart();
+		/*
+		Get the time elapsed since this timer was started
+		Returns: double - The elapsed time in seconds
+		*/
+		double getSeconds() const;
+		/*
+		Get the time elapsed since this timer was started
+		Returns: double - The elapsed time in milliseconds
+		*/
+		double getMilliseconds() const;
+
+	private:
+		// The time this timer was started
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+	/*
+	Get the largest amount of physical memory used by this process so far
+	Returns: size_t - The peak resident set size in bytes
+	*/
+	size_t getPeakResidentMemory();
+	/*
+	Get a percentile of a set of samples
+	Parameter: std::vector<double> samples - The samples to test
+	Parameter: double percentile - The percentile between 0.0 and 100.0
+	Returns: double - The sample at the percentile or 0.0 if there are none
+	*/
+	double getPercentile(std::vector<double>, double);
+	/*
+	Write a named benchmark result to the console
+	Parameter: const std::string& name - The name of the result
+	Parameter: double value - The measured value
+	Parameter: const std::string& unit - The unit of the value
+	*/
+	void report(const std::string&, double, const std::string&);
+	/*
+	Get a benchmark argument by its position or a default if it is absent
+	Parameter: const std::vector<std::string>& arguments - The arguments
+	Parameter: size_t index - The position of the argument
+	Parameter: const std::string& defaultValue - The value used when the
+	argument is absent
+	Returns: std::string - The argument
+	*/
+	std::string getArgument(const std::vector<std::string>&, size_t,
+		const std::string&);
+	/*
+	Create a hidden window to give benchmarks which use OpenGL a current
+	context
+	Returns: bool - Whether the context was created
+	*/
+	bool createHiddenContext();
+	/*
+	Destroy the hidden window created for benchmarks which use OpenGL
+	*/
+	void destroyHiddenContext();
+
+	// Destroys the hidden OpenGL context when a benchmark returns, declared
+	// before the objects which use the context so they are destroyed first
+	class HiddenContextGuard {
+	public:
+		HiddenContextGuard() = default;
+		HiddenContextGuard(const HiddenContextGuard&) = delete;
+		HiddenContextGuard& operator = (const HiddenContextGuard&) = delete;
+		/*
+		Destroy the hidden OpenGL context
+		*/
+		~HiddenContextGuard();
+	};
+
+	// Removes a benchmark's generated files when the benchmark returns
+	class DirectoryRemover {
+	public:
+		/*
+		Set the directory to remove
+		Parameter: const std::filesystem::path& directory - The directory
+		*/
+		DirectoryRemover(const std::filesystem::path&);
+		DirectoryRemover(const DirectoryRemover&) = delete;
+		DirectoryRemover& operator = (const DirectoryRemover&) = delete;
+		/*
+		Remove the directory and everything in it
+		*/
+		~DirectoryRemover();
+
+	private:
+		// The directory to remove
+		std::filesystem::path m_directory;
+	};
+
+	/*
+	Measure decoding sound effects and music on the game thread against
+	loading an effect bank in the background and streaming music, and check
+	effect voice limits and the memory freed by unloading the bank
+	Parameter: const std::vector<std::string>& arguments - [effect count]
+	[music length in seconds]
+	Returns: int - The process exit code
+	*/
+	int runAudioBenchmark(const std::vector<std::string>&);
+	/*
+	Measure updating animated entities through their virtual updates and in
+	an entity store on the job system from one thread up to a maximum number
+	of threads, and check every thread count gives the same results
+	Parameter: const std::vector<std::string>& arguments - [entity count]
+	[update count] [maximum thread count]
+	Returns: int - The process exit code
+	*/
+	int runJobBenchmark(const std::vector<std::string>&);
+	/*
+	Measure opening, per chunk decoding, and streaming a large generated
+	level in the binary level format
+	Parameter: const std::vector<std::string>& arguments - [level file name]
+	[width in tiles] [height in tiles]
+	Returns: int - The process exit code
+	*/
+	int runLevelBenchmark(const std::vector<std::string>&);
+	/*
+	Measure the caller's cost of the asynchronous log against the synchronous
+	ActiasFW log, its throughput and drops from several threads, the cost of
+	a disabled level, and writing and decoding a binary log
+	Parameter: const std::vector<std::string>& arguments - [record count]
+	Returns: int - The process exit code
+	*/
+	int runLogBenchmark(const std::vector<std::string>&);
+	/*
+	Decode a binary log file written by the asynchronous log to the console
+	Parameter: const std::vector<std::string>& arguments - <binary log file
+	name>
+	Returns: int - The process exit code
+	*/
+	int runLogDecoder(const std::vector<std::string>&);
+	/*
+	Measure the CPU side of building a retained sprite batch against
+	rebuilding every sprite's vertices each frame
+	Parameter: const std::vector<std::string>& arguments - [sprite count]
+	[frame count]
+	Returns: int - The process exit code
+	*/
+	int runBatchBenchmark(const std::vector<std::string>&);
+	/*
+	Check a scripted editing session captured by an input recorder is
+	unchanged after saving and loading it, then replay a recorded session
+	headlessly through a profiled scene twice, reporting frame and zone time
+	percentiles, writing a Chrome trace, and checking both replays end in the
+	same state
+	Parameter: const std::vector<std::string>& arguments - [recording file
+	name, recorded and saved if it does not exist] [scripted frame count]
+	Returns: int - The process exit code
+	*/
+	int runReplayBenchmark(const std::vector<std::string>&);
+	/*
+	Measure spatial index queries and updates against brute force searches
+	from 1,000 entities up to a maximum count
+	Parameter: const std::vector<std::string>& arguments - [maximum entity
+	count]
+	Returns: int - The process exit code
+	*/
+	int runSpatialBenchmark(const std::vector<std::string>&);
+	/*
+	Measure the glyph throughput of static and changing text drawn as text
+	blocks in a sprite batch against copying a glyph sprite per character
+	each frame
+	Parameter: const std::vector<std::string>& arguments - [font file name]
+	[row count] [frame count]
+	Returns: int - The process exit code
+	*/
+	int runTextBenchmark(const std::vector<std::string>&);
+	/*
+	Measure loading generated textures synchronously against decoding them in
+	the background and packing them into atlas pages, cold and from the atlas
+	disk cache
+	Parameter: const std::vector<std::string>& arguments - [texture count]
+	Returns: int - The process exit code
+	*/
+	int runTextureBenchmark(const std::vector<std::string>&);
+	/*
+	Measure scrolling a large list box at 60 Hz with a row for every value
+	against a virtualized list box beside unchanging carousels in a dirty
+	tracked UI group, rebuilding only the dirty components and every one
+	Parameter: const std::vector<std::string>& arguments - [value count]
+	[frame count] [row count] [font file name]
+	Returns: int - The process exit code
+	*/
+	int runUIBenchmark(const std::vector<std::string>&);
+}
+
+#endif
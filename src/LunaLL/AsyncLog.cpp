@@ -0,0 +1,621 @@
+/*
+File:		AsyncLog.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@17:10
+Purpose:	Implementation of the asynchronous log manager and its binary log
+			decoder
+*/
+
+#include "AsyncLog.h"
+
+#include <ActiasFW/ActiasFW.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iterator>
+
+using ActiasFW::Application;
+
+namespace LunaLL {
+	namespace {
+		// The names of the log levels as written in records
+		const char* const LEVEL_NAMES[] = {
+			"Trace",
+			"Debug",
+			"Info",
+			"Warning",
+			"Error",
+			"Fatal",
+		};
+
+		// The types of entries in a binary log file
+		enum BinaryEntry : uint8_t {
+			BINARY_SOURCE = 1,
+			BINARY_RECORD = 2,
+			BINARY_DROPPED = 3,
+		};
+
+		// The space records are encoded in while the log is not running
+		thread_local std::vector<uint8_t> scratchBuffer;
+		// The lock on writing records through the ActiasFW application's log
+		std::mutex fallbackMutex;
+		// The second of the date last formatted on this thread
+		thread_local std::time_t formattedSecond = -1;
+		// The date last formatted on this thread
+		thread_local char formattedDate[32] = "";
+		// The length of the date last formatted on this thread
+		thread_local size_t formattedDateLength = 0;
+
+		/*
+		Append a value's bytes to a string
+		Parameter: std::string& output - The string
+		Parameter: const T& value - The value
+		*/
+		template <typename T>
+		void append(std::string& output, const T& value) {
+			output.append((const char*)&value, sizeof(value));
+		}
+
+		/*
+		Read a value's bytes from a buffer
+		Parameter: const uint8_t*& input - The position to read from, advanced
+		past the value
+		Parameter: const uint8_t* end - The end of the buffer
+		Parameter: T& value - Set to the value
+		Returns: bool - Whether the buffer held the whole value
+		*/
+		template <typename T>
+		bool read(const uint8_t*& input, const uint8_t* end, T& value) {
+			if ((size_t)(end - input) < sizeof(value)) {
+				return false;
+			}
+			std::memcpy(&value, input, sizeof(value));
+			input += sizeof(value);
+			return true;
+		}
+
+		/*
+		Get the name of a log level
+		Parameter: uint8_t level - The level
+		Returns: const char* - The level's name
+		*/
+		const char* getLevelName(uint8_t level) {
+			return level < LOG_NONE ? LEVEL_NAMES[level] : "Unknown";
+		}
+	}
+
+	AsyncLogManager AsyncLogManager::Log;
+	const std::string AsyncLogManager::BINARY_LOG_MAGIC = "LLOG";
+
+	AsyncLogManager::~AsyncLogManager() {
+		destroy();
+	}
+
+	bool AsyncLogManager::initialize(const LogConfiguration& configuration) {
+		destroy();
+		m_configuration = configuration;
+		size_t capacity = 1024;
+		while (capacity < m_configuration.threadBufferSize) {
+			capacity *= 2;
+		}
+		m_configuration.threadBufferSize = capacity;
+
+		bool opened = true;
+		for (const std::string& fileName : m_configuration.textFileNames) {
+			m_textFiles.emplace_back(fileName, std::ios::app);
+			opened = opened && m_textFiles.back().good();
+		}
+		if (!m_configuration.binaryFileName.empty()) {
+			m_binaryFile.open(m_configuration.binaryFileName,
+				std::ios::binary | std::ios::trunc);
+			std::string header = BINARY_LOG_MAGIC;
+			append(header, BINARY_LOG_VERSION);
+			m_binaryFile.write(header.data(), header.size());
+			opened = opened && m_binaryFile.good();
+		}
+
+		m_level.store(m_configuration.level, std::memory_order_relaxed);
+		m_recordsWritten = 0;
+		m_recordsDropped = 0;
+		m_batchesWritten = 0;
+		m_unbufferedDropped = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_flushesRequested = 0;
+			m_flushesCompleted = 0;
+			m_generation.fetch_add(1, std::memory_order_acq_rel);
+			m_running.store(true, std::memory_order_release);
+		}
+		m_thread = std::thread(&AsyncLogManager::run, this);
+		return opened;
+	}
+
+	void AsyncLogManager::setLevel(LogLevel level) {
+		m_level.store(level, std::memory_order_relaxed);
+	}
+
+	LogLevel AsyncLogManager::getLevel() const {
+		return (LogLevel)m_level.load(std::memory_order_relaxed);
+	}
+
+	void AsyncLogManager::flush() {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (!m_running.load(std::memory_order_relaxed)) {
+			return;
+		}
+		const uint64_t flush = ++m_flushesRequested;
+		m_wake.notify_one();
+		m_flushed.wait(lock, [this, flush]() {
+			return m_flushesCompleted >= flush;
+		});
+	}
+
+	LogStatistics AsyncLogManager::getStatistics() const {
+		LogStatistics statistics;
+		statistics.recordsWritten = m_recordsWritten.load(
+			std::memory_order_relaxed);
+		statistics.recordsDropped = m_recordsDropped.load(
+			std::memory_order_relaxed);
+		statistics.batchesWritten = m_batchesWritten.load(
+			std::memory_order_relaxed);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		statistics.threadBufferCount = (unsigned int)m_buffers.size();
+		return statistics;
+	}
+
+	void AsyncLogManager::destroy() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_running.load(std::memory_order_relaxed)) {
+				return;
+			}
+			m_running.store(false, std::memory_order_release);
+		}
+		m_wake.notify_one();
+		m_thread.join();
+		m_textFiles.clear();
+		m_binaryFile.close();
+		m_binaryFile.clear();
+		m_binarySources.clear();
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_buffers.clear();
+		m_threadCount = 0;
+	}
+
+	bool AsyncLogManager::decode(const std::string& fileName,
+		std::ostream& output) {
+		std::ifstream file(fileName, std::ios::binary);
+		if (!file.good()) {
+			return false;
+		}
+		const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)),
+			std::istreambuf_iterator<char>());
+		const uint8_t* input = data.data();
+		const uint8_t* const end = input + data.size();
+		uint32_t version = 0;
+		if (data.size() < BINARY_LOG_MAGIC.size() || std::memcmp(input,
+			BINARY_LOG_MAGIC.data(), BINARY_LOG_MAGIC.size()) != 0) {
+			return false;
+		}
+		input += BINARY_LOG_MAGIC.size();
+		if (!read(input, end, version) || version != BINARY_LOG_VERSION) {
+			return false;
+		}
+
+		std::vector<std::string> sources;
+		std::string text;
+		while (input < end) {
+			const uint8_t entry = *input++;
+			text.clear();
+			if (entry == BINARY_SOURCE) {
+				uint16_t ID = 0;
+				uint16_t size = 0;
+				if (!read(input, end, ID) || !read(input, end, size)
+					|| (size_t)(end - input) < size) {
+					return false;
+				}
+				if (ID >= sources.size()) {
+					sources.resize((size_t)ID + 1);
+				}
+				sources[ID].assign((const char*)input, size);
+				input += size;
+			}
+			else if (entry == BINARY_RECORD) {
+				int64_t timestamp = 0;
+				uint16_t source = 0;
+				uint8_t level = 0;
+				uint32_t thread = 0;
+				uint32_t size = 0;
+				if (!read(input, end, timestamp) || !read(input, end, source)
+					|| !read(input, end, level) || !read(input, end, thread)
+					|| !read(input, end, size) || (size_t)(end - input) < size
+					|| source >= sources.size() || !format(text, timestamp,
+					sources[source], level, input, size)) {
+					return false;
+				}
+				input += size;
+			}
+			else if (entry == BINARY_DROPPED) {
+				int64_t timestamp = 0;
+				uint64_t count = 0;
+				if (!read(input, end, timestamp) || !read(input, end, count)) {
+					return false;
+				}
+				formatDropped(text, timestamp, count);
+			}
+			else {
+				return false;
+			}
+			output << text;
+		}
+		return output.good();
+	}
+
+	int64_t AsyncLogManager::getTimestamp() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	uint8_t* AsyncLogManager::reserve(uint32_t size, ThreadBuffer*& buffer) {
+		if (!m_running.load(std::memory_order_acquire)) {
+			buffer = 0;
+			if (scratchBuffer.size() < size) {
+				scratchBuffer.resize(size);
+			}
+			return scratchBuffer.data();
+		}
+		buffer = getThreadBuffer();
+		if (buffer == 0 || size > buffer->capacity / 2) {
+			m_unbufferedDropped.fetch_add(1, std::memory_order_relaxed);
+			return 0;
+		}
+
+		// Pad to the end of the buffer when the record would straddle it so
+		// every record is contiguous
+		const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+		const size_t offset = (size_t)(head & (buffer->capacity - 1));
+		const size_t contiguous = buffer->capacity - offset;
+		const size_t padding = size > contiguous ? contiguous : 0;
+		if (head + padding + size - buffer->cachedTail > buffer->capacity) {
+			buffer->cachedTail = buffer->tail.load(std::memory_order_acquire);
+			if (head + padding + size - buffer->cachedTail
+				> buffer->capacity) {
+				buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+				return 0;
+			}
+		}
+		if (padding != 0) {
+			const uint32_t paddingSize = (uint32_t)padding;
+			std::memcpy(buffer->data.get() + offset, &paddingSize,
+				sizeof(paddingSize));
+			buffer->data[offset + sizeof(paddingSize)] = PADDING_LEVEL;
+		}
+		buffer->reservedHead = head + padding + size;
+		return buffer->data.get() + (size_t)((head + padding)
+			& (buffer->capacity - 1));
+	}
+
+	void AsyncLogManager::commit(ThreadBuffer* buffer, uint8_t* record) {
+		if (buffer != 0) {
+			buffer->head.store(buffer->reservedHead,
+				std::memory_order_release);
+			// Wake the background thread early once the buffer is half full
+			if (buffer->reservedHead - buffer->cachedTail
+				> buffer->capacity / 2) {
+				buffer->cachedTail = buffer->tail.load(
+					std::memory_order_acquire);
+				if (buffer->reservedHead - buffer->cachedTail
+					> buffer->capacity / 2) {
+					m_wake.notify_one();
+				}
+			}
+			return;
+		}
+
+		RecordHeader header;
+		std::memcpy(&header, record, sizeof(header));
+		std::string arguments;
+		formatArguments(arguments, record + sizeof(header),
+			header.argumentSize);
+		std::lock_guard<std::mutex> lock(fallbackMutex);
+		Application::Log, Application::Log.getTimestamp(), ": [",
+			header.source, "] [", getLevelName(header.level), "] ", arguments,
+			"\n";
+	}
+
+	AsyncLogManager::ThreadBuffer* AsyncLogManager::getThreadBuffer() {
+		// The calling thread's buffer, closed when the thread exits
+		struct Handle {
+			// The log the buffer belongs to
+			AsyncLogManager* log = 0;
+			// The run of the log the buffer belongs to
+			uint32_t generation = 0;
+			// The buffer, or 0 if the thread may not have one
+			std::shared_ptr<ThreadBuffer> buffer;
+
+			~Handle() {
+				if (buffer != 0) {
+					buffer->closed.store(true, std::memory_order_release);
+				}
+			}
+		};
+		thread_local Handle handle;
+
+		const uint32_t generation = m_generation.load(
+			std::memory_order_acquire);
+		if (handle.log == this && handle.generation == generation) {
+			return handle.buffer.get();
+		}
+		if (handle.buffer != 0) {
+			handle.buffer->closed.store(true, std::memory_order_release);
+			handle.buffer.reset();
+		}
+
+		// Buffers of exited threads are pruned once drained, so a thread
+		// refused a buffer tries again on its next record
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_buffers.size() >= m_configuration.maximumThreadCount) {
+			return 0;
+		}
+		handle.log = this;
+		handle.generation = generation;
+		handle.buffer = std::make_shared<ThreadBuffer>();
+		handle.buffer->capacity = m_configuration.threadBufferSize;
+		handle.buffer->data.reset(new uint8_t[handle.buffer->capacity]);
+		handle.buffer->threadIndex = m_threadCount++;
+		m_buffers.push_back(handle.buffer);
+		return handle.buffer.get();
+	}
+
+	void AsyncLogManager::run() {
+		const std::chrono::milliseconds interval(
+			m_configuration.flushInterval);
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (true) {
+			const bool stopping = !m_running.load(std::memory_order_relaxed);
+			const uint64_t flush = m_flushesRequested;
+			lock.unlock();
+			writeBatch();
+			lock.lock();
+			m_flushesCompleted = flush;
+			m_flushed.notify_all();
+			if (stopping) {
+				break;
+			}
+			if (m_flushesRequested == flush) {
+				m_wake.wait_for(lock, interval);
+			}
+		}
+	}
+
+	void AsyncLogManager::writeBatch() {
+		// A record waiting to be written
+		struct Pending {
+			// The record's header
+			RecordHeader header;
+			// The record's encoded values
+			const uint8_t* arguments = 0;
+			// The index of the record's thread
+			uint32_t threadIndex = 0;
+		};
+
+		std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			buffers = m_buffers;
+		}
+
+		// Collect every published record, reading only up to each buffer's
+		// head at this moment so producers can keep writing
+		std::vector<Pending> records;
+		std::vector<uint64_t> heads(buffers.size());
+		uint64_t dropped = m_unbufferedDropped.exchange(0,
+			std::memory_order_relaxed);
+		for (size_t i = 0; i < buffers.size(); i++) {
+			ThreadBuffer& buffer = *buffers[i];
+			heads[i] = buffer.head.load(std::memory_order_acquire);
+			uint64_t position = buffer.tail.load(std::memory_order_relaxed);
+			while (position < heads[i]) {
+				const uint8_t* record = buffer.data.get()
+					+ (size_t)(position & (buffer.capacity - 1));
+				uint32_t size = 0;
+				std::memcpy(&size, record, sizeof(size));
+				if (record[sizeof(size)] != PADDING_LEVEL) {
+					Pending pending;
+					std::memcpy(&pending.header, record,
+						sizeof(pending.header));
+					pending.arguments = record + sizeof(RecordHeader);
+					pending.threadIndex = buffer.threadIndex;
+					records.push_back(pending);
+				}
+				position += size;
+			}
+			dropped += buffer.dropped.exchange(0, std::memory_order_relaxed);
+		}
+		std::stable_sort(records.begin(), records.end(),
+			[](const Pending& a, const Pending& b) {
+				return a.header.timestamp < b.header.timestamp;
+			});
+
+		const int64_t now = getTimestamp();
+		std::string text;
+		std::string binary;
+		const bool writeText = m_configuration.console
+			|| !m_textFiles.empty();
+		const bool writeBinary = m_binaryFile.is_open();
+		for (const Pending& record : records) {
+			const RecordHeader& header = record.header;
+			if (writeText) {
+				format(text, header.timestamp, header.source, header.level,
+					record.arguments, header.argumentSize);
+			}
+			if (!writeBinary) {
+				continue;
+			}
+			std::unordered_map<const char*, uint16_t>::iterator source
+				= m_binarySources.find(header.source);
+			if (source == m_binarySources.end()) {
+				const uint16_t size = (uint16_t)std::min(std::strlen(
+					header.source), (size_t)0xFFFF);
+				source = m_binarySources.emplace(header.source,
+					(uint16_t)m_binarySources.size()).first;
+				append(binary, (uint8_t)BINARY_SOURCE);
+				append(binary, source->second);
+				append(binary, size);
+				binary.append(header.source, size);
+			}
+			append(binary, (uint8_t)BINARY_RECORD);
+			append(binary, header.timestamp);
+			append(binary, source->second);
+			append(binary, header.level);
+			append(binary, record.threadIndex);
+			append(binary, (uint32_t)header.argumentSize);
+			binary.append((const char*)record.arguments, header.argumentSize);
+		}
+		if (dropped != 0) {
+			if (writeText) {
+				formatDropped(text, now, dropped);
+			}
+			if (writeBinary) {
+				append(binary, (uint8_t)BINARY_DROPPED);
+				append(binary, now);
+				append(binary, dropped);
+			}
+		}
+
+		if (!text.empty()) {
+			if (m_configuration.console) {
+				std::cout.write(text.data(), text.size());
+				std::cout.flush();
+			}
+			for (std::ofstream& file : m_textFiles) {
+				if (file.good()) {
+					file.write(text.data(), text.size());
+					file.flush();
+				}
+			}
+		}
+		if (!binary.empty()) {
+			m_binaryFile.write(binary.data(), binary.size());
+			m_binaryFile.flush();
+		}
+
+		// Release the written records' space, then forget the buffers of
+		// exited threads once they are empty
+		for (size_t i = 0; i < buffers.size(); i++) {
+			buffers[i]->tail.store(heads[i], std::memory_order_release);
+		}
+		m_recordsWritten.fetch_add(records.size(), std::memory_order_relaxed);
+		m_recordsDropped.fetch_add(dropped, std::memory_order_relaxed);
+		if (!records.empty() || dropped != 0) {
+			m_batchesWritten.fetch_add(1, std::memory_order_relaxed);
+		}
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+			[](const std::shared_ptr<ThreadBuffer>& buffer) {
+				return buffer->closed.load(std::memory_order_acquire)
+					&& buffer->tail.load(std::memory_order_relaxed)
+					== buffer->head.load(std::memory_order_acquire);
+			}), m_buffers.end());
+	}
+
+	bool AsyncLogManager::format(std::string& output, int64_t timestamp,
+		std::string_view source, uint8_t level, const uint8_t* arguments,
+		size_t argumentSize) {
+		// Records arrive in order, so convert the date only once per second
+		const std::time_t seconds = (std::time_t)(timestamp / 1000000000);
+		if (seconds != formattedSecond) {
+			std::tm time = std::tm();
+#ifdef _WIN32
+			localtime_s(&time, &seconds);
+#else
+			localtime_r(&seconds, &time);
+#endif
+			formattedDateLength = std::strftime(formattedDate,
+				sizeof(formattedDate), "%Y-%m-%d %H:%M:%S", &time);
+			formattedSecond = seconds;
+		}
+		const int milliseconds = (int)(timestamp / 1000000 % 1000);
+		output.append(formattedDate, formattedDateLength);
+		output += '.';
+		output += (char)('0' + milliseconds / 100);
+		output += (char)('0' + milliseconds / 10 % 10);
+		output += (char)('0' + milliseconds % 10);
+		output += ": [";
+		output += source;
+		output += "] [";
+		output += getLevelName(level);
+		output += "] ";
+		const bool decoded = formatArguments(output, arguments, argumentSize);
+		output += '\n';
+		return decoded;
+	}
+
+	bool AsyncLogManager::formatArguments(std::string& output,
+		const uint8_t* arguments, size_t argumentSize) {
+		const uint8_t* input = arguments;
+		const uint8_t* const end = arguments + argumentSize;
+		char number[64] = "";
+		while (input < end) {
+			const uint8_t type = *input++;
+			if (type == ARGUMENT_STRING) {
+				uint32_t size = 0;
+				if (!read(input, end, size) || (size_t)(end - input) < size) {
+					return false;
+				}
+				output.append((const char*)input, size);
+				input += size;
+				continue;
+			}
+			if (type == ARGUMENT_BOOL || type == ARGUMENT_CHAR) {
+				if (input == end) {
+					return false;
+				}
+				const uint8_t value = *input++;
+				if (type == ARGUMENT_BOOL) {
+					output += value != 0 ? '1' : '0';
+				}
+				else {
+					output += (char)value;
+				}
+				continue;
+			}
+
+			uint64_t bits = 0;
+			if (!read(input, end, bits)) {
+				return false;
+			}
+			if (type == ARGUMENT_SIGNED) {
+				std::snprintf(number, sizeof(number), "%lld",
+					(long long)(int64_t)bits);
+			}
+			else if (type == ARGUMENT_UNSIGNED) {
+				std::snprintf(number, sizeof(number), "%llu",
+					(unsigned long long)bits);
+			}
+			else if (type == ARGUMENT_FLOATING) {
+				double value = 0.0;
+				std::memcpy(&value, &bits, sizeof(value));
+				std::snprintf(number, sizeof(number), "%g", value);
+			}
+			else if (type == ARGUMENT_POINTER) {
+				std::snprintf(number, sizeof(number), "%p",
+					(void*)(uintptr_t)bits);
+			}
+			else {
+				return false;
+			}
+			output += number;
+		}
+		return true;
+	}
+
+	void AsyncLogManager::formatDropped(std::string& output,
+		int64_t timestamp, uint64_t count) {
+		format(output, timestamp, "LunaLL", LOG_WARNING, 0, 0);
+		output.pop_back();
+		output += "Dropped " + std::to_string(count) + " log records\n";
+	}
+}
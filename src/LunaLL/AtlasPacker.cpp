@@ -0,0 +1,97 @@
+/*
+File:		AtlasPacker.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@14:20
+Purpose:	Implementation of the atlas shelf packer
+*/
+
+#include "AtlasPacker.h"
+
+#include <algorithm>
+
+namespace LunaLL {
+	void AtlasPacker::initialize(unsigned int pageSize) {
+		m_pageSize = pageSize;
+		m_shelves.clear();
+		m_pageHeights.clear();
+		m_usedArea = 0;
+	}
+
+	bool AtlasPacker::pack(const glm::ivec2& dimensions, unsigned int& page,
+		glm::ivec2& position) {
+		const int size = (int)m_pageSize;
+		if (dimensions.x <= 0 || dimensions.y <= 0 || dimensions.x > size
+			|| dimensions.y > size) {
+			return false;
+		}
+
+		// Use the shelf which wastes the least height, ignoring shelves much
+		// taller than the rectangle
+		Shelf* best = 0;
+		for (Shelf& shelf : m_shelves) {
+			if (shelf.height >= dimensions.y
+				&& shelf.height <= dimensions.y + dimensions.y / 2 + 1
+				&& shelf.x + dimensions.x <= size
+				&& (best == 0 || shelf.height < best->height)) {
+				best = &shelf;
+			}
+		}
+		if (best == 0) {
+			// Open a new shelf in the first page with room for it
+			unsigned int shelfPage = 0;
+			while (shelfPage < m_pageHeights.size()
+				&& m_pageHeights[shelfPage] + dimensions.y > size) {
+				shelfPage++;
+			}
+			if (shelfPage == m_pageHeights.size()) {
+				m_pageHeights.push_back(0);
+			}
+			Shelf shelf;
+			shelf.page = shelfPage;
+			shelf.y = m_pageHeights[shelfPage];
+			shelf.height = dimensions.y;
+			m_pageHeights[shelfPage] += dimensions.y;
+			m_shelves.push_back(shelf);
+			best = &m_shelves.back();
+		}
+
+		page = best->page;
+		position = glm::ivec2(best->x, best->y);
+		best->x += dimensions.x;
+		m_usedArea += (size_t)dimensions.x * dimensions.y;
+		return true;
+	}
+
+	unsigned int AtlasPacker::addClosedPage(size_t usedArea) {
+		m_pageHeights.push_back((int)m_pageSize);
+		m_usedArea += usedArea;
+		return (unsigned int)(m_pageHeights.size() - 1);
+	}
+
+	void AtlasPacker::reopenPage(unsigned int page, size_t usedArea) {
+		if (page >= m_pageHeights.size()) {
+			return;
+		}
+		m_shelves.erase(std::remove_if(m_shelves.begin(), m_shelves.end(),
+			[page](const Shelf& shelf) { return shelf.page == page; }),
+			m_shelves.end());
+		m_pageHeights[page] = 0;
+		m_usedArea -= std::min(usedArea, m_usedArea);
+	}
+
+	unsigned int AtlasPacker::getPageSize() const {
+		return m_pageSize;
+	}
+
+	unsigned int AtlasPacker::getPageCount() const {
+		return (unsigned int)m_pageHeights.size();
+	}
+
+	double AtlasPacker::getOccupancy() const {
+		if (m_pageHeights.empty()) {
+			return 0.0;
+		}
+		return (double)m_usedArea / ((double)m_pageSize * m_pageSize
+			* m_pageHeights.size());
+	}
+}
@@ -0,0 +1,422 @@
+/*
+File:		AudioManager.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@21:55
+Purpose:	Implementation of the streaming, bank loading audio manager
+*/
+
+#include "AudioManager.h"
+#include "AsyncLog.h"
+
+#include <algorithm>
+
+namespace LunaLL {
+	namespace {
+		/*
+		Get the time elapsed since a point in seconds
+		Parameter: std::chrono::steady_clock::time_point start - The point
+		Returns: double - The elapsed time in seconds
+		*/
+		double getSecondsSince(std::chrono::steady_clock::time_point start) {
+			return std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count();
+		}
+
+		/*
+		Get the memory used by a decoded sound effect
+		Parameter: const SoLoud::Wav& wav - The effect
+		Returns: size_t - The size of its samples in bytes
+		*/
+		size_t getDecodedSize(const SoLoud::Wav& wav) {
+			return (size_t)wav.mSampleCount * wav.mChannels * sizeof(float);
+		}
+	}
+
+	AudioManager::~AudioManager() {
+		destroy();
+	}
+
+	bool AudioManager::initialize(const AudioConfiguration& configuration) {
+		destroy();
+		m_configuration = configuration;
+		const SoLoud::result result = m_soloud.init(
+			SoLoud::Soloud::CLIP_ROUNDOFF, configuration.headless
+			? SoLoud::Soloud::NULLDRIVER : SoLoud::Soloud::AUTO);
+		if (result != SoLoud::SO_NO_ERROR) {
+			LUNALL_LOG(LunaLL, ERROR, "Failed to initialize SoLoud: ",
+				m_soloud.getErrorString(result));
+			return false;
+		}
+		m_soloud.setMaxActiveVoiceCount(
+			configuration.maximumActiveVoiceCount);
+		m_effectVolume = configuration.effectVolume;
+		m_musicVolume = configuration.musicVolume;
+		m_metrics = AudioMetrics();
+		m_thread = std::thread(&AudioManager::decode, this);
+		m_initialized = true;
+		return true;
+	}
+
+	bool AudioManager::loadBank(const std::string& name,
+		const std::vector<std::string>& fileNames) {
+		if (!m_initialized || m_banks.find(name) != m_banks.end()) {
+			return false;
+		}
+		Bank& bank = m_banks[name];
+		for (const std::string& fileName : fileNames) {
+			if (std::find(bank.fileNames.begin(), bank.fileNames.end(),
+				fileName) != bank.fileNames.end()) {
+				continue;
+			}
+			bank.fileNames.push_back(fileName);
+			std::unordered_map<std::string, Effect>::iterator it
+				= m_effects.find(fileName);
+			if (it != m_effects.end()) {
+				it->second.bankCount++;
+				continue;
+			}
+
+			Effect& effect = m_effects[fileName];
+			effect.bankCount = 1;
+			std::unordered_map<std::string, unsigned int>::const_iterator limit
+				= m_voiceLimits.find(fileName);
+			effect.voiceLimit = limit != m_voiceLimits.end() ? limit->second
+				: m_configuration.defaultVoiceLimit;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_requests.push_back(fileName);
+			}
+			m_condition.notify_one();
+			m_metrics.effectsPending++;
+		}
+		return true;
+	}
+
+	bool AudioManager::unloadBank(const std::string& name) {
+		std::unordered_map<std::string, Bank>::iterator bank
+			= m_banks.find(name);
+		if (bank == m_banks.end()) {
+			return false;
+		}
+		for (const std::string& fileName : bank->second.fileNames) {
+			std::unordered_map<std::string, Effect>::iterator it
+				= m_effects.find(fileName);
+			if (it != m_effects.end() && --it->second.bankCount == 0) {
+				removeEffect(fileName);
+			}
+		}
+		m_banks.erase(bank);
+		return true;
+	}
+
+	BankStatus AudioManager::getBankStatus(const std::string& name) const {
+		std::unordered_map<std::string, Bank>::const_iterator bank
+			= m_banks.find(name);
+		if (bank == m_banks.end()) {
+			return BANK_UNLOADED;
+		}
+		bool failed = false;
+		for (const std::string& fileName : bank->second.fileNames) {
+			const Effect& effect = m_effects.at(fileName);
+			if (!effect.wav && !effect.failed) {
+				return BANK_LOADING;
+			}
+			failed = failed || effect.failed;
+		}
+		return failed ? BANK_FAILED : BANK_LOADED;
+	}
+
+	float AudioManager::getBankProgress(const std::string& name) const {
+		std::unordered_map<std::string, Bank>::const_iterator bank
+			= m_banks.find(name);
+		if (bank == m_banks.end()) {
+			return 0.0f;
+		}
+		if (bank->second.fileNames.empty()) {
+			return 1.0f;
+		}
+		size_t finished = 0;
+		for (const std::string& fileName : bank->second.fileNames) {
+			const Effect& effect = m_effects.at(fileName);
+			finished += effect.wav || effect.failed;
+		}
+		return (float)finished / bank->second.fileNames.size();
+	}
+
+	void AudioManager::update() {
+		std::deque<DecodedEffect> decoded;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			decoded.swap(m_decoded);
+		}
+		for (DecodedEffect& result : decoded) {
+			m_metrics.effectsPending--;
+			m_metrics.decodeSeconds += result.decodeSeconds;
+			m_metrics.maximumDecodeSeconds = std::max(
+				m_metrics.maximumDecodeSeconds, result.decodeSeconds);
+			std::unordered_map<std::string, Effect>::iterator it
+				= m_effects.find(result.fileName);
+			// The effect's banks were unloaded or it was requested again
+			if (it == m_effects.end() || it->second.wav
+				|| it->second.failed) {
+				continue;
+			}
+			if (!result.loaded) {
+				LUNALL_LOG(LunaLL, ERROR, "Failed to load sound effect \"",
+					result.fileName, "\"");
+				it->second.failed = true;
+				m_metrics.failures++;
+				continue;
+			}
+			it->second.wav = std::move(result.wav);
+			m_metrics.effectsLoaded++;
+			m_metrics.effectBytes += getDecodedSize(*it->second.wav);
+		}
+
+		for (std::pair<const std::string, Effect>& effect : m_effects) {
+			std::vector<SoLoud::handle>& voices = effect.second.voices;
+			voices.erase(std::remove_if(voices.begin(), voices.end(),
+				[this](SoLoud::handle voice) {
+					return !m_soloud.isValidVoiceHandle(voice);
+				}), voices.end());
+		}
+	}
+
+	bool AudioManager::isLoading() const {
+		return m_metrics.effectsPending != 0;
+	}
+
+	void AudioManager::finishLoading() {
+		if (m_initialized) {
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_decodedCondition.wait(lock, [this]() {
+				return m_requests.empty() && !m_decoding;
+			});
+		}
+		update();
+	}
+
+	void AudioManager::setVoiceLimit(const std::string& fileName,
+		unsigned int voiceLimit) {
+		voiceLimit = std::max(voiceLimit, 1u);
+		m_voiceLimits[fileName] = voiceLimit;
+		std::unordered_map<std::string, Effect>::iterator it
+			= m_effects.find(fileName);
+		if (it != m_effects.end()) {
+			it->second.voiceLimit = voiceLimit;
+		}
+	}
+
+	unsigned int AudioManager::getVoiceCount(
+		const std::string& fileName) const {
+		std::unordered_map<std::string, Effect>::const_iterator it
+			= m_effects.find(fileName);
+		return it != m_effects.end()
+			? (unsigned int)it->second.voices.size() : 0;
+	}
+
+	bool AudioManager::playEffect(const std::string& fileName, float volume,
+		float pan) {
+		if (!m_initialized) {
+			return false;
+		}
+		std::unordered_map<std::string, Effect>::iterator it
+			= m_effects.find(fileName);
+		if (it == m_effects.end() || !it->second.wav) {
+			if (it == m_effects.end()) {
+				loadBank(fileName, { fileName });
+			}
+			m_metrics.effectsUnavailable++;
+			return false;
+		}
+		Effect& effect = it->second;
+
+		// Drop ended voices, then merge a burst of plays into its first
+		std::vector<SoLoud::handle>& voices = effect.voices;
+		voices.erase(std::remove_if(voices.begin(), voices.end(),
+			[this](SoLoud::handle voice) {
+				return !m_soloud.isValidVoiceHandle(voice);
+			}), voices.end());
+		const std::chrono::steady_clock::time_point now
+			= std::chrono::steady_clock::now();
+		if (!voices.empty() && std::chrono::duration<double>(
+			now - effect.lastPlayed).count() < m_configuration.retriggerTime) {
+			m_metrics.effectsMerged++;
+			return true;
+		}
+		while (!voices.empty() && voices.size() >= effect.voiceLimit) {
+			m_soloud.stop(voices.front());
+			voices.erase(voices.begin());
+			m_metrics.voicesStolen++;
+		}
+
+		voices.push_back(m_soloud.play(*effect.wav, volume * m_effectVolume,
+			pan));
+		effect.lastPlayed = now;
+		m_metrics.effectsPlayed++;
+		return true;
+	}
+
+	bool AudioManager::isMusicPaused() const {
+		return m_music && m_musicPaused;
+	}
+
+	bool AudioManager::playMusic(const std::string& fileName, bool looping) {
+		if (!m_initialized) {
+			return false;
+		}
+		if (fileName.empty()) {
+			if (!m_music) {
+				return false;
+			}
+			m_soloud.setPause(m_musicHandle, false);
+			m_musicPaused = false;
+			return true;
+		}
+
+		// Only the track's header is read here, its samples are decoded from
+		// disk as the mixer needs them
+		std::unique_ptr<SoLoud::WavStream> music
+			= std::make_unique<SoLoud::WavStream>();
+		const SoLoud::result result = music->load(fileName.c_str());
+		if (result != SoLoud::SO_NO_ERROR) {
+			LUNALL_LOG(LunaLL, ERROR, "Failed to open music track \"",
+				fileName, "\": ", m_soloud.getErrorString(result));
+			return false;
+		}
+		stopMusic();
+		m_music = std::move(music);
+		m_music->setLooping(looping);
+		m_musicHandle = m_soloud.playBackground(*m_music, m_musicVolume);
+		m_musicPaused = false;
+		m_metrics.musicDecodedBytes = (size_t)m_music->mSampleCount
+			* m_music->mChannels * sizeof(float);
+		return true;
+	}
+
+	bool AudioManager::pauseMusic() {
+		if (!m_music || m_musicPaused) {
+			return false;
+		}
+		m_soloud.setPause(m_musicHandle, true);
+		m_musicPaused = true;
+		return true;
+	}
+
+	bool AudioManager::stopMusic() {
+		if (!m_music) {
+			return false;
+		}
+		m_soloud.stop(m_musicHandle);
+		m_music.reset();
+		m_musicHandle = 0;
+		m_musicPaused = false;
+		m_metrics.musicDecodedBytes = 0;
+		return true;
+	}
+
+	float AudioManager::getEffectVolume() const {
+		return m_effectVolume;
+	}
+
+	void AudioManager::setEffectVolume(float effectVolume) {
+		m_effectVolume = effectVolume;
+	}
+
+	float AudioManager::getMusicVolume() const {
+		return m_musicVolume;
+	}
+
+	void AudioManager::setMusicVolume(float musicVolume) {
+		m_musicVolume = musicVolume;
+		if (m_music) {
+			m_soloud.setVolume(m_musicHandle, musicVolume);
+		}
+	}
+
+	const AudioMetrics& AudioManager::getMetrics() const {
+		return m_metrics;
+	}
+
+	void AudioManager::destroy() {
+		if (!m_initialized) {
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_condition.notify_all();
+		m_thread.join();
+		m_stopping = false;
+		m_requests.clear();
+		m_decoded.clear();
+
+		stopMusic();
+		m_soloud.stopAll();
+		m_effects.clear();
+		m_banks.clear();
+		m_voiceLimits.clear();
+		m_soloud.deinit();
+		m_initialized = false;
+	}
+
+	void AudioManager::decode() {
+		while (true) {
+			DecodedEffect effect;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this]() {
+					return m_stopping || !m_requests.empty();
+				});
+				if (m_stopping) {
+					return;
+				}
+				effect.fileName = std::move(m_requests.front());
+				m_requests.pop_front();
+				m_decoding = true;
+			}
+
+			std::chrono::steady_clock::time_point start
+				= std::chrono::steady_clock::now();
+			effect.wav = std::make_unique<SoLoud::Wav>();
+			effect.loaded = effect.wav->load(effect.fileName.c_str())
+				== SoLoud::SO_NO_ERROR;
+			if (!effect.loaded) {
+				effect.wav.reset();
+			}
+			effect.decodeSeconds = getSecondsSince(start);
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_decoded.push_back(std::move(effect));
+				m_decoding = false;
+			}
+			m_decodedCondition.notify_all();
+		}
+	}
+
+	void AudioManager::removeEffect(const std::string& fileName) {
+		std::unordered_map<std::string, Effect>::iterator it
+			= m_effects.find(fileName);
+		if (it == m_effects.end()) {
+			return;
+		}
+		if (it->second.wav) {
+			it->second.wav->stop();
+			m_metrics.effectsLoaded--;
+			m_metrics.effectBytes -= getDecodedSize(*it->second.wav);
+		}
+		else if (!it->second.failed) {
+			// Skip decoding the effect if it has not started yet
+			std::lock_guard<std::mutex> lock(m_mutex);
+			std::deque<std::string>::iterator request = std::find(
+				m_requests.begin(), m_requests.end(), fileName);
+			if (request != m_requests.end()) {
+				m_requests.erase(request);
+				m_metrics.effectsPending--;
+			}
+		}
+		m_effects.erase(it);
+	}
+}
@@ -0,0 +1,241 @@
+/*
+File:		EntityStore.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@20:45
+Purpose:	Implementation of the entity store
+*/
+
+#include "EntityStore.h"
+
+namespace LunaLL {
+	namespace {
+		/*
+		Move the last element of a list to an index and remove the last
+		element
+		Parameter: std::vector<T>& list - The list
+		Parameter: size_t index - The index to replace
+		*/
+		template <typename T>
+		void removeSwapped(std::vector<T>& list, size_t index) {
+			list[index] = list.back();
+			list.pop_back();
+		}
+
+		// Reads the protected frame timer of ActiasFW animations, which have
+		// no getter for it
+		class AnimationTimer : public ActiasFW::Animation {
+		public:
+			/*
+			Get the time an animation's current frame has played for
+			Parameter: const ActiasFW::Animation& animation - The animation
+			Returns: float - The animation's frame timer
+			*/
+			static float get(const ActiasFW::Animation& animation) {
+				return animation.*(&AnimationTimer::m_timer);
+			}
+		};
+	}
+
+	size_t EntityStore::add(const glm::vec3& position,
+		const glm::vec2& velocity, float rotationVelocity,
+		unsigned int frameCount, float frameTime) {
+		m_positionsX.push_back(position.x);
+		m_positionsY.push_back(position.y);
+		m_depths.push_back(position.z);
+		m_velocitiesX.push_back(velocity.x);
+		m_velocitiesY.push_back(velocity.y);
+		m_rotations.push_back(0.0f);
+		m_rotationVelocities.push_back(rotationVelocity);
+		m_timers.push_back(0.0f);
+		m_frameTimes.push_back(frameTime);
+		m_currentFrames.push_back(0);
+		m_frameCounts.push_back(frameCount);
+		m_playing.push_back(frameTime > 0.0f && frameCount > 1);
+		return m_positionsX.size() - 1;
+	}
+
+	size_t EntityStore::add(const ActiasFW::Sprite& sprite) {
+		const size_t index = add(sprite.getPosition(), sprite.getVelocity(),
+			sprite.getRotationVelocity());
+		m_rotations[index] = sprite.getRotation();
+		return index;
+	}
+
+	size_t EntityStore::add(const ActiasFW::Animation& animation,
+		unsigned int frameCount) {
+		const size_t index = add(animation.getPosition(),
+			animation.getVelocity(), animation.getRotationVelocity(),
+			frameCount, animation.getFrameTime());
+		m_rotations[index] = animation.getRotation();
+		m_currentFrames[index] = animation.getCurrentFrame();
+		m_timers[index] = AnimationTimer::get(animation);
+		m_playing[index] = animation.isPlaying();
+		return index;
+	}
+
+	void EntityStore::remove(size_t index) {
+		if (index >= m_positionsX.size()) {
+			return;
+		}
+		removeSwapped(m_positionsX, index);
+		removeSwapped(m_positionsY, index);
+		removeSwapped(m_depths, index);
+		removeSwapped(m_velocitiesX, index);
+		removeSwapped(m_velocitiesY, index);
+		removeSwapped(m_rotations, index);
+		removeSwapped(m_rotationVelocities, index);
+		removeSwapped(m_timers, index);
+		removeSwapped(m_frameTimes, index);
+		removeSwapped(m_currentFrames, index);
+		removeSwapped(m_frameCounts, index);
+		removeSwapped(m_playing, index);
+	}
+
+	size_t EntityStore::getSize() const {
+		return m_positionsX.size();
+	}
+
+	void EntityStore::reserve(size_t capacity) {
+		m_positionsX.reserve(capacity);
+		m_positionsY.reserve(capacity);
+		m_depths.reserve(capacity);
+		m_velocitiesX.reserve(capacity);
+		m_velocitiesY.reserve(capacity);
+		m_rotations.reserve(capacity);
+		m_rotationVelocities.reserve(capacity);
+		m_timers.reserve(capacity);
+		m_frameTimes.reserve(capacity);
+		m_currentFrames.reserve(capacity);
+		m_frameCounts.reserve(capacity);
+		m_playing.reserve(capacity);
+	}
+
+	void EntityStore::clear() {
+		m_positionsX.clear();
+		m_positionsY.clear();
+		m_depths.clear();
+		m_velocitiesX.clear();
+		m_velocitiesY.clear();
+		m_rotations.clear();
+		m_rotationVelocities.clear();
+		m_timers.clear();
+		m_frameTimes.clear();
+		m_currentFrames.clear();
+		m_frameCounts.clear();
+		m_playing.clear();
+	}
+
+	void EntityStore::update(float timeStep) {
+		JobSystem::Jobs.parallelFor(0, getSize(), GRAIN_SIZE,
+			[this, timeStep](size_t begin, size_t end) {
+				update(begin, end, timeStep);
+			});
+	}
+
+	void EntityStore::update(size_t begin, size_t end, float timeStep) {
+		float* const positionsX = m_positionsX.data();
+		float* const positionsY = m_positionsY.data();
+		const float* const velocitiesX = m_velocitiesX.data();
+		const float* const velocitiesY = m_velocitiesY.data();
+		float* const rotations = m_rotations.data();
+		const float* const rotationVelocities = m_rotationVelocities.data();
+
+		// Each component is updated in its own loop over plain arrays so the
+		// compiler vectorizes it
+		for (size_t i = begin; i < end; i++) {
+			positionsX[i] += velocitiesX[i] * timeStep;
+		}
+		for (size_t i = begin; i < end; i++) {
+			positionsY[i] += velocitiesY[i] * timeStep;
+		}
+		for (size_t i = begin; i < end; i++) {
+			rotations[i] += rotationVelocities[i] * timeStep;
+		}
+
+		// Frames advance rarely, so the timers are advanced in bulk and only
+		// the expired ones take a branch
+		float* const timers = m_timers.data();
+		const float* const frameTimes = m_frameTimes.data();
+		const uint8_t* const playing = m_playing.data();
+		for (size_t i = begin; i < end; i++) {
+			timers[i] += playing[i] != 0 ? timeStep : 0.0f;
+		}
+		for (size_t i = begin; i < end; i++) {
+			if (timers[i] < frameTimes[i] || playing[i] == 0
+				|| m_frameCounts[i] == 0 || frameTimes[i] <= 0.0f) {
+				continue;
+			}
+			while (timers[i] >= frameTimes[i]) {
+				timers[i] -= frameTimes[i];
+				m_currentFrames[i] = (m_currentFrames[i] + 1)
+					% m_frameCounts[i];
+			}
+		}
+	}
+
+	void EntityStore::apply(size_t index, ActiasFW::Sprite& sprite) const {
+		sprite.setPosition(getPosition(index));
+		sprite.setRotation(m_rotations[index]);
+	}
+
+	void EntityStore::apply(size_t index,
+		ActiasFW::Animation& animation) const {
+		animation.setPosition(getPosition(index));
+		animation.setRotation(m_rotations[index]);
+		animation.setCurrentFrame(m_currentFrames[index]);
+	}
+
+	glm::vec3 EntityStore::getPosition(size_t index) const {
+		return glm::vec3(m_positionsX[index], m_positionsY[index],
+			m_depths[index]);
+	}
+
+	void EntityStore::setPosition(size_t index, const glm::vec3& position) {
+		m_positionsX[index] = position.x;
+		m_positionsY[index] = position.y;
+		m_depths[index] = position.z;
+	}
+
+	glm::vec2 EntityStore::getVelocity(size_t index) const {
+		return glm::vec2(m_velocitiesX[index], m_velocitiesY[index]);
+	}
+
+	void EntityStore::setVelocity(size_t index, const glm::vec2& velocity) {
+		m_velocitiesX[index] = velocity.x;
+		m_velocitiesY[index] = velocity.y;
+	}
+
+	float EntityStore::getRotation(size_t index) const {
+		return m_rotations[index];
+	}
+
+	void EntityStore::setRotation(size_t index, float rotation) {
+		m_rotations[index] = rotation;
+	}
+
+	float EntityStore::getRotationVelocity(size_t index) const {
+		return m_rotationVelocities[index];
+	}
+
+	void EntityStore::setRotationVelocity(size_t index,
+		float rotationVelocity) {
+		m_rotationVelocities[index] = rotationVelocity;
+	}
+
+	unsigned int EntityStore::getCurrentFrame(size_t index) const {
+		return m_currentFrames[index];
+	}
+
+	void EntityStore::setCurrentFrame(size_t index,
+		unsigned int currentFrame) {
+		m_currentFrames[index] = currentFrame;
+	}
+
+	bool EntityStore::isPlaying(size_t index) const {
+		return m_playing[index] != 0;
+	}
+
+	void EntityStore::setPlaying(size_t index, bool playing) {
+		m_playing[index] = playing;
+	}
+}
@@ -0,0 +1,105 @@
+/*
+File:		FileMapping.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@09:12
+Purpose:	Implementation of the memory mapped file used for level streaming
+*/
+
+#include "FileMapping.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace LunaLL {
+	FileMapping::~FileMapping() {
+		close();
+	}
+
+	bool FileMapping::open(const std::string& fileName) {
+		close();
+#ifdef _WIN32
+		HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ,
+			FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, 0);
+		if (file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+		HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+		if (mapping == 0) {
+			CloseHandle(file);
+			return false;
+		}
+		const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (data == 0) {
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+		m_fileHandle = file;
+		m_mappingHandle = mapping;
+		m_data = (const uint8_t*)data;
+		m_size = (size_t)size.QuadPart;
+#else
+		int file = ::open(fileName.c_str(), O_RDONLY);
+		if (file < 0) {
+			return false;
+		}
+		struct stat status;
+		if (fstat(file, &status) != 0 || status.st_size == 0) {
+			::close(file);
+			return false;
+		}
+		void* data = mmap(0, (size_t)status.st_size, PROT_READ, MAP_PRIVATE,
+			file, 0);
+		::close(file);
+		if (data == MAP_FAILED) {
+			return false;
+		}
+		madvise(data, (size_t)status.st_size, MADV_RANDOM);
+		m_data = (const uint8_t*)data;
+		m_size = (size_t)status.st_size;
+#endif
+		return true;
+	}
+
+	void FileMapping::close() {
+		if (m_data == 0) {
+			return;
+		}
+#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+		CloseHandle((HANDLE)m_mappingHandle);
+		CloseHandle((HANDLE)m_fileHandle);
+#else
+		munmap((void*)m_data, m_size);
+#endif
+		m_data = 0;
+		m_size = 0;
+		m_fileHandle = 0;
+		m_mappingHandle = 0;
+	}
+
+	bool FileMapping::isOpen() const {
+		return m_data != 0;
+	}
+
+	const uint8_t* FileMapping::getData() const {
+		return m_data;
+	}
+
+	size_t FileMapping::getSize() const {
+		return m_size;
+	}
+}
@@ -0,0 +1,203 @@
+/*
+File:		GlyphAtlas.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@15:40
+Purpose:	Implementation of the glyph atlases and font cache
+*/
+
+#include "GlyphAtlas.h"
+#include "AsyncLog.h"
+#include "AtlasPacker.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace LunaLL {
+	bool GlyphAtlas::initialize(FT_Library freeType,
+		const std::string& fontFileName, unsigned int pixelSize) {
+		destroy();
+		m_fontFileName = fontFileName;
+		m_pixelSize = pixelSize;
+		FT_Face face = 0;
+		if (freeType == 0 || FT_New_Face(freeType, fontFileName.c_str(), 0,
+			&face) != 0) {
+			LUNALL_LOG(LunaLL, ERROR, "Failed to load font \"", fontFileName,
+				"\"");
+			return false;
+		}
+		FT_Set_Pixel_Sizes(face, 0, pixelSize);
+		m_ascender = face->size->metrics.ascender / 64.0f;
+		m_descender = face->size->metrics.descender / 64.0f;
+		m_lineHeight = face->size->metrics.height / 64.0f;
+
+		// Rasterize every glyph, keeping a copy of each coverage bitmap
+		std::vector<std::vector<unsigned char>> bitmaps(GLYPH_COUNT);
+		for (unsigned int character = 0; character < GLYPH_COUNT;
+			character++) {
+			if (FT_Get_Char_Index(face, character) == 0
+				|| FT_Load_Char(face, character, FT_LOAD_RENDER) != 0) {
+				continue;
+			}
+			const FT_GlyphSlot slot = face->glyph;
+			GlyphMetrics& glyph = m_glyphs[character];
+			glyph.dimensions = glm::vec2(slot->bitmap.width, slot->bitmap.rows);
+			glyph.bearing = glm::vec2(slot->bitmap_left, slot->bitmap_top);
+			glyph.advance = slot->advance.x / 64.0f;
+			glyph.present = slot->bitmap.width > 0 && slot->bitmap.rows > 0;
+			if (!glyph.present) {
+				continue;
+			}
+			std::vector<unsigned char>& bitmap = bitmaps[character];
+			bitmap.resize((size_t)slot->bitmap.width * slot->bitmap.rows);
+			for (unsigned int row = 0; row < slot->bitmap.rows; row++) {
+				const unsigned char* source = slot->bitmap.buffer
+					+ (ptrdiff_t)row * slot->bitmap.pitch;
+				std::copy(source, source + slot->bitmap.width,
+					bitmap.begin() + (size_t)row * slot->bitmap.width);
+			}
+		}
+		FT_Done_Face(face);
+
+		// Grow the atlas until every glyph fits in a single page, leaving a
+		// transparent pixel between glyphs
+		std::array<glm::ivec2, GLYPH_COUNT> positions;
+		unsigned int size = 64;
+		AtlasPacker packer;
+		bool packed = false;
+		while (!packed && size <= MAXIMUM_DIMENSION) {
+			packer.initialize(size);
+			packed = true;
+			for (unsigned int character = 0; character < GLYPH_COUNT
+				&& packed; character++) {
+				if (!m_glyphs[character].present) {
+					continue;
+				}
+				unsigned int page = 0;
+				packed = packer.pack(glm::ivec2(m_glyphs[character].dimensions)
+					+ 1, page, positions[character]) && page == 0;
+			}
+			if (!packed) {
+				size *= 2;
+			}
+		}
+		if (!packed) {
+			LUNALL_LOG(LunaLL, ERROR, "Font \"", fontFileName, "\" at ",
+				pixelSize, " pixels does not fit in a glyph atlas");
+			destroy();
+			return false;
+		}
+
+		// Copy the coverage into white pixels' alpha starting at the bottom row
+		m_dimensions = glm::ivec2(size, size);
+		std::vector<unsigned char> pixels((size_t)size * size * 4, 0);
+		for (size_t i = 0; i < pixels.size(); i += 4) {
+			pixels[i] = pixels[i + 1] = pixels[i + 2] = 255;
+		}
+		for (unsigned int character = 0; character < GLYPH_COUNT;
+			character++) {
+			GlyphMetrics& glyph = m_glyphs[character];
+			if (!glyph.present) {
+				continue;
+			}
+			const glm::ivec2 dimensions(glyph.dimensions);
+			const glm::ivec2& position = positions[character];
+			for (int row = 0; row < dimensions.y; row++) {
+				const unsigned char* source = bitmaps[character].data()
+					+ (size_t)row * dimensions.x;
+				unsigned char* destination = pixels.data()
+					+ ((size_t)(position.y + dimensions.y - 1 - row) * size
+					+ position.x) * 4;
+				for (int column = 0; column < dimensions.x; column++) {
+					destination[column * 4 + 3] = source[column];
+				}
+			}
+			glyph.textureBox = glm::vec4(glm::vec2(position),
+				glyph.dimensions) / (float)size;
+		}
+
+		glGenTextures(1, &m_texture);
+		glBindTexture(GL_TEXTURE_2D, m_texture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size, size, 0, GL_RGBA,
+			GL_UNSIGNED_BYTE, pixels.data());
+		glBindTexture(GL_TEXTURE_2D, 0);
+		return true;
+	}
+
+	GLuint GlyphAtlas::getTexture() const {
+		return m_texture;
+	}
+
+	const glm::ivec2& GlyphAtlas::getDimensions() const {
+		return m_dimensions;
+	}
+
+	const std::string& GlyphAtlas::getFontFileName() const {
+		return m_fontFileName;
+	}
+
+	unsigned int GlyphAtlas::getPixelSize() const {
+		return m_pixelSize;
+	}
+
+	float GlyphAtlas::getAscender() const {
+		return m_ascender;
+	}
+
+	float GlyphAtlas::getDescender() const {
+		return m_descender;
+	}
+
+	float GlyphAtlas::getLineHeight() const {
+		return m_lineHeight;
+	}
+
+	void GlyphAtlas::destroy() {
+		if (m_texture != 0) {
+			glDeleteTextures(1, &m_texture);
+			m_texture = 0;
+		}
+		m_glyphs.fill(GlyphMetrics());
+		m_dimensions = glm::ivec2();
+		m_ascender = 0.0f;
+		m_descender = 0.0f;
+		m_lineHeight = 0.0f;
+	}
+
+	bool FontCache::initialize() {
+		destroy();
+		if (FT_Init_FreeType(&m_freeType) != 0) {
+			LUNALL_LOG(LunaLL, ERROR, "Failed to initialize FreeType");
+			m_freeType = 0;
+			return false;
+		}
+		return true;
+	}
+
+	const GlyphAtlas* FontCache::getAtlas(const std::string& fontFileName,
+		unsigned int pixelSize) {
+		const std::string key = fontFileName + "@" + std::to_string(pixelSize);
+		std::unordered_map<std::string, GlyphAtlas>::iterator it
+			= m_atlases.find(key);
+		if (it == m_atlases.end()) {
+			// Remember failed fonts so they are not loaded every frame
+			it = m_atlases.emplace(key, GlyphAtlas()).first;
+			it->second.initialize(m_freeType, fontFileName, pixelSize);
+		}
+		return it->second.getTexture() != 0 ? &it->second : 0;
+	}
+
+	void FontCache::destroy() {
+		for (std::pair<const std::string, GlyphAtlas>& atlas : m_atlases) {
+			atlas.second.destroy();
+		}
+		m_atlases.clear();
+		if (m_freeType != 0) {
+			FT_Done_FreeType(m_freeType);
+			m_freeType = 0;
+		}
+	}
+}
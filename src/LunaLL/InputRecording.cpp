@@ -0,0 +1,334 @@
+/*
+File:		InputRecording.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@19:05
+Purpose:	Implementation of input recordings, their recorder, and their
+			replay
+*/
+
+#include "InputRecording.h"
+#include "AsyncLog.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using ActiasFW::Application;
+
+namespace LunaLL {
+	namespace {
+		/*
+		Append a value's bytes to a buffer
+		Parameter: std::string& output - The buffer
+		Parameter: const T& value - The value
+		*/
+		template <typename T>
+		void append(std::string& output, const T& value) {
+			output.append((const char*)&value, sizeof(value));
+		}
+
+		/*
+		Read a value's bytes from a buffer
+		Parameter: const char*& input - The position to read from, advanced
+		past the value
+		Parameter: const char* end - The end of the buffer
+		Parameter: T& value - Set to the value
+		Returns: bool - Whether the buffer held the whole value
+		*/
+		template <typename T>
+		bool read(const char*& input, const char* end, T& value) {
+			if ((size_t)(end - input) < sizeof(value)) {
+				return false;
+			}
+			std::memcpy(&value, input, sizeof(value));
+			input += sizeof(value);
+			return true;
+		}
+	}
+
+	const std::string InputRecording::MAGIC = "LLIN";
+
+	InputFrame& InputRecording::addFrame() {
+		m_frames.emplace_back();
+		return m_frames.back();
+	}
+
+	const std::vector<InputFrame>& InputRecording::getFrames() const {
+		return m_frames;
+	}
+
+	size_t InputRecording::getEventCount() const {
+		size_t count = 0;
+		for (const InputFrame& frame : m_frames) {
+			count += frame.events.size();
+		}
+		return count;
+	}
+
+	bool InputRecording::save(const std::string& fileName) const {
+		std::string output = MAGIC;
+		append(output, VERSION);
+		append(output, (uint32_t)m_frames.size());
+		for (const InputFrame& frame : m_frames) {
+			append(output, (uint32_t)frame.events.size());
+			append(output, (uint32_t)frame.timeSteps.size());
+			for (const InputEvent& event : frame.events) {
+				append(output, (uint8_t)event.type);
+				append(output, event.code);
+				append(output, event.controller);
+				append(output, event.value.x);
+				append(output, event.value.y);
+			}
+			output.append((const char*)frame.timeSteps.data(),
+				frame.timeSteps.size() * sizeof(float));
+		}
+
+		std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+		file.write(output.data(), output.size());
+		if (!file.good()) {
+			LUNALL_LOG(LunaLL, ERROR, "Failed to write input recording \"",
+				fileName, "\"");
+			return false;
+		}
+		return true;
+	}
+
+	bool InputRecording::load(const std::string& fileName) {
+		clear();
+		std::ifstream file(fileName, std::ios::binary);
+		if (!file.good()) {
+			LUNALL_LOG(LunaLL, ERROR, "Failed to open input recording \"",
+				fileName, "\"");
+			return false;
+		}
+		const std::string data((std::istreambuf_iterator<char>(file)),
+			std::istreambuf_iterator<char>());
+		const char* input = data.data();
+		const char* const end = input + data.size();
+		uint32_t version = 0;
+		uint32_t frameCount = 0;
+		if (data.compare(0, MAGIC.size(), MAGIC) != 0) {
+			LUNALL_LOG(LunaLL, ERROR, "\"", fileName,
+				"\" is not an input recording");
+			return false;
+		}
+		input += MAGIC.size();
+		if (!read(input, end, version) || version != VERSION) {
+			LUNALL_LOG(LunaLL, ERROR, "Input recording \"", fileName,
+				"\" has unsupported version ", version);
+			return false;
+		}
+
+		// Every frame holds at least its event and time step counts, so a
+		// frame count the remaining bytes cannot hold is not reserved
+		bool valid = read(input, end, frameCount) && frameCount
+			<= (size_t)(end - input) / (2 * sizeof(uint32_t));
+		m_frames.reserve(valid ? frameCount : 0);
+		for (uint32_t i = 0; i < frameCount && valid; i++) {
+			InputFrame& frame = addFrame();
+			uint32_t eventCount = 0;
+			uint32_t timeStepCount = 0;
+			valid = read(input, end, eventCount)
+				&& read(input, end, timeStepCount);
+			for (uint32_t j = 0; j < eventCount && valid; j++) {
+				InputEvent event;
+				uint8_t type = 0;
+				valid = read(input, end, type) && read(input, end, event.code)
+					&& read(input, end, event.controller)
+					&& read(input, end, event.value.x)
+					&& read(input, end, event.value.y)
+					&& type < INPUT_EVENT_TYPE_COUNT;
+				event.type = (InputEventType)type;
+				frame.events.push_back(event);
+			}
+			valid = valid && (size_t)(end - input) >= (size_t)timeStepCount
+				* sizeof(float);
+			if (valid) {
+				frame.timeSteps.resize(timeStepCount);
+				std::memcpy(frame.timeSteps.data(), input, (size_t)timeStepCount
+					* sizeof(float));
+				input += (size_t)timeStepCount * sizeof(float);
+			}
+		}
+		if (!valid) {
+			LUNALL_LOG(LunaLL, ERROR, "Input recording \"", fileName,
+				"\" is truncated");
+			clear();
+			return false;
+		}
+		return true;
+	}
+
+	void InputRecording::clear() {
+		m_frames.clear();
+	}
+
+	void InputRecording::dispatch(const InputFrame& frame,
+		ActiasFW::InputListener& listener) {
+		for (const InputEvent& event : frame.events) {
+			const ActiasFW::Controller controller
+				= (ActiasFW::Controller)event.controller;
+			switch (event.type) {
+			case INPUT_KEY_PRESSED:
+				listener.keyPressed((ActiasFW::KeyCode)event.code);
+				break;
+			case INPUT_KEY_RELEASED:
+				listener.keyReleased((ActiasFW::KeyCode)event.code);
+				break;
+			case INPUT_CHARACTER_TYPED:
+				listener.characterTyped((char)event.code);
+				break;
+			case INPUT_MOUSE_BUTTON_PRESSED:
+				listener.mouseButtonPressed(
+					(ActiasFW::MouseButtonCode)event.code);
+				break;
+			case INPUT_MOUSE_BUTTON_RELEASED:
+				listener.mouseButtonReleased(
+					(ActiasFW::MouseButtonCode)event.code);
+				break;
+			case INPUT_MOUSE_CURSOR_MOVED:
+				listener.mouseCursorMoved(event.value);
+				break;
+			case INPUT_MOUSE_SCROLLED:
+				listener.mouseScrolled(event.value);
+				break;
+			case INPUT_CONTROLLER_CONNECTED:
+				listener.controllerConnected(controller);
+				break;
+			case INPUT_CONTROLLER_DISCONNECTED:
+				listener.controllerDisconnected(controller);
+				break;
+			case INPUT_CONTROLLER_BUTTON_PRESSED:
+				listener.controllerButtonPressed(controller,
+					(ActiasFW::ControllerButtonCode)event.code);
+				break;
+			case INPUT_CONTROLLER_BUTTON_RELEASED:
+				listener.controllerButtonReleased(controller,
+					(ActiasFW::ControllerButtonCode)event.code);
+				break;
+			case INPUT_CONTROLLER_AXIS_MOVED:
+				listener.controllerAxisMoved(controller,
+					(ActiasFW::ControllerAxisCode)event.code, event.value.x);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	InputRecorder::~InputRecorder() {
+		stop();
+	}
+
+	bool InputRecorder::start(InputRecording& recording) {
+		stop();
+		if (!Application::Input.addListener(*this)) {
+			return false;
+		}
+		m_recording = &recording;
+		m_frame = 0;
+		m_pendingEvents.clear();
+		return true;
+	}
+
+	void InputRecorder::beginFrame() {
+		if (m_recording == 0) {
+			return;
+		}
+		m_frame = &m_recording->addFrame();
+		m_frame->events.swap(m_pendingEvents);
+		m_pendingEvents.clear();
+	}
+
+	void InputRecorder::addTimeStep(float timeStep) {
+		if (m_frame != 0) {
+			m_frame->timeSteps.push_back(timeStep);
+		}
+	}
+
+	void InputRecorder::stop() {
+		if (m_recording == 0) {
+			return;
+		}
+		Application::Input.removeListener(*this);
+		m_recording = 0;
+		m_frame = 0;
+		m_pendingEvents.clear();
+	}
+
+	bool InputRecorder::isRecording() const {
+		return m_recording != 0;
+	}
+
+	void InputRecorder::keyPressed(ActiasFW::KeyCode key) {
+		record(INPUT_KEY_PRESSED, key, 0, glm::vec2());
+	}
+
+	void InputRecorder::keyReleased(ActiasFW::KeyCode key) {
+		record(INPUT_KEY_RELEASED, key, 0, glm::vec2());
+	}
+
+	void InputRecorder::characterTyped(char character) {
+		record(INPUT_CHARACTER_TYPED, (unsigned char)character, 0,
+			glm::vec2());
+	}
+
+	void InputRecorder::mouseButtonPressed(ActiasFW::MouseButtonCode button) {
+		record(INPUT_MOUSE_BUTTON_PRESSED, button, 0, glm::vec2());
+	}
+
+	void InputRecorder::mouseButtonReleased(
+		ActiasFW::MouseButtonCode button) {
+		record(INPUT_MOUSE_BUTTON_RELEASED, button, 0, glm::vec2());
+	}
+
+	void InputRecorder::mouseCursorMoved(const glm::vec2& distance) {
+		record(INPUT_MOUSE_CURSOR_MOVED, 0, 0, distance);
+	}
+
+	void InputRecorder::mouseScrolled(const glm::vec2& distance) {
+		record(INPUT_MOUSE_SCROLLED, 0, 0, distance);
+	}
+
+	void InputRecorder::controllerConnected(ActiasFW::Controller controller) {
+		record(INPUT_CONTROLLER_CONNECTED, 0, controller, glm::vec2());
+	}
+
+	void InputRecorder::controllerDisconnected(
+		ActiasFW::Controller controller) {
+		record(INPUT_CONTROLLER_DISCONNECTED, 0, controller, glm::vec2());
+	}
+
+	void InputRecorder::controllerButtonPressed(
+		ActiasFW::Controller controller,
+		ActiasFW::ControllerButtonCode button) {
+		record(INPUT_CONTROLLER_BUTTON_PRESSED, button, controller,
+			glm::vec2());
+	}
+
+	void InputRecorder::controllerButtonReleased(
+		ActiasFW::Controller controller,
+		ActiasFW::ControllerButtonCode button) {
+		record(INPUT_CONTROLLER_BUTTON_RELEASED, button, controller,
+			glm::vec2());
+	}
+
+	void InputRecorder::controllerAxisMoved(ActiasFW::Controller controller,
+		ActiasFW::ControllerAxisCode axis, float distance) {
+		record(INPUT_CONTROLLER_AXIS_MOVED, axis, controller,
+			glm::vec2(distance, 0.0f));
+	}
+
+	void InputRecorder::record(InputEventType type, int32_t code,
+		int32_t controller, const glm::vec2& value) {
+		if (m_recording == 0) {
+			return;
+		}
+		InputEvent event;
+		event.type = type;
+		event.code = code;
+		event.controller = controller;
+		event.value = value;
+		m_pendingEvents.push_back(event);
+	}
+}
@@ -0,0 +1,197 @@
+/*
+File:		JobSystem.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@20:10
+Purpose:	Implementation of the work-stealing job system
+*/
+
+#include "JobSystem.h"
+
+#include <algorithm>
+
+namespace LunaLL {
+	namespace {
+		// The job system whose worker is the calling thread, or 0
+		thread_local const JobSystem* workerSystem = 0;
+		// The index of the calling worker thread's queue
+		thread_local unsigned int workerQueue = 0;
+	}
+
+	JobSystem JobSystem::Jobs;
+
+	JobSystem::~JobSystem() {
+		destroy();
+	}
+
+	bool JobSystem::initialize(const JobConfiguration& configuration) {
+		destroy();
+		m_configuration = configuration;
+		if (m_configuration.threadCount == 0) {
+			m_configuration.threadCount = std::max(
+				std::thread::hardware_concurrency(), 1u);
+		}
+		if (m_configuration.threadCount == 1) {
+			// A single thread runs loops serially and needs no workers
+			return true;
+		}
+
+		for (unsigned int i = 0; i < m_configuration.threadCount; i++) {
+			m_queues.push_back(std::make_unique<JobQueue>());
+		}
+		m_queuedJobs = 0;
+		m_sleepingThreads = 0;
+		m_running.store(true, std::memory_order_release);
+		for (unsigned int i = 0; i + 1 < m_configuration.threadCount; i++) {
+			m_threads.emplace_back(&JobSystem::work, this, i);
+		}
+		return true;
+	}
+
+	unsigned int JobSystem::getThreadCount() const {
+		return m_running.load(std::memory_order_acquire)
+			? m_configuration.threadCount : 1;
+	}
+
+	void JobSystem::destroy() {
+		if (!m_running.load(std::memory_order_acquire)) {
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_running.store(false, std::memory_order_release);
+		}
+		m_wake.notify_all();
+		for (std::thread& thread : m_threads) {
+			thread.join();
+		}
+		m_threads.clear();
+		m_queues.clear();
+	}
+
+	void JobSystem::run(size_t begin, size_t end, size_t grainSize,
+		const void* data, void (*function)(const void*, size_t, size_t)) {
+		if (end <= begin) {
+			return;
+		}
+		grainSize = std::max(grainSize, (size_t)1);
+		if (!m_running.load(std::memory_order_acquire)) {
+			for (size_t first = begin; first < end; first += grainSize) {
+				function(data, first, first + std::min(grainSize,
+					end - first));
+			}
+			return;
+		}
+
+		std::atomic<size_t> remaining = (end - begin + grainSize - 1)
+			/ grainSize;
+		Job job;
+		job.function = function;
+		job.data = data;
+		job.begin = begin;
+		job.end = end;
+		job.grainSize = grainSize;
+		job.remaining = &remaining;
+		const unsigned int queue = getQueue();
+		execute(queue, job);
+
+		// Help with this loop's jobs, or any others, until it finishes
+		while (remaining.load(std::memory_order_acquire) != 0) {
+			if (take(queue, job)) {
+				execute(queue, job);
+			}
+			else {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	unsigned int JobSystem::getQueue() const {
+		return workerSystem == this ? workerQueue
+			: (unsigned int)m_queues.size() - 1;
+	}
+
+	void JobSystem::push(unsigned int queue, const Job& job) {
+		{
+			std::lock_guard<std::mutex> lock(m_queues[queue]->mutex);
+			m_queues[queue]->jobs.push_back(job);
+			m_queuedJobs.fetch_add(1);
+		}
+		if (m_sleepingThreads.load() != 0) {
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+			m_wake.notify_one();
+		}
+	}
+
+	bool JobSystem::take(unsigned int queue, Job& job) {
+		if (m_queuedJobs.load(std::memory_order_relaxed) == 0) {
+			return false;
+		}
+		{
+			JobQueue& own = *m_queues[queue];
+			std::lock_guard<std::mutex> lock(own.mutex);
+			if (!own.jobs.empty()) {
+				job = own.jobs.back();
+				own.jobs.pop_back();
+				m_queuedJobs.fetch_sub(1);
+				return true;
+			}
+		}
+		const size_t queueCount = m_queues.size();
+		for (size_t i = 1; i < queueCount; i++) {
+			JobQueue& victim = *m_queues[(queue + i) % queueCount];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (!victim.jobs.empty()) {
+				job = victim.jobs.front();
+				victim.jobs.pop_front();
+				m_queuedJobs.fetch_sub(1);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void JobSystem::execute(unsigned int queue, Job job) {
+		// Sub-ranges are aligned to the grain from the start of the loop, so
+		// the split does not depend on which threads run the halves
+		while (job.end - job.begin > job.grainSize) {
+			const size_t grains = (job.end - job.begin + job.grainSize - 1)
+				/ job.grainSize;
+			Job upper = job;
+			upper.begin = job.begin + grains / 2 * job.grainSize;
+			push(queue, upper);
+			job.end = upper.begin;
+		}
+		job.function(job.data, job.begin, job.end);
+		job.remaining->fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	void JobSystem::work(unsigned int queue) {
+		workerSystem = this;
+		workerQueue = queue;
+		Job job;
+		unsigned int idle = 0;
+		while (m_running.load(std::memory_order_acquire)) {
+			if (take(queue, job)) {
+				execute(queue, job);
+				idle = 0;
+				continue;
+			}
+			if (++idle < m_configuration.spinCount) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			// The sleeping count is raised before the queued count is tested
+			// so a job pushed meanwhile either is seen or wakes this thread
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_sleepingThreads.fetch_add(1);
+			m_wake.wait(lock, [this]() {
+				return !m_running.load(std::memory_order_acquire)
+					|| m_queuedJobs.load() != 0;
+			});
+			m_sleepingThreads.fetch_sub(1);
+			idle = 0;
+		}
+		workerSystem = 0;
+	}
+}
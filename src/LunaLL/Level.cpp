@@ -0,0 +1,642 @@
+/*
+File:		Level.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@09:31
+Purpose:	Implementation of the chunked binary level format and level
+			streaming
+*/
+
+#include "Level.h"
+#include "AsyncLog.h"
+#include "JobSystem.h"
+#include "Viewport.h"
+
+#include <ActiasFW/ActiasFW.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+using ActiasFW::Application;
+
+namespace LunaLL {
+	namespace {
+		// The size of the fixed header at the start of a level file
+		constexpr uint32_t HEADER_SIZE = 64;
+		// The size of each entry in a level file's chunk index
+		constexpr uint32_t CHUNK_ENTRY_SIZE = 16;
+		// The largest chunk size which can be run length encoded
+		constexpr unsigned int MAXIMUM_CHUNK_SIZE = 256;
+
+		template <typename T>
+		void writeValue(std::ostream& stream, const T& value) {
+			stream.write((const char*)&value, sizeof(T));
+		}
+
+		template <typename T>
+		T readValue(const uint8_t* data) {
+			T value;
+			std::memcpy(&value, data, sizeof(T));
+			return value;
+		}
+
+		template <typename T>
+		void appendValue(std::vector<uint8_t>& data, const T& value) {
+			const uint8_t* bytes = (const uint8_t*)&value;
+			data.insert(data.end(), bytes, bytes + sizeof(T));
+		}
+	}
+
+	bool LevelWriter::initialize(const LevelProperties& properties) {
+		if (properties.dimensions.x == 0 || properties.dimensions.y == 0
+			|| properties.chunkSize == 0
+			|| properties.chunkSize > MAXIMUM_CHUNK_SIZE
+			|| properties.tileDimensions.x <= 0.0f
+			|| properties.tileDimensions.y <= 0.0f) {
+			LUNALL_LOG(LunaLL, ERROR, "Invalid level properties");
+			return false;
+		}
+		m_properties = properties;
+		m_tileKinds.clear();
+		m_initialized = true;
+		return true;
+	}
+
+	uint16_t LevelWriter::addTileKind(const TileKind& tileKind) {
+		if (m_tileKinds.size() >= EMPTY_TILE) {
+			return EMPTY_TILE;
+		}
+		m_tileKinds.push_back(tileKind);
+		return (uint16_t)(m_tileKinds.size() - 1);
+	}
+
+	bool LevelWriter::write(const std::string& fileName,
+		const std::function<uint16_t(unsigned int, unsigned int)>& getTile) {
+		if (!m_initialized) {
+			return false;
+		}
+		std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+		if (!file.good()) {
+			LUNALL_LOG(LunaLL, ERROR, "Failed to open level file \"",
+				fileName, "\" for writing");
+			return false;
+		}
+
+		const unsigned int chunkSize = m_properties.chunkSize;
+		const glm::uvec2 chunkCounts(
+			(m_properties.dimensions.x + chunkSize - 1) / chunkSize,
+			(m_properties.dimensions.y + chunkSize - 1) / chunkSize);
+		const uint64_t chunkCount = (uint64_t)chunkCounts.x * chunkCounts.y;
+
+		// Measure the tile kind table to place the chunk index after it
+		uint64_t tileKindTableSize = 0;
+		for (const TileKind& tileKind : m_tileKinds) {
+			tileKindTableSize += sizeof(uint32_t)
+				+ tileKind.textureFileName.size() + 7 * sizeof(uint32_t);
+		}
+		const uint64_t tileKindOffset = HEADER_SIZE;
+		const uint64_t chunkIndexOffset = tileKindOffset + tileKindTableSize;
+
+		file.write(LEVEL_FILE_MAGIC, sizeof(LEVEL_FILE_MAGIC));
+		writeValue(file, LEVEL_FORMAT_VERSION);
+		writeValue(file, HEADER_SIZE);
+		writeValue(file, (uint32_t)chunkSize);
+		writeValue(file, (uint32_t)m_properties.dimensions.x);
+		writeValue(file, (uint32_t)m_properties.dimensions.y);
+		writeValue(file, m_properties.position.x);
+		writeValue(file, m_properties.position.y);
+		writeValue(file, m_properties.position.z);
+		writeValue(file, m_properties.tileDimensions.x);
+		writeValue(file, m_properties.tileDimensions.y);
+		writeValue(file, (uint32_t)m_tileKinds.size());
+		writeValue(file, tileKindOffset);
+		writeValue(file, chunkIndexOffset);
+
+		for (const TileKind& tileKind : m_tileKinds) {
+			writeValue(file, (uint32_t)tileKind.textureFileName.size());
+			file.write(tileKind.textureFileName.data(),
+				tileKind.textureFileName.size());
+			for (int i = 0; i < 4; i++) {
+				writeValue(file, tileKind.textureBox[i]);
+			}
+			writeValue(file, (int32_t)tileKind.frameDimensions.x);
+			writeValue(file, (int32_t)tileKind.frameDimensions.y);
+			writeValue(file, tileKind.frameTime);
+		}
+
+		// Reserve the chunk index, it is filled in once the chunks are written
+		std::vector<uint8_t> chunkIndex;
+		chunkIndex.reserve(chunkCount * CHUNK_ENTRY_SIZE);
+		file.write(std::string(chunkCount * CHUNK_ENTRY_SIZE, '\0').data(),
+			chunkCount * CHUNK_ENTRY_SIZE);
+		uint64_t offset = chunkIndexOffset + chunkCount * CHUNK_ENTRY_SIZE;
+
+		std::vector<uint16_t> tiles(chunkSize * chunkSize);
+		std::vector<uint8_t> encoded;
+		for (unsigned int cy = 0; cy < chunkCounts.y; cy++) {
+			for (unsigned int cx = 0; cx < chunkCounts.x; cx++) {
+				bool empty = true;
+				for (unsigned int y = 0; y < chunkSize; y++) {
+					for (unsigned int x = 0; x < chunkSize; x++) {
+						unsigned int tileX = cx * chunkSize + x;
+						unsigned int tileY = cy * chunkSize + y;
+						uint16_t tile = EMPTY_TILE;
+						if (tileX < m_properties.dimensions.x
+							&& tileY < m_properties.dimensions.y) {
+							tile = getTile(tileX, tileY);
+							if (tile >= m_tileKinds.size()) {
+								tile = EMPTY_TILE;
+							}
+						}
+						tiles[y * chunkSize + x] = tile;
+						empty = empty && tile == EMPTY_TILE;
+					}
+				}
+				if (empty) {
+					appendValue(chunkIndex, (uint64_t)0);
+					appendValue(chunkIndex, (uint32_t)0);
+					appendValue(chunkIndex, (uint32_t)CHUNK_EMPTY);
+					continue;
+				}
+
+				// Run length encode the chunk and keep whichever encoding is
+				// smaller
+				encoded.clear();
+				for (size_t i = 0; i < tiles.size();) {
+					size_t run = 1;
+					while (i + run < tiles.size() && run < 0xFFFF
+						&& tiles[i + run] == tiles[i]) {
+						run++;
+					}
+					appendValue(encoded, (uint16_t)run);
+					appendValue(encoded, tiles[i]);
+					i += run;
+				}
+				uint32_t encoding = CHUNK_RUN_LENGTH;
+				if (encoded.size() >= tiles.size() * sizeof(uint16_t)) {
+					encoded.assign((const uint8_t*)tiles.data(),
+						(const uint8_t*)(tiles.data() + tiles.size()));
+					encoding = CHUNK_RAW;
+				}
+				file.write((const char*)encoded.data(), encoded.size());
+				appendValue(chunkIndex, offset);
+				appendValue(chunkIndex, (uint32_t)encoded.size());
+				appendValue(chunkIndex, encoding);
+				offset += encoded.size();
+			}
+		}
+
+		file.seekp((std::streamoff)chunkIndexOffset);
+		file.write((const char*)chunkIndex.data(), chunkIndex.size());
+		file.close();
+		if (file.fail()) {
+			LUNALL_LOG(LunaLL, ERROR, "Failed to write level file \"",
+				fileName, "\"");
+			return false;
+		}
+		return true;
+	}
+
+	bool LevelFile::open(const std::string& fileName) {
+		close();
+		if (!m_mapping.open(fileName)) {
+			LUNALL_LOG(LunaLL, ERROR, "Failed to map level file \"",
+				fileName, "\"");
+			return false;
+		}
+		const uint8_t* data = m_mapping.getData();
+		const uint64_t size = m_mapping.getSize();
+		if (size < HEADER_SIZE
+			|| std::memcmp(data, LEVEL_FILE_MAGIC, sizeof(LEVEL_FILE_MAGIC))
+			!= 0) {
+			LUNALL_LOG(LunaLL, ERROR, "\"", fileName,
+				"\" is not a level file");
+			close();
+			return false;
+		}
+		m_version = readValue<uint32_t>(data + 4);
+		const uint32_t headerSize = readValue<uint32_t>(data + 8);
+		if (m_version == 0 || m_version > LEVEL_FORMAT_VERSION
+			|| headerSize < HEADER_SIZE || headerSize > size) {
+			LUNALL_LOG(LunaLL, ERROR, "Level file \"", fileName,
+				"\" has unsupported version ", m_version);
+			close();
+			return false;
+		}
+
+		m_properties.chunkSize = readValue<uint32_t>(data + 12);
+		m_properties.dimensions.x = readValue<uint32_t>(data + 16);
+		m_properties.dimensions.y = readValue<uint32_t>(data + 20);
+		m_properties.position.x = readValue<float>(data + 24);
+		m_properties.position.y = readValue<float>(data + 28);
+		m_properties.position.z = readValue<float>(data + 32);
+		m_properties.tileDimensions.x = readValue<float>(data + 36);
+		m_properties.tileDimensions.y = readValue<float>(data + 40);
+		const uint32_t tileKindCount = readValue<uint32_t>(data + 44);
+		uint64_t tileKindOffset = readValue<uint64_t>(data + 48);
+		const uint64_t chunkIndexOffset = readValue<uint64_t>(data + 56);
+		if (m_properties.chunkSize == 0
+			|| m_properties.chunkSize > MAXIMUM_CHUNK_SIZE
+			|| m_properties.dimensions.x == 0
+			|| m_properties.dimensions.y == 0) {
+			LUNALL_LOG(LunaLL, ERROR, "Level file \"", fileName,
+				"\" has invalid properties");
+			close();
+			return false;
+		}
+		m_chunkCounts = glm::uvec2(
+			(m_properties.dimensions.x + m_properties.chunkSize - 1)
+			/ m_properties.chunkSize,
+			(m_properties.dimensions.y + m_properties.chunkSize - 1)
+			/ m_properties.chunkSize);
+
+		// Offsets are compared with the bytes left after them so corrupt
+		// offsets cannot overflow past the end of the file
+		m_tileKinds.reserve(tileKindCount);
+		for (uint32_t i = 0; i < tileKindCount; i++) {
+			if (tileKindOffset > size
+				|| size - tileKindOffset < sizeof(uint32_t)) {
+				break;
+			}
+			uint32_t nameLength = readValue<uint32_t>(data + tileKindOffset);
+			tileKindOffset += sizeof(uint32_t);
+			if ((uint64_t)nameLength + 7 * sizeof(uint32_t)
+				> size - tileKindOffset) {
+				break;
+			}
+			TileKind tileKind;
+			tileKind.textureFileName.assign(
+				(const char*)data + tileKindOffset, nameLength);
+			tileKindOffset += nameLength;
+			for (int j = 0; j < 4; j++) {
+				tileKind.textureBox[j] = readValue<float>(data + tileKindOffset);
+				tileKindOffset += sizeof(float);
+			}
+			tileKind.frameDimensions.x
+				= readValue<int32_t>(data + tileKindOffset);
+			tileKind.frameDimensions.y
+				= readValue<int32_t>(data + tileKindOffset + 4);
+			tileKind.frameTime = readValue<float>(data + tileKindOffset + 8);
+			tileKindOffset += 12;
+			m_tileKinds.push_back(tileKind);
+		}
+
+		const uint64_t chunkCount = (uint64_t)m_chunkCounts.x * m_chunkCounts.y;
+		if (m_tileKinds.size() != tileKindCount || chunkIndexOffset > size
+			|| chunkCount > (size - chunkIndexOffset) / CHUNK_ENTRY_SIZE) {
+			LUNALL_LOG(LunaLL, ERROR, "Level file \"", fileName,
+				"\" is truncated");
+			close();
+			return false;
+		}
+		m_chunkIndex = data + chunkIndexOffset;
+		return true;
+	}
+
+	void LevelFile::close() {
+		m_mapping.close();
+		m_version = 0;
+		m_properties = LevelProperties();
+		m_tileKinds.clear();
+		m_chunkCounts = glm::uvec2();
+		m_chunkIndex = 0;
+	}
+
+	bool LevelFile::isOpen() const {
+		return m_chunkIndex != 0;
+	}
+
+	uint32_t LevelFile::getVersion() const {
+		return m_version;
+	}
+
+	const LevelProperties& LevelFile::getProperties() const {
+		return m_properties;
+	}
+
+	const std::vector<TileKind>& LevelFile::getTileKinds() const {
+		return m_tileKinds;
+	}
+
+	const glm::uvec2& LevelFile::getChunkCounts() const {
+		return m_chunkCounts;
+	}
+
+	bool LevelFile::isChunkEmpty(const glm::uvec2& chunk) const {
+		uint64_t offset = 0;
+		uint32_t size = 0, encoding = CHUNK_EMPTY;
+		return !getChunkEntry(chunk, offset, size, encoding)
+			|| encoding == CHUNK_EMPTY;
+	}
+
+	bool LevelFile::decodeChunk(const glm::uvec2& chunk,
+		std::vector<uint16_t>& tiles) const {
+		uint64_t offset = 0;
+		uint32_t size = 0, encoding = CHUNK_EMPTY;
+		if (!getChunkEntry(chunk, offset, size, encoding)) {
+			return false;
+		}
+		if (encoding == CHUNK_EMPTY) {
+			tiles.clear();
+			return true;
+		}
+		const uint64_t fileSize = m_mapping.getSize();
+		if (offset > fileSize || size > fileSize - offset) {
+			return false;
+		}
+
+		const size_t tileCount
+			= (size_t)m_properties.chunkSize * m_properties.chunkSize;
+		const uint8_t* data = m_mapping.getData() + offset;
+		tiles.resize(tileCount);
+		if (encoding == CHUNK_RAW) {
+			if (size != tileCount * sizeof(uint16_t)) {
+				return false;
+			}
+			std::memcpy(tiles.data(), data, size);
+			return true;
+		}
+		else if (encoding == CHUNK_RUN_LENGTH) {
+			size_t tile = 0;
+			for (uint32_t i = 0; i + 4 <= size; i += 4) {
+				uint16_t run = readValue<uint16_t>(data + i);
+				uint16_t kind = readValue<uint16_t>(data + i + 2);
+				if (tile + run > tileCount) {
+					return false;
+				}
+				std::fill_n(tiles.begin() + tile, run, kind);
+				tile += run;
+			}
+			return tile == tileCount;
+		}
+		return false;
+	}
+
+	bool LevelFile::getChunkEntry(const glm::uvec2& chunk, uint64_t& offset,
+		uint32_t& size, uint32_t& encoding) const {
+		if (m_chunkIndex == 0 || chunk.x >= m_chunkCounts.x
+			|| chunk.y >= m_chunkCounts.y) {
+			return false;
+		}
+		const uint8_t* entry = m_chunkIndex
+			+ ((uint64_t)chunk.y * m_chunkCounts.x + chunk.x) * CHUNK_ENTRY_SIZE;
+		offset = readValue<uint64_t>(entry);
+		size = readValue<uint32_t>(entry + 8);
+		encoding = readValue<uint32_t>(entry + 12);
+		return true;
+	}
+
+	bool Level::initialize(const std::string& fileName,
+		LevelLoadMode loadMode) {
+		if (m_initialized) {
+			destroy();
+		}
+		if (!m_file.open(fileName)) {
+			return false;
+		}
+		const glm::uvec2& dimensions = m_file.getProperties().dimensions;
+		m_streamed = loadMode == LOAD_STREAMED || (loadMode == LOAD_AUTOMATIC
+			&& (size_t)dimensions.x * dimensions.y > FULL_LOAD_TILE_LIMIT);
+		m_updateCount = 0;
+		m_statistics = LevelStatistics();
+		m_initialized = true;
+
+		if (!m_streamed) {
+			const glm::uvec2& chunkCounts = m_file.getChunkCounts();
+			for (unsigned int y = 0; y < chunkCounts.y; y++) {
+				for (unsigned int x = 0; x < chunkCounts.x; x++) {
+					loadChunk(glm::uvec2(x, y));
+				}
+			}
+		}
+		return true;
+	}
+
+	void Level::update(const ActiasFW::Camera& camera, float timeStep) {
+		update(getVisibleBox(camera), timeStep);
+	}
+
+	void Level::update(const glm::vec4& visibleBox, float timeStep) {
+		if (!m_initialized) {
+			return;
+		}
+		m_updateCount++;
+
+		if (m_streamed) {
+			const LevelProperties& properties = m_file.getProperties();
+			const glm::ivec2 chunkCounts(m_file.getChunkCounts());
+			const glm::vec2 chunkDimensions = properties.tileDimensions
+				* (float)properties.chunkSize;
+			const glm::vec2 origin(properties.position);
+			const glm::vec2 low = glm::floor((glm::vec2(visibleBox) - origin)
+				/ chunkDimensions);
+			const glm::vec2 high = glm::floor((glm::vec2(visibleBox)
+				+ glm::vec2(visibleBox.z, visibleBox.w) - origin)
+				/ chunkDimensions);
+
+			// Clamp the chunks in view to the margin past the level's edges,
+			// so a box far off the level or not finite visits no chunks
+			// outside it
+			const int margin = (int)std::min(m_streamingMargin,
+				(unsigned int)std::max(chunkCounts.x, chunkCounts.y));
+			const glm::vec2 lowest((float)(-1 - margin));
+			const glm::vec2 highest(chunkCounts + margin);
+			glm::ivec2 first(lowest), last(lowest);
+			if (std::isfinite(low.x) && std::isfinite(low.y)
+				&& std::isfinite(high.x) && std::isfinite(high.y)) {
+				first = glm::ivec2(glm::clamp(low, lowest, highest));
+				last = glm::ivec2(glm::clamp(high, lowest, highest));
+			}
+			const glm::ivec2 begin = glm::max(first - margin, glm::ivec2(0));
+			const glm::ivec2 end = glm::min(last + margin, chunkCounts
+				- glm::ivec2(1));
+
+			// Decode every chunk in view, then prefetch the chunks around it
+			unsigned int prefetched = 0;
+			for (int y = begin.y; y <= end.y; y++) {
+				for (int x = begin.x; x <= end.x; x++) {
+					glm::uvec2 chunk(x, y);
+					const uint64_t key = GetChunkKey(chunk);
+					std::unordered_map<uint64_t, Chunk>::iterator it
+						= m_chunks.find(key);
+					if (it != m_chunks.end()) {
+						it->second.lastUsed = m_updateCount;
+						continue;
+					}
+					if (m_failedChunks.count(key) != 0) {
+						continue;
+					}
+					bool visible = x >= first.x && x <= last.x
+						&& y >= first.y && y <= last.y;
+					if (!visible && prefetched >= m_prefetchBudget) {
+						continue;
+					}
+					if (!m_file.isChunkEmpty(chunk) && !visible) {
+						prefetched++;
+					}
+					loadChunk(chunk);
+				}
+			}
+
+			for (std::unordered_map<uint64_t, Chunk>::iterator it
+				= m_chunks.begin(); it != m_chunks.end();) {
+				if (it->second.lastUsed != m_updateCount) {
+					ReleaseChunk(it->second);
+					it = m_chunks.erase(it);
+					m_statistics.chunksEvicted++;
+				}
+				else {
+					it++;
+				}
+			}
+		}
+
+		// Each job updates whole chunks, relying on an ActiasFW animation's
+		// update changing only that animation, as JobSystem::updateEntities
+		// does
+		m_animatedChunks.clear();
+		for (std::pair<const uint64_t, Chunk>& chunk : m_chunks) {
+			if (!chunk.second.animations.empty()) {
+				m_animatedChunks.push_back(&chunk.second.animations);
+			}
+		}
+		JobSystem::Jobs.parallelFor(0, m_animatedChunks.size(), 1,
+			[this, timeStep](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; i++) {
+					for (ActiasFW::Animation& animation
+						: *m_animatedChunks[i]) {
+						animation.update(timeStep);
+					}
+				}
+			});
+	}
+
+	void Level::draw(ActiasFW::GLSLShader& shader) {
+		for (std::pair<const uint64_t, Chunk>& chunk : m_chunks) {
+			if (!chunk.second.sprites.empty()) {
+				Application::Graphics.submit(chunk.second.sprites, shader);
+			}
+			if (!chunk.second.animations.empty()) {
+				Application::Graphics.submit(chunk.second.animations, shader);
+			}
+		}
+	}
+
+	void Level::draw() {
+		draw(Application::Graphics.getDefaultShader());
+	}
+
+	void Level::destroy() {
+		for (std::pair<const uint64_t, Chunk>& chunk : m_chunks) {
+			ReleaseChunk(chunk.second);
+		}
+		m_chunks.clear();
+		m_failedChunks.clear();
+		m_decodeBuffer.clear();
+		m_animatedChunks.clear();
+		m_file.close();
+		m_streamed = false;
+		m_initialized = false;
+	}
+
+	bool Level::isStreamed() const {
+		return m_streamed;
+	}
+
+	unsigned int Level::getStreamingMargin() const {
+		return m_streamingMargin;
+	}
+
+	void Level::setStreamingMargin(unsigned int streamingMargin) {
+		m_streamingMargin = streamingMargin;
+	}
+
+	unsigned int Level::getPrefetchBudget() const {
+		return m_prefetchBudget;
+	}
+
+	void Level::setPrefetchBudget(unsigned int prefetchBudget) {
+		m_prefetchBudget = prefetchBudget;
+	}
+
+	size_t Level::getResidentChunkCount() const {
+		return m_chunks.size();
+	}
+
+	const LevelStatistics& Level::getStatistics() const {
+		return m_statistics;
+	}
+
+	const LevelFile& Level::getFile() const {
+		return m_file;
+	}
+
+	bool Level::loadChunk(const glm::uvec2& chunk) {
+		std::chrono::steady_clock::time_point start
+			= std::chrono::steady_clock::now();
+		if (!m_file.decodeChunk(chunk, m_decodeBuffer)) {
+			LUNALL_LOG(LunaLL, ERROR, "Failed to decode level chunk (",
+				chunk.x, ", ", chunk.y, ")");
+			m_failedChunks.insert(GetChunkKey(chunk));
+			m_statistics.chunksFailed++;
+			return false;
+		}
+
+		Chunk& resident = m_chunks[GetChunkKey(chunk)];
+		resident.lastUsed = m_updateCount;
+		const LevelProperties& properties = m_file.getProperties();
+		const std::vector<TileKind>& tileKinds = m_file.getTileKinds();
+		for (size_t i = 0; i < m_decodeBuffer.size(); i++) {
+			uint16_t kind = m_decodeBuffer[i];
+			if (kind >= tileKinds.size()) {
+				continue;
+			}
+			const TileKind& tileKind = tileKinds[kind];
+			glm::vec3 position = properties.position + glm::vec3(
+				glm::vec2(chunk.x * properties.chunkSize
+					+ i % properties.chunkSize,
+				chunk.y * properties.chunkSize + i / properties.chunkSize)
+				* properties.tileDimensions, 0.0f);
+			if (tileKind.frameDimensions.x * tileKind.frameDimensions.y > 1) {
+				resident.animations.emplace_back();
+				ActiasFW::Animation& animation = resident.animations.back();
+				animation.initialize(position, properties.tileDimensions,
+					tileKind.textureFileName, tileKind.frameDimensions,
+					tileKind.frameTime);
+				animation.play();
+			}
+			else {
+				resident.sprites.emplace_back();
+				ActiasFW::Sprite& sprite = resident.sprites.back();
+				sprite.initialize(position, properties.tileDimensions,
+					tileKind.textureFileName);
+				sprite.setTextureBox(tileKind.textureBox);
+			}
+		}
+
+		double decodeTime = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+		m_statistics.chunksDecoded++;
+		m_statistics.totalDecodeTime += decodeTime;
+		m_statistics.maximumDecodeTime = std::max(
+			m_statistics.maximumDecodeTime, decodeTime);
+		return true;
+	}
+
+	void Level::ReleaseChunk(Chunk& chunk) {
+		for (ActiasFW::Sprite& sprite : chunk.sprites) {
+			sprite.destroy();
+		}
+		for (ActiasFW::Animation& animation : chunk.animations) {
+			animation.destroy();
+		}
+		chunk.sprites.clear();
+		chunk.animations.clear();
+	}
+
+	uint64_t Level::GetChunkKey(const glm::uvec2& chunk) {
+		return ((uint64_t)chunk.y << 32) | chunk.x;
+	}
+}
@@ -0,0 +1,363 @@
+/*
+File:		Profiler.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@18:40
+Purpose:	Implementation of the frame histograms and frame profiler
+*/
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace LunaLL {
+	namespace {
+		// The index of the next thread to time a zone
+		std::atomic<unsigned int> nextThreadIndex = 0;
+		// The index of the calling thread in trace events
+		thread_local const unsigned int threadIndex = nextThreadIndex++;
+
+		/*
+		Get the bucket of a histogram counting a duration
+		Parameter: double milliseconds - The duration
+		Returns: unsigned int - The index of the bucket
+		*/
+		unsigned int getBucket(double milliseconds) {
+			const double microseconds = milliseconds * 1000.0;
+			if (microseconds < 1.0) {
+				return 0;
+			}
+			const unsigned int bucket = 1 + (unsigned int)(std::log2(
+				microseconds) * FrameHistogram::BUCKETS_PER_OCTAVE);
+			return std::min(bucket, FrameHistogram::BUCKET_COUNT - 1);
+		}
+
+		/*
+		Get the duration represented by a bucket of a histogram, the middle of
+		its range
+		Parameter: unsigned int bucket - The index of the bucket
+		Returns: double - The duration in milliseconds
+		*/
+		double getBucketDuration(unsigned int bucket) {
+			if (bucket == 0) {
+				return 0.0005;
+			}
+			return std::exp2((bucket - 0.5)
+				/ FrameHistogram::BUCKETS_PER_OCTAVE) / 1000.0;
+		}
+
+		/*
+		Append a string to JSON output as a quoted, escaped string
+		Parameter: std::string& output - The output
+		Parameter: const std::string& text - The string to append
+		*/
+		void appendJSONString(std::string& output, const std::string& text) {
+			output += '"';
+			for (char character : text) {
+				if (character == '"' || character == '\\') {
+					output += '\\';
+					output += character;
+				}
+				else if ((unsigned char)character < 0x20) {
+					char escape[8] = "";
+					std::snprintf(escape, sizeof(escape), "\\u%04x",
+						(unsigned int)character);
+					output += escape;
+				}
+				else {
+					output += character;
+				}
+			}
+			output += '"';
+		}
+	}
+
+	FrameProfiler FrameProfiler::Profiler;
+
+	void FrameHistogram::add(double milliseconds) {
+		m_buckets[getBucket(milliseconds)]++;
+		m_count++;
+		m_total += milliseconds;
+		m_maximum = std::max(m_maximum, milliseconds);
+	}
+
+	double FrameHistogram::getPercentile(double percentile) const {
+		if (m_count == 0) {
+			return 0.0;
+		}
+		const uint64_t rank = std::clamp((uint64_t)std::ceil(percentile
+			/ 100.0 * m_count), (uint64_t)1, m_count);
+		uint64_t counted = 0;
+		for (unsigned int bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+			counted += m_buckets[bucket];
+			if (counted >= rank) {
+				return std::min(getBucketDuration(bucket), m_maximum);
+			}
+		}
+		return m_maximum;
+	}
+
+	uint64_t FrameHistogram::getCount() const {
+		return m_count;
+	}
+
+	double FrameHistogram::getMean() const {
+		return m_count != 0 ? m_total / m_count : 0.0;
+	}
+
+	double FrameHistogram::getMaximum() const {
+		return m_maximum;
+	}
+
+	void FrameHistogram::clear() {
+		m_buckets.fill(0);
+		m_count = 0;
+		m_total = 0.0;
+		m_maximum = 0.0;
+	}
+
+	FrameProfiler::FrameProfiler() {
+		addZoneName("Frame");
+		addZoneName("Input");
+		addZoneName("Update");
+		addZoneName("Draw");
+		addZoneName("Present");
+	}
+
+	void FrameProfiler::initialize(
+		const ProfilerConfiguration& configuration) {
+		destroy();
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_configuration = configuration;
+		m_startTime = getTime();
+		m_enabled.store(configuration.enabled, std::memory_order_relaxed);
+	}
+
+	void FrameProfiler::setEnabled(bool enabled) {
+		m_enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	unsigned int FrameProfiler::getZone(const std::string& name) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::vector<std::string>::const_iterator it = std::find(
+			m_zoneNames.begin(), m_zoneNames.end(), name);
+		if (it != m_zoneNames.end()) {
+			return (unsigned int)(it - m_zoneNames.begin());
+		}
+		return addZoneName(name);
+	}
+
+	void FrameProfiler::beginFrame() {
+		if (!isEnabled()) {
+			return;
+		}
+		endFrame();
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_frameStart = getTime();
+	}
+
+	void FrameProfiler::endFrame() {
+		const int64_t end = getTime();
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_frameStart == 0) {
+			return;
+		}
+
+		// Merge the zones each thread timed, then forget the exited threads
+		for (const std::shared_ptr<ThreadZones>& zones : m_threadZones) {
+			std::lock_guard<std::mutex> zonesLock(zones->mutex);
+			for (size_t zone = 0; zone < zones->totals.size(); zone++) {
+				if (zones->timed[zone]) {
+					m_frameTotals[zone] += zones->totals[zone];
+					m_frameTimed[zone] = true;
+					zones->totals[zone] = 0;
+					zones->timed[zone] = false;
+				}
+			}
+			m_trace.insert(m_trace.end(), zones->trace.begin(),
+				zones->trace.end());
+			zones->trace.clear();
+		}
+		m_threadZones.erase(std::remove_if(m_threadZones.begin(),
+			m_threadZones.end(), [](const std::shared_ptr<ThreadZones>& zones) {
+				return zones->closed.load(std::memory_order_acquire);
+			}), m_threadZones.end());
+
+		m_frameTotals[FRAME_ZONE] = end - m_frameStart;
+		m_frameTimed[FRAME_ZONE] = true;
+		for (size_t zone = 0; zone < m_frameTotals.size(); zone++) {
+			if (m_frameTimed[zone]) {
+				m_histograms[zone].add(m_frameTotals[zone] / 1.0e6);
+				m_frameTotals[zone] = 0;
+				m_frameTimed[zone] = false;
+			}
+		}
+		if (m_configuration.tracing) {
+			TraceEvent event;
+			event.zone = FRAME_ZONE;
+			event.thread = threadIndex;
+			event.start = m_frameStart;
+			event.duration = end - m_frameStart;
+			addTraceEvent(m_trace, event);
+		}
+		m_frameStart = 0;
+		m_frameCount++;
+	}
+
+	void FrameProfiler::addZone(unsigned int zone, int64_t start,
+		int64_t end) {
+		if (zone >= m_zoneCount.load(std::memory_order_acquire)) {
+			return;
+		}
+		ThreadZones& zones = getThreadZones();
+		std::lock_guard<std::mutex> lock(zones.mutex);
+		if (zone >= zones.totals.size()) {
+			zones.totals.resize(zone + 1, 0);
+			zones.timed.resize(zone + 1, false);
+		}
+		zones.totals[zone] += end - start;
+		zones.timed[zone] = true;
+		if (m_configuration.tracing) {
+			TraceEvent event;
+			event.zone = zone;
+			event.thread = threadIndex;
+			event.start = start;
+			event.duration = end - start;
+			addTraceEvent(zones.trace, event);
+		}
+	}
+
+	unsigned int FrameProfiler::getZoneCount() const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return (unsigned int)m_zoneNames.size();
+	}
+
+	std::string FrameProfiler::getZoneName(unsigned int zone) const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return zone < m_zoneNames.size() ? m_zoneNames[zone] : "";
+	}
+
+	FrameHistogram FrameProfiler::getHistogram(unsigned int zone) const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return zone < m_histograms.size() ? m_histograms[zone]
+			: FrameHistogram();
+	}
+
+	uint64_t FrameProfiler::getFrameCount() const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_frameCount;
+	}
+
+	uint64_t FrameProfiler::getDroppedTraceEventCount() const {
+		return m_droppedTraceEvents.load(std::memory_order_relaxed);
+	}
+
+	bool FrameProfiler::exportChromeTrace(const std::string& fileName) const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::ofstream file(fileName, std::ios::trunc);
+		if (!file.good()) {
+			return false;
+		}
+
+		// Events are complete ("X") events with times in microseconds since
+		// this profiler was initialized
+		std::string output = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+		char times[96] = "";
+		for (size_t i = 0; i < m_trace.size(); i++) {
+			const TraceEvent& event = m_trace[i];
+			output += i == 0 ? "\n{\"name\":" : ",\n{\"name\":";
+			appendJSONString(output, m_zoneNames[event.zone]);
+			std::snprintf(times, sizeof(times), ",\"ph\":\"X\",\"pid\":1,"
+				"\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", event.thread,
+				(event.start - m_startTime) / 1000.0,
+				event.duration / 1000.0);
+			output += times;
+			if (output.size() > (1 << 20)) {
+				file << output;
+				output.clear();
+			}
+		}
+		output += "\n]}\n";
+		file << output;
+		return file.good();
+	}
+
+	void FrameProfiler::destroy() {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_enabled.store(false, std::memory_order_relaxed);
+		std::fill(m_frameTotals.begin(), m_frameTotals.end(), 0);
+		std::fill(m_frameTimed.begin(), m_frameTimed.end(), false);
+		for (FrameHistogram& histogram : m_histograms) {
+			histogram.clear();
+		}
+		m_frameStart = 0;
+		m_frameCount = 0;
+		m_threadZones.clear();
+		m_generation.fetch_add(1, std::memory_order_release);
+		m_trace.clear();
+		m_trace.shrink_to_fit();
+		m_traceEventCount.store(0, std::memory_order_relaxed);
+		m_droppedTraceEvents.store(0, std::memory_order_relaxed);
+	}
+
+	int64_t FrameProfiler::getTime() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	unsigned int FrameProfiler::addZoneName(const std::string& name) {
+		m_zoneNames.push_back(name);
+		m_frameTotals.push_back(0);
+		m_frameTimed.push_back(false);
+		m_histograms.push_back(FrameHistogram());
+		m_zoneCount.store((unsigned int)m_zoneNames.size(),
+			std::memory_order_release);
+		return (unsigned int)(m_zoneNames.size() - 1);
+	}
+
+	FrameProfiler::ThreadZones& FrameProfiler::getThreadZones() {
+		// The calling thread's zones, closed when the thread exits
+		struct Handle {
+			// The profiler the zones belong to
+			FrameProfiler* profiler = 0;
+			// The run of the profiler the zones belong to
+			uint32_t generation = 0;
+			// The zones
+			std::shared_ptr<ThreadZones> zones;
+
+			~Handle() {
+				if (zones != 0) {
+					zones->closed.store(true, std::memory_order_release);
+				}
+			}
+		};
+		thread_local Handle handle;
+
+		if (handle.profiler == this && handle.generation
+			== m_generation.load(std::memory_order_acquire)) {
+			return *handle.zones;
+		}
+		if (handle.zones != 0) {
+			handle.zones->closed.store(true, std::memory_order_release);
+		}
+		handle.zones = std::make_shared<ThreadZones>();
+		handle.profiler = this;
+		std::lock_guard<std::mutex> lock(m_mutex);
+		handle.generation = m_generation.load(std::memory_order_relaxed);
+		m_threadZones.push_back(handle.zones);
+		return *handle.zones;
+	}
+
+	void FrameProfiler::addTraceEvent(std::vector<TraceEvent>& trace,
+		const TraceEvent& event) {
+		if (m_traceEventCount.fetch_add(1, std::memory_order_relaxed)
+			>= m_configuration.maximumTraceEvents) {
+			m_droppedTraceEvents.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		trace.push_back(event);
+	}
+}
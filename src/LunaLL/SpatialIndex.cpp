@@ -0,0 +1,235 @@
+/*
+File:		SpatialIndex.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@13:10
+Purpose:	Implementation of the loose grid spatial index
+*/
+
+#include "SpatialIndex.h"
+#include "Viewport.h"
+
+#include <ActiasFW/ActiasFW.h>
+
+using ActiasFW::Application;
+
+namespace LunaLL {
+	void SpatialIndex::initialize(const glm::vec2& cellDimensions) {
+		destroy();
+		m_cellDimensions = glm::max(cellDimensions, glm::vec2(1.0e-3f));
+	}
+
+	unsigned int SpatialIndex::insert(ActiasFW::Entity& entity,
+		const glm::vec4& box) {
+		if (!IsFinite(box)) {
+			return INVALID_ID;
+		}
+		unsigned int ID = 0;
+		if (!m_freeIDs.empty()) {
+			ID = m_freeIDs.back();
+			m_freeIDs.pop_back();
+		}
+		else {
+			if (m_entries.size() >= INVALID_ID) {
+				return INVALID_ID;
+			}
+			ID = (unsigned int)m_entries.size();
+			m_entries.emplace_back();
+		}
+
+		Entry& entry = m_entries[ID];
+		entry = Entry();
+		entry.entity = &entity;
+		entry.box = box;
+		m_maximumHalfExtent = glm::max(m_maximumHalfExtent,
+			glm::vec2(box.z, box.w) * 0.5f);
+		link(ID);
+		m_size++;
+		return ID;
+	}
+
+	unsigned int SpatialIndex::insert(ActiasFW::Sprite& sprite) {
+		unsigned int ID = insert(sprite, glm::vec4(
+			glm::vec2(sprite.getPosition()), sprite.getDimensions()));
+		if (ID != INVALID_ID) {
+			m_entries[ID].sprite = &sprite;
+		}
+		return ID;
+	}
+
+	bool SpatialIndex::update(unsigned int ID, const glm::vec4& box) {
+		if (ID >= m_entries.size() || m_entries[ID].entity == 0
+			|| !IsFinite(box)) {
+			return false;
+		}
+		Entry& entry = m_entries[ID];
+		entry.box = box;
+		m_maximumHalfExtent = glm::max(m_maximumHalfExtent,
+			glm::vec2(box.z, box.w) * 0.5f);
+		if (getCellKey(glm::vec2(box) + glm::vec2(box.z, box.w) * 0.5f)
+			!= entry.cell) {
+			unlink(ID);
+			link(ID);
+		}
+		return true;
+	}
+
+	bool SpatialIndex::update(unsigned int ID) {
+		if (ID >= m_entries.size() || m_entries[ID].sprite == 0) {
+			return false;
+		}
+		const ActiasFW::Sprite& sprite = *m_entries[ID].sprite;
+		return update(ID, glm::vec4(glm::vec2(sprite.getPosition()),
+			sprite.getDimensions()));
+	}
+
+	bool SpatialIndex::remove(unsigned int ID) {
+		if (ID >= m_entries.size() || m_entries[ID].entity == 0) {
+			return false;
+		}
+		unlink(ID);
+		m_entries[ID].entity = 0;
+		m_entries[ID].sprite = 0;
+		m_freeIDs.push_back(ID);
+		m_size--;
+		return true;
+	}
+
+	void SpatialIndex::query(const glm::vec4& box,
+		std::vector<unsigned int>& IDs) const {
+		IDs.clear();
+		forEach(box, [&IDs](unsigned int ID) {
+			IDs.push_back(ID);
+		});
+	}
+
+	void SpatialIndex::query(const glm::vec2& point,
+		std::vector<unsigned int>& IDs) const {
+		IDs.clear();
+		forEachCell(glm::vec4(point, 0.0f, 0.0f), [this, &point, &IDs](
+			const std::vector<unsigned int>& cell) {
+			for (unsigned int ID : cell) {
+				const glm::vec4& box = m_entries[ID].box;
+				if (point.x >= box.x && point.x < box.x + box.z
+					&& point.y >= box.y && point.y < box.y + box.w) {
+					IDs.push_back(ID);
+				}
+			}
+		});
+	}
+
+	void SpatialIndex::query(const ActiasFW::Camera& camera,
+		std::vector<unsigned int>& IDs) const {
+		query(getVisibleBox(camera), IDs);
+	}
+
+	void SpatialIndex::findIntersections(unsigned int ID,
+		std::vector<unsigned int>& IDs) const {
+		IDs.clear();
+		if (ID >= m_entries.size() || m_entries[ID].entity == 0) {
+			return;
+		}
+		forEach(m_entries[ID].box, [ID, &IDs](unsigned int other) {
+			if (other != ID) {
+				IDs.push_back(other);
+			}
+		});
+	}
+
+	void SpatialIndex::findIntersections(
+		std::vector<std::pair<unsigned int, unsigned int>>& pairs) const {
+		pairs.clear();
+		for (unsigned int ID = 0; ID < m_entries.size(); ID++) {
+			if (m_entries[ID].entity == 0) {
+				continue;
+			}
+			forEach(m_entries[ID].box, [ID, &pairs](unsigned int other) {
+				if (other > ID) {
+					pairs.push_back(std::pair<unsigned int, unsigned int>(ID,
+						other));
+				}
+			});
+		}
+	}
+
+	void SpatialIndex::submit(const ActiasFW::Camera& camera,
+		ActiasFW::GLSLShader& shader) {
+		forEach(getVisibleBox(camera), [this, &shader](unsigned int ID) {
+			if (m_entries[ID].sprite != 0) {
+				Application::Graphics.submit(*m_entries[ID].sprite, shader);
+			}
+		});
+	}
+
+	void SpatialIndex::submit(ActiasFW::GLSLShader& shader) {
+		submit(shader.getCamera(), shader);
+	}
+
+	void SpatialIndex::submit() {
+		submit(Application::Graphics.getDefaultCamera(),
+			Application::Graphics.getDefaultShader());
+	}
+
+	void SpatialIndex::destroy() {
+		m_entries.clear();
+		m_freeIDs.clear();
+		m_cells.clear();
+		m_maximumHalfExtent = glm::vec2();
+		m_size = 0;
+		m_lifetime = std::make_shared<bool>(true);
+	}
+
+	ActiasFW::Entity* SpatialIndex::getEntity(unsigned int ID) const {
+		return ID < m_entries.size() ? m_entries[ID].entity : 0;
+	}
+
+	ActiasFW::Sprite* SpatialIndex::getSprite(unsigned int ID) const {
+		return ID < m_entries.size() ? m_entries[ID].sprite : 0;
+	}
+
+	const glm::vec4& SpatialIndex::getBox(unsigned int ID) const {
+		return m_entries[ID].box;
+	}
+
+	size_t SpatialIndex::getSize() const {
+		return m_size;
+	}
+
+	std::weak_ptr<const bool> SpatialIndex::getLifetime() const {
+		return m_lifetime;
+	}
+
+	glm::ivec2 SpatialIndex::getCell(const glm::vec2& point) const {
+		// Clamping before the cast keeps far away and infinite quotients in
+		// the range of an int
+		return glm::ivec2(glm::clamp(glm::floor(point / m_cellDimensions),
+			glm::vec2((float)-CELL_LIMIT), glm::vec2((float)CELL_LIMIT)));
+	}
+
+	uint64_t SpatialIndex::getCellKey(const glm::vec2& point) const {
+		const glm::ivec2 cell = getCell(point);
+		return ((uint64_t)(uint32_t)cell.y << 32) | (uint32_t)cell.x;
+	}
+
+	void SpatialIndex::link(unsigned int ID) {
+		Entry& entry = m_entries[ID];
+		entry.cell = getCellKey(glm::vec2(entry.box)
+			+ glm::vec2(entry.box.z, entry.box.w) * 0.5f);
+		std::vector<unsigned int>& cell = m_cells[entry.cell];
+		entry.cellIndex = cell.size();
+		cell.push_back(ID);
+	}
+
+	void SpatialIndex::unlink(unsigned int ID) {
+		Entry& entry = m_entries[ID];
+		std::unordered_map<uint64_t, std::vector<unsigned int>>::iterator it
+			= m_cells.find(entry.cell);
+		std::vector<unsigned int>& cell = it->second;
+		unsigned int last = cell.back();
+		cell[entry.cellIndex] = last;
+		m_entries[last].cellIndex = entry.cellIndex;
+		cell.pop_back();
+		if (cell.empty()) {
+			m_cells.erase(it);
+		}
+	}
+}
@@ -0,0 +1,496 @@
+/*
+File:		SpriteBatch.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@11:20
+Purpose:	Implementation of the retained sprite batch
+*/
+
+#include "SpriteBatch.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace LunaLL {
+	const std::vector<unsigned int> SpriteBatch::VERTEX_ATTRIBUTE_SIZES
+		= { 3, 2, 4 };
+
+	void SpriteBatch::initialize(TextureCache& textures) {
+		destroy();
+		m_textures = &textures;
+	}
+
+	unsigned int SpriteBatch::add(ActiasFW::Sprite& sprite,
+		ActiasFW::GLSLShader& shader) {
+		unsigned int ID = 0;
+		if (!m_freeIDs.empty()) {
+			ID = m_freeIDs.back();
+			m_freeIDs.pop_back();
+		}
+		else {
+			if (m_entries.size() >= INVALID_ID / 4) {
+				return INVALID_ID;
+			}
+			ID = (unsigned int)m_entries.size();
+			m_entries.emplace_back();
+			m_vertices.resize(m_vertices.size() + 4);
+		}
+
+		Entry& entry = m_entries[ID];
+		entry = Entry();
+		entry.used = true;
+		entry.sprite = &sprite;
+		entry.shader = getShaderIndex(shader);
+		entry.texture = getTextureIndex(sprite.getTextureFileName());
+		m_orderChanged = true;
+		m_statistics.spriteCount++;
+		return ID;
+	}
+
+	unsigned int SpriteBatch::addQuad(const SpriteBatchQuad& quad,
+		GLuint texture, ActiasFW::GLSLShader& shader) {
+		unsigned int ID = 0;
+		if (!m_freeIDs.empty()) {
+			ID = m_freeIDs.back();
+			m_freeIDs.pop_back();
+		}
+		else {
+			if (m_entries.size() >= INVALID_ID / 4) {
+				return INVALID_ID;
+			}
+			ID = (unsigned int)m_entries.size();
+			m_entries.emplace_back();
+			m_vertices.resize(m_vertices.size() + 4);
+		}
+
+		Entry& entry = m_entries[ID];
+		entry = Entry();
+		entry.used = true;
+		entry.shader = getShaderIndex(shader);
+		entry.texture = getTextureIndex(texture);
+		entry.position = quad.position;
+		entry.dimensions = quad.dimensions;
+		entry.textureBox = quad.textureBox;
+		entry.color = quad.color;
+		m_orderChanged = true;
+		m_statistics.spriteCount++;
+		return ID;
+	}
+
+	bool SpriteBatch::setQuad(unsigned int ID, const SpriteBatchQuad& quad,
+		GLuint texture) {
+		if (ID >= m_entries.size() || !m_entries[ID].used
+			|| m_entries[ID].sprite != 0) {
+			return false;
+		}
+		Entry& entry = m_entries[ID];
+		unsigned int textureIndex = getTextureIndex(texture);
+		if (textureIndex != entry.texture
+			|| quad.position.z != entry.position.z) {
+			m_orderChanged = true;
+		}
+		if (textureIndex != entry.texture || quad.position != entry.position
+			|| quad.dimensions != entry.dimensions
+			|| quad.textureBox != entry.textureBox
+			|| quad.color != entry.color) {
+			entry.texture = textureIndex;
+			entry.position = quad.position;
+			entry.dimensions = quad.dimensions;
+			entry.textureBox = quad.textureBox;
+			entry.color = quad.color;
+			entry.dirty = true;
+		}
+		return true;
+	}
+
+	bool SpriteBatch::remove(unsigned int ID) {
+		if (ID >= m_entries.size() || !m_entries[ID].used) {
+			return false;
+		}
+		m_entries[ID].used = false;
+		m_entries[ID].sprite = 0;
+		m_freeIDs.push_back(ID);
+		m_orderChanged = true;
+		m_statistics.spriteCount--;
+		return true;
+	}
+
+	void SpriteBatch::invalidate(unsigned int ID) {
+		if (ID < m_entries.size()) {
+			m_entries[ID].dirty = true;
+		}
+	}
+
+	void SpriteBatch::build() {
+		m_statistics.spritesEncoded = 0;
+		m_statistics.orderRebuilt = false;
+		if (m_textures != 0
+			&& m_textures->getGeneration() != m_textureGeneration) {
+			updateTextureRegions();
+		}
+		for (unsigned int ID = 0; ID < m_entries.size(); ID++) {
+			Entry& entry = m_entries[ID];
+			if (entry.sprite == 0) {
+				if (entry.used && entry.dirty) {
+					encode(ID);
+				}
+				continue;
+			}
+			const ActiasFW::Sprite& sprite = *entry.sprite;
+			const std::string& textureFileName = sprite.getTextureFileName();
+			if (m_rawTextures[entry.texture]
+				|| textureFileName != m_textureNames[entry.texture]) {
+				// The new texture's region replaces the old one's coordinates
+				entry.texture = getTextureIndex(textureFileName);
+				entry.dirty = true;
+				m_orderChanged = true;
+			}
+			const glm::vec3& position = sprite.getPosition();
+			if (position.z != entry.position.z) {
+				m_orderChanged = true;
+			}
+			if (entry.dirty || position != entry.position
+				|| sprite.getDimensions() != entry.dimensions
+				|| sprite.getRotation() != entry.rotation
+				|| sprite.getTextureBox() != entry.textureBox
+				|| sprite.getColor() != entry.color
+				|| sprite.isReflectedHorizontally()
+				!= entry.reflectedHorizontally
+				|| sprite.isReflectedVertically() != entry.reflectedVertically) {
+				encode(ID);
+			}
+		}
+		if (m_orderChanged) {
+			buildOrder();
+		}
+	}
+
+	void SpriteBatch::render() {
+		m_statistics.drawCalls = 0;
+		m_statistics.bytesUploaded = 0;
+		if (m_commands.empty()) {
+			return;
+		}
+		if (m_VAOID == 0) {
+			glGenVertexArrays(1, &m_VAOID);
+			glGenBuffers(1, &m_VBOID);
+			glGenBuffers(1, &m_IBOID);
+		}
+
+		glBindVertexArray(m_VAOID);
+		glBindBuffer(GL_ARRAY_BUFFER, m_VBOID);
+		if (m_firstDirtyVertex < m_lastDirtyVertex
+			|| m_vertexBufferSize < m_vertices.size() * sizeof(SpriteVertex)) {
+			upload(GL_ARRAY_BUFFER, m_vertices.data(),
+				m_vertices.size() * sizeof(SpriteVertex), m_vertexBufferSize,
+				std::min(m_firstDirtyVertex, m_vertices.size())
+				* sizeof(SpriteVertex), m_lastDirtyVertex * sizeof(SpriteVertex));
+		}
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IBOID);
+		if (m_indicesDirty) {
+			upload(GL_ELEMENT_ARRAY_BUFFER, m_indices.data(),
+				m_indices.size() * sizeof(GLuint), m_indexBufferSize, 0,
+				m_indices.size() * sizeof(GLuint));
+		}
+		m_firstDirtyVertex = SIZE_MAX;
+		m_lastDirtyVertex = 0;
+		m_indicesDirty = false;
+
+		ActiasFW::GLSLShader* shader = 0;
+		GLuint texture = 0;
+		bool textureBound = false;
+		glActiveTexture(GL_TEXTURE0);
+		for (const SpriteBatchCommand& command : m_commands) {
+			if (m_shaders[command.shader] != shader) {
+				if (shader != 0) {
+					shader->end();
+				}
+				shader = m_shaders[command.shader];
+				shader->begin();
+			}
+			if (!textureBound || command.texture != texture) {
+				texture = command.texture;
+				textureBound = true;
+				glBindTexture(GL_TEXTURE_2D, texture);
+			}
+			glDrawElements(GL_TRIANGLES, (GLsizei)command.indexCount,
+				GL_UNSIGNED_INT,
+				(const void*)(command.firstIndex * sizeof(GLuint)));
+			m_statistics.drawCalls++;
+		}
+		if (shader != 0) {
+			shader->end();
+		}
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glBindVertexArray(0);
+	}
+
+	void SpriteBatch::destroy() {
+		if (m_VAOID != 0) {
+			glDeleteBuffers(1, &m_IBOID);
+			glDeleteBuffers(1, &m_VBOID);
+			glDeleteVertexArrays(1, &m_VAOID);
+		}
+		m_VAOID = 0;
+		m_VBOID = 0;
+		m_IBOID = 0;
+		m_vertexBufferSize = 0;
+		m_indexBufferSize = 0;
+		m_entries.clear();
+		m_freeIDs.clear();
+		m_shaders.clear();
+		m_textureNames.clear();
+		m_rawTextures.clear();
+		m_textureIndices.clear();
+		m_rawTextureIndices.clear();
+		m_textureRegions.clear();
+		m_textureGeneration = 0;
+		m_vertices.clear();
+		m_indices.clear();
+		m_commands.clear();
+		m_order.clear();
+		m_orderChanged = false;
+		m_firstDirtyVertex = SIZE_MAX;
+		m_lastDirtyVertex = 0;
+		m_indicesDirty = false;
+		m_statistics = SpriteBatchStatistics();
+		m_textures = 0;
+	}
+
+	const std::vector<SpriteVertex>& SpriteBatch::getVertices() const {
+		return m_vertices;
+	}
+
+	const std::vector<GLuint>& SpriteBatch::getIndices() const {
+		return m_indices;
+	}
+
+	const std::vector<SpriteBatchCommand>& SpriteBatch::getCommands() const {
+		return m_commands;
+	}
+
+	const SpriteBatchStatistics& SpriteBatch::getStatistics() const {
+		return m_statistics;
+	}
+
+	unsigned int SpriteBatch::getShaderIndex(ActiasFW::GLSLShader& shader) {
+		std::vector<ActiasFW::GLSLShader*>::iterator it
+			= std::find(m_shaders.begin(), m_shaders.end(), &shader);
+		if (it == m_shaders.end()) {
+			m_shaders.push_back(&shader);
+			return (unsigned int)(m_shaders.size() - 1);
+		}
+		return (unsigned int)(it - m_shaders.begin());
+	}
+
+	unsigned int SpriteBatch::getTextureIndex(
+		const std::string& textureFileName) {
+		std::unordered_map<std::string, unsigned int>::iterator it
+			= m_textureIndices.find(textureFileName);
+		if (it != m_textureIndices.end()) {
+			return it->second;
+		}
+		unsigned int index = (unsigned int)m_textureNames.size();
+		m_textureNames.push_back(textureFileName);
+		m_rawTextures.push_back(false);
+		m_textureIndices[textureFileName] = index;
+		m_textureRegions.push_back(m_textures == 0 ? TextureRegion()
+			: m_textures->getRegion(textureFileName));
+		return index;
+	}
+
+	unsigned int SpriteBatch::getTextureIndex(GLuint texture) {
+		std::unordered_map<GLuint, unsigned int>::iterator it
+			= m_rawTextureIndices.find(texture);
+		if (it != m_rawTextureIndices.end()) {
+			return it->second;
+		}
+		unsigned int index = (unsigned int)m_textureNames.size();
+		m_textureNames.push_back("");
+		m_rawTextures.push_back(true);
+		m_rawTextureIndices[texture] = index;
+		TextureRegion region;
+		region.texture = texture;
+		region.loaded = true;
+		m_textureRegions.push_back(region);
+		return index;
+	}
+
+	void SpriteBatch::updateTextureRegions() {
+		m_textureGeneration = m_textures->getGeneration();
+		std::vector<bool> moved(m_textureNames.size(), false);
+		bool anyMoved = false;
+		for (size_t i = 0; i < m_textureNames.size(); i++) {
+			if (m_rawTextures[i]) {
+				continue;
+			}
+			const TextureRegion& region = m_textures->getRegion(
+				m_textureNames[i]);
+			if (region.texture != m_textureRegions[i].texture) {
+				m_orderChanged = true;
+			}
+			if (region.texture != m_textureRegions[i].texture
+				|| region.box != m_textureRegions[i].box) {
+				m_textureRegions[i] = region;
+				moved[i] = true;
+				anyMoved = true;
+			}
+		}
+		if (!anyMoved) {
+			return;
+		}
+		for (Entry& entry : m_entries) {
+			if (entry.used && moved[entry.texture]) {
+				entry.dirty = true;
+			}
+		}
+	}
+
+	void SpriteBatch::encode(unsigned int ID) {
+		Entry& entry = m_entries[ID];
+		if (entry.sprite != 0) {
+			const ActiasFW::Sprite& sprite = *entry.sprite;
+			entry.position = sprite.getPosition();
+			entry.dimensions = sprite.getDimensions();
+			entry.rotation = sprite.getRotation();
+			entry.textureBox = sprite.getTextureBox();
+			entry.color = sprite.getColor();
+			entry.reflectedHorizontally = sprite.isReflectedHorizontally();
+			entry.reflectedVertically = sprite.isReflectedVertically();
+		}
+		entry.dirty = false;
+
+		glm::vec2 corners[4] = {
+			glm::vec2(0.0f, 0.0f),
+			glm::vec2(entry.dimensions.x, 0.0f),
+			glm::vec2(entry.dimensions.x, entry.dimensions.y),
+			glm::vec2(0.0f, entry.dimensions.y),
+		};
+		if (entry.rotation != 0.0f) {
+			// Rotate the corners about the sprite's center
+			float angle = glm::radians(entry.rotation);
+			float cosine = std::cos(angle), sine = std::sin(angle);
+			glm::vec2 center = entry.dimensions * 0.5f;
+			for (glm::vec2& corner : corners) {
+				glm::vec2 offset = corner - center;
+				corner = center + glm::vec2(offset.x * cosine - offset.y * sine,
+					offset.x * sine + offset.y * cosine);
+			}
+		}
+
+		// Map the texture box into the texture's region of its atlas page
+		const glm::vec4& region = m_textureRegions[entry.texture].box;
+		float left = region.x + entry.textureBox.x * region.z;
+		float right = left + entry.textureBox.z * region.z;
+		float bottom = region.y + entry.textureBox.y * region.w;
+		float top = bottom + entry.textureBox.w * region.w;
+		if (entry.reflectedHorizontally) {
+			std::swap(left, right);
+		}
+		if (entry.reflectedVertically) {
+			std::swap(bottom, top);
+		}
+		const glm::vec2 textureCoordinates[4] = {
+			glm::vec2(left, bottom),
+			glm::vec2(right, bottom),
+			glm::vec2(right, top),
+			glm::vec2(left, top),
+		};
+
+		const size_t first = (size_t)ID * 4;
+		for (size_t i = 0; i < 4; i++) {
+			SpriteVertex& vertex = m_vertices[first + i];
+			vertex.position = glm::vec3(glm::vec2(entry.position) + corners[i],
+				entry.position.z);
+			vertex.textureCoordinates = textureCoordinates[i];
+			vertex.color = entry.color;
+		}
+		m_firstDirtyVertex = std::min(m_firstDirtyVertex, first);
+		m_lastDirtyVertex = std::max(m_lastDirtyVertex, first + 4);
+		m_statistics.spritesEncoded++;
+	}
+
+	void SpriteBatch::buildOrder() {
+		m_order.clear();
+		for (unsigned int ID = 0; ID < m_entries.size(); ID++) {
+			if (m_entries[ID].used) {
+				m_order.push_back(ID);
+			}
+		}
+		std::stable_sort(m_order.begin(), m_order.end(),
+			[this](unsigned int a, unsigned int b) {
+				const Entry& first = m_entries[a];
+				const Entry& second = m_entries[b];
+				if (first.shader != second.shader) {
+					return first.shader < second.shader;
+				}
+				if (first.position.z != second.position.z) {
+					return first.position.z < second.position.z;
+				}
+				GLuint firstTexture = m_textureRegions[first.texture].texture;
+				GLuint secondTexture = m_textureRegions[second.texture].texture;
+				if (firstTexture != secondTexture) {
+					return firstTexture < secondTexture;
+				}
+				return first.texture < second.texture;
+			});
+
+		m_indices.resize(m_order.size() * 6);
+		m_commands.clear();
+		for (size_t i = 0; i < m_order.size(); i++) {
+			const Entry& entry = m_entries[m_order[i]];
+			const GLuint texture = m_textureRegions[entry.texture].texture;
+			GLuint first = m_order[i] * 4;
+			GLuint* indices = m_indices.data() + i * 6;
+			indices[0] = first;
+			indices[1] = first + 1;
+			indices[2] = first + 2;
+			indices[3] = first + 2;
+			indices[4] = first + 3;
+			indices[5] = first;
+			if (m_commands.empty() || m_commands.back().shader != entry.shader
+				|| m_commands.back().texture != texture) {
+				SpriteBatchCommand command;
+				command.shader = entry.shader;
+				command.texture = texture;
+				command.firstIndex = i * 6;
+				m_commands.push_back(command);
+			}
+			m_commands.back().indexCount += 6;
+		}
+		m_orderChanged = false;
+		m_indicesDirty = true;
+		m_statistics.orderRebuilt = true;
+	}
+
+	void SpriteBatch::upload(GLenum target, const void* data, size_t size,
+		size_t& capacity, size_t first, size_t last) {
+		if (size > capacity) {
+			// Grow the buffer geometrically and replace its whole contents
+			capacity = std::max(size, capacity * 2);
+			glBufferData(target, capacity, 0, GL_DYNAMIC_DRAW);
+			first = 0;
+			last = size;
+		}
+		else if ((last - first) * 2 > size) {
+			// Orphan the buffer rather than wait for the GPU to release it
+			glBufferData(target, capacity, 0, GL_DYNAMIC_DRAW);
+			first = 0;
+			last = size;
+		}
+		if (last <= first) {
+			return;
+		}
+
+		void* mapped = glMapBufferRange(target, first, last - first,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+		if (mapped != 0) {
+			std::memcpy(mapped, (const uint8_t*)data + first, last - first);
+			glUnmapBuffer(target);
+		}
+		else {
+			glBufferSubData(target, first, last - first,
+				(const uint8_t*)data + first);
+		}
+		m_statistics.bytesUploaded += last - first;
+	}
+}
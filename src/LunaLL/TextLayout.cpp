@@ -0,0 +1,218 @@
+/*
+File:		TextLayout.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@16:05
+Purpose:	Implementation of the text layout cache and text blocks
+*/
+
+#include "TextLayout.h"
+
+#include <algorithm>
+
+namespace LunaLL {
+	void TextLayoutCache::initialize(unsigned int retainedFrames) {
+		destroy();
+		m_retainedFrames = retainedFrames;
+	}
+
+	const std::vector<TextQuad>& TextLayoutCache::getLayout(
+		const GlyphAtlas& atlas, const std::string& text,
+		const glm::vec4& box, float scale,
+		ActiasFW::Alignment horizontalAlignment,
+		ActiasFW::Alignment verticalAlignment) {
+		KeyView view;
+		view.atlas = &atlas;
+		view.text = text;
+		view.box = box;
+		view.scale = scale;
+		view.horizontalAlignment = horizontalAlignment;
+		view.verticalAlignment = verticalAlignment;
+		std::unordered_map<Key, Layout, KeyHash, KeyEqual>::iterator it
+			= m_layouts.find(view);
+		if (it != m_layouts.end()) {
+			it->second.lastUsed = m_frame;
+			m_statistics.hits++;
+			return it->second.quads;
+		}
+
+		Key key;
+		key.atlas = &atlas;
+		key.text = text;
+		key.box = box;
+		key.scale = scale;
+		key.horizontalAlignment = horizontalAlignment;
+		key.verticalAlignment = verticalAlignment;
+		Layout& layout = m_layouts[key];
+		TextLayoutCache::layout(atlas, text, box, scale, horizontalAlignment,
+			verticalAlignment, layout.quads);
+		layout.lastUsed = m_frame;
+		m_statistics.misses++;
+		m_statistics.glyphsLaidOut += layout.quads.size();
+		m_statistics.layoutCount = m_layouts.size();
+		return layout.quads;
+	}
+
+	void TextLayoutCache::update() {
+		// Sweep the layouts once per retained period rather than every frame
+		m_frame++;
+		if (m_retainedFrames != 0 && m_frame % m_retainedFrames != 0) {
+			return;
+		}
+		for (std::unordered_map<Key, Layout, KeyHash, KeyEqual>::iterator it
+			= m_layouts.begin(); it != m_layouts.end();) {
+			if (m_frame - it->second.lastUsed > m_retainedFrames) {
+				it = m_layouts.erase(it);
+			}
+			else {
+				it++;
+			}
+		}
+		m_statistics.layoutCount = m_layouts.size();
+	}
+
+	const TextLayoutStatistics& TextLayoutCache::getStatistics() const {
+		return m_statistics;
+	}
+
+	void TextLayoutCache::destroy() {
+		m_layouts.clear();
+		m_frame = 0;
+		m_statistics = TextLayoutStatistics();
+	}
+
+	void TextLayoutCache::layout(const GlyphAtlas& atlas,
+		std::string_view text, const glm::vec4& box, float scale,
+		ActiasFW::Alignment horizontalAlignment,
+		ActiasFW::Alignment verticalAlignment, std::vector<TextQuad>& quads) {
+		quads.clear();
+		const float lineHeight = atlas.getLineHeight() * scale;
+		const float ascender = atlas.getAscender() * scale;
+		const float descender = atlas.getDescender() * scale;
+		const size_t lineCount = std::count(text.begin(), text.end(), '\n')
+			+ 1;
+		const float height = ascender - descender
+			+ (lineCount - 1) * lineHeight;
+
+		// Place the first baseline so the block of lines is aligned in the box
+		float baseline = 0.0f;
+		if (verticalAlignment == ActiasFW::ALIGN_TOP) {
+			baseline = box.y + box.w - ascender;
+		}
+		else if (verticalAlignment == ActiasFW::ALIGN_CENTER) {
+			baseline = box.y + (box.w + height) * 0.5f - ascender;
+		}
+		else {
+			baseline = box.y + height - ascender;
+		}
+
+		size_t lineStart = 0;
+		while (lineStart <= text.size()) {
+			size_t lineEnd = std::min(text.find('\n', lineStart), text.size());
+			std::string_view line = text.substr(lineStart, lineEnd - lineStart);
+			float width = 0.0f;
+			for (char character : line) {
+				width += atlas.getGlyph(character).advance * scale;
+			}
+			float pen = box.x;
+			if (horizontalAlignment == ActiasFW::ALIGN_RIGHT) {
+				pen = box.x + box.z - width;
+			}
+			else if (horizontalAlignment == ActiasFW::ALIGN_CENTER) {
+				pen = box.x + (box.z - width) * 0.5f;
+			}
+
+			for (char character : line) {
+				const GlyphMetrics& glyph = atlas.getGlyph(character);
+				if (glyph.present) {
+					TextQuad quad;
+					quad.box = glm::vec4(pen + glyph.bearing.x * scale,
+						baseline + (glyph.bearing.y - glyph.dimensions.y)
+						* scale, glyph.dimensions * scale);
+					quad.textureBox = glyph.textureBox;
+					quads.push_back(quad);
+				}
+				pen += glyph.advance * scale;
+			}
+			baseline -= lineHeight;
+			lineStart = lineEnd + 1;
+		}
+	}
+
+	void TextBlock::initialize(SpriteBatch& batch, TextLayoutCache& layouts,
+		ActiasFW::GLSLShader& shader) {
+		destroy();
+		m_batch = &batch;
+		m_layouts = &layouts;
+		m_shader = &shader;
+	}
+
+	void TextBlock::set(const std::string& text, const glm::vec4& box,
+		float depth, float scale, const glm::vec4& color,
+		const GlyphAtlas& atlas, ActiasFW::Alignment horizontalAlignment,
+		ActiasFW::Alignment verticalAlignment) {
+		if (m_batch == 0 || (text == m_text && box == m_box
+			&& depth == m_depth && scale == m_scale && color == m_color
+			&& &atlas == m_atlas && horizontalAlignment == m_horizontalAlignment
+			&& verticalAlignment == m_verticalAlignment)) {
+			return;
+		}
+		m_text = text;
+		m_box = box;
+		m_depth = depth;
+		m_scale = scale;
+		m_color = color;
+		m_atlas = &atlas;
+		m_horizontalAlignment = horizontalAlignment;
+		m_verticalAlignment = verticalAlignment;
+
+		// Reuse this block's existing quads before adding any, so the batch's
+		// draw order is only rebuilt when the text grows
+		const std::vector<TextQuad>& quads = m_layouts->getLayout(atlas, text,
+			box, scale, horizontalAlignment, verticalAlignment);
+		SpriteBatchQuad quad;
+		quad.color = color;
+		m_glyphCount = quads.size();
+		for (size_t i = 0; i < quads.size(); i++) {
+			quad.position = glm::vec3(quads[i].box.x, quads[i].box.y, depth);
+			quad.dimensions = glm::vec2(quads[i].box.z, quads[i].box.w);
+			quad.textureBox = quads[i].textureBox;
+			if (i < m_IDs.size()) {
+				m_batch->setQuad(m_IDs[i], quad, atlas.getTexture());
+			}
+			else {
+				m_IDs.push_back(m_batch->addQuad(quad, atlas.getTexture(),
+					*m_shader));
+			}
+		}
+
+		// Hide the quads the text no longer needs
+		quad.dimensions = glm::vec2();
+		for (size_t i = quads.size(); i < m_IDs.size(); i++) {
+			quad.position = glm::vec3(box.x, box.y, depth);
+			m_batch->setQuad(m_IDs[i], quad, atlas.getTexture());
+		}
+	}
+
+	void TextBlock::destroy() {
+		if (m_batch != 0) {
+			for (unsigned int ID : m_IDs) {
+				m_batch->remove(ID);
+			}
+		}
+		m_IDs.clear();
+		m_glyphCount = 0;
+		m_text = "";
+		m_atlas = 0;
+		m_batch = 0;
+		m_layouts = 0;
+		m_shader = 0;
+	}
+
+	const std::string& TextBlock::getText() const {
+		return m_text;
+	}
+
+	size_t TextBlock::getGlyphCount() const {
+		return m_glyphCount;
+	}
+}
@@ -0,0 +1,538 @@
+/*
+File:		TextureCache.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@11:05
+Purpose:	Implementation of the OpenGL texture cache
+*/
+
+#include "TextureCache.h"
+#include "AsyncLog.h"
+
+#include <lodepng.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace LunaLL {
+	namespace {
+		// The first word of an atlas manifest
+		const std::string ATLAS_MANIFEST_MAGIC = "LLATLAS";
+		// The version of the atlas manifest format
+		constexpr unsigned int ATLAS_MANIFEST_VERSION = 1;
+
+		/*
+		Flip an RGBA image vertically in place
+		Parameter: std::vector<unsigned char>& pixels - The image's pixels
+		Parameter: unsigned int width - The image's width
+		Parameter: unsigned int height - The image's height
+		*/
+		void flipRows(std::vector<unsigned char>& pixels, unsigned int width,
+			unsigned int height) {
+			const size_t rowSize = (size_t)width * 4;
+			std::vector<unsigned char> row(rowSize);
+			for (unsigned int y = 0; y < height / 2; y++) {
+				unsigned char* top = pixels.data() + y * rowSize;
+				unsigned char* bottom = pixels.data()
+					+ (height - 1 - y) * rowSize;
+				std::copy(top, top + rowSize, row.begin());
+				std::copy(bottom, bottom + rowSize, top);
+				std::copy(row.begin(), row.end(), bottom);
+			}
+		}
+
+		/*
+		Surround an RGBA image with a one pixel border copied from its edges so
+		neighbouring images in an atlas page do not bleed into it
+		Parameter: std::vector<unsigned char>& pixels - The image's pixels
+		Parameter: glm::ivec2& dimensions - The image's dimensions, populated
+		with the padded dimensions
+		*/
+		void padImage(std::vector<unsigned char>& pixels,
+			glm::ivec2& dimensions) {
+			const glm::ivec2 padded = dimensions + 2;
+			std::vector<unsigned char> result((size_t)padded.x * padded.y * 4);
+			for (int y = 0; y < padded.y; y++) {
+				int sourceY = std::clamp(y - 1, 0, dimensions.y - 1);
+				for (int x = 0; x < padded.x; x++) {
+					int sourceX = std::clamp(x - 1, 0, dimensions.x - 1);
+					std::copy_n(pixels.data()
+						+ ((size_t)sourceY * dimensions.x + sourceX) * 4, 4,
+						result.data() + ((size_t)y * padded.x + x) * 4);
+				}
+			}
+			pixels.swap(result);
+			dimensions = padded;
+		}
+
+		/*
+		Get the last write time of a file
+		Parameter: const std::string& fileName - The file name
+		Returns: int64_t - The file's last write time, or 0 if it has none
+		*/
+		int64_t getTimestamp(const std::string& fileName) {
+			std::error_code error;
+			std::filesystem::file_time_type time
+				= std::filesystem::last_write_time(fileName, error);
+			return error ? 0 : (int64_t)time.time_since_epoch().count();
+		}
+
+		/*
+		Get the file name of an atlas page in the disk cache
+		Parameter: const std::string& directory - The disk cache directory
+		Parameter: unsigned int page - The index of the page
+		Returns: std::string - The page's file name
+		*/
+		std::string getPageFileName(const std::string& directory,
+			unsigned int page) {
+			return directory + "/atlas" + std::to_string(page) + ".png";
+		}
+
+		/*
+		Get the seconds elapsed since a time
+		Parameter: std::chrono::steady_clock::time_point start - The time
+		Returns: double - The seconds since the time
+		*/
+		double getSecondsSince(std::chrono::steady_clock::time_point start) {
+			return std::chrono::duration<double>(
+				std::chrono::steady_clock::now() - start).count();
+		}
+	}
+
+	const std::string TextureCache::ATLAS_MANIFEST_FILE_NAME = "atlas.manifest";
+
+	TextureCache::~TextureCache() {
+		destroy();
+	}
+
+	void TextureCache::initialize(
+		const TextureCacheConfiguration& configuration) {
+		destroy();
+		m_configuration = configuration;
+		m_configuration.atlasPageSize = std::max(
+			m_configuration.atlasPageSize, 16u);
+		m_configuration.maximumAtlasedSize = std::min(
+			m_configuration.maximumAtlasedSize,
+			m_configuration.atlasPageSize - 2);
+		m_packer.initialize(m_configuration.atlasPageSize);
+
+		// Show a grey checkerboard in place of textures still loading
+		const unsigned char placeholderPixels[] = {
+			96, 96, 96, 255, 160, 160, 160, 255,
+			160, 160, 160, 255, 96, 96, 96, 255,
+		};
+		m_placeholder = createTexture(glm::ivec2(2, 2), placeholderPixels);
+
+		if (m_configuration.atlasing && !m_configuration.cacheDirectory.empty()) {
+			loadAtlasCache();
+		}
+
+		unsigned int threadCount = m_configuration.decodeThreadCount;
+		if (threadCount == 0) {
+			threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+		}
+		for (unsigned int i = 0; i < threadCount; i++) {
+			m_threads.emplace_back(&TextureCache::decode, this);
+		}
+	}
+
+	GLuint TextureCache::getTexture(const std::string& fileName) {
+		std::unordered_map<std::string, GLuint>::iterator it
+			= m_textures.find(fileName);
+		if (it != m_textures.end()) {
+			return it->second;
+		}
+
+		// Remember failed textures as 0 so they are not decoded every frame
+		GLuint& textureID = m_textures[fileName];
+		std::vector<unsigned char> image;
+		unsigned int width = 0, height = 0;
+		unsigned int error = lodepng::decode(image, width, height, fileName);
+		if (error != 0) {
+			LUNALL_LOG(LunaLL, ERROR, "Failed to decode texture \"",
+				fileName, "\": ", lodepng_error_text(error));
+			return 0;
+		}
+
+		// Flip the image so texture coordinates start at its bottom row
+		flipRows(image, width, height);
+		textureID = createTexture(glm::ivec2(width, height), image.data());
+		return textureID;
+	}
+
+	const TextureRegion& TextureCache::getRegion(const std::string& fileName) {
+		std::unordered_map<std::string, TextureRegion>::iterator it
+			= m_regions.find(fileName);
+		if (it != m_regions.end()) {
+			return it->second;
+		}
+
+		TextureRegion& region = m_regions[fileName];
+		region.texture = m_placeholder;
+		std::unordered_map<std::string, AtlasEntry>::iterator entry
+			= m_atlasEntries.find(fileName);
+		if (entry != m_atlasEntries.end()) {
+			// The texture is in a cached atlas page, which may still be loading
+			if (m_pages[entry->second.page] != 0) {
+				setRegion(region, entry->second);
+			}
+		}
+		else {
+			DecodeRequest decodeRequest;
+			decodeRequest.fileName = fileName;
+			request(decodeRequest);
+		}
+		return region;
+	}
+
+	void TextureCache::update(double uploadBudget) {
+		std::chrono::steady_clock::time_point start
+			= std::chrono::steady_clock::now();
+		do {
+			DecodedImage image;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (m_decoded.empty()) {
+					break;
+				}
+				image = std::move(m_decoded.front());
+				m_decoded.pop_front();
+			}
+			upload(image);
+		} while (getSecondsSince(start) < uploadBudget);
+		m_metrics.atlasPages = m_packer.getPageCount();
+		m_metrics.atlasOccupancy = m_packer.getOccupancy();
+	}
+
+	bool TextureCache::isLoading() const {
+		return m_metrics.texturesPending > 0;
+	}
+
+	unsigned int TextureCache::getGeneration() const {
+		return m_generation;
+	}
+
+	bool TextureCache::saveAtlasCache() {
+		const std::string& directory = m_configuration.cacheDirectory;
+		if (directory.empty()
+			|| std::find(m_pages.begin(), m_pages.end(), 0u) != m_pages.end()) {
+			return false;
+		}
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+
+		const unsigned int pageSize = m_configuration.atlasPageSize;
+		std::vector<unsigned char> pixels((size_t)pageSize * pageSize * 4);
+		for (unsigned int page = 0; page < m_pages.size(); page++) {
+			glBindTexture(GL_TEXTURE_2D, m_pages[page]);
+			glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+				pixels.data());
+			flipRows(pixels, pageSize, pageSize);
+			std::string fileName = getPageFileName(directory, page);
+			unsigned int encodeError = lodepng::encode(fileName, pixels,
+				pageSize, pageSize);
+			if (encodeError != 0) {
+				LUNALL_LOG(LunaLL, ERROR, "Failed to save atlas page \"",
+					fileName, "\": ", lodepng_error_text(encodeError));
+				glBindTexture(GL_TEXTURE_2D, 0);
+				return false;
+			}
+		}
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		std::ofstream manifest(directory + "/" + ATLAS_MANIFEST_FILE_NAME);
+		manifest << ATLAS_MANIFEST_MAGIC << " " << ATLAS_MANIFEST_VERSION << " "
+			<< pageSize << " " << m_pages.size() << "\n";
+		for (const std::pair<const std::string, AtlasEntry>& entry
+			: m_atlasEntries) {
+			const glm::ivec4& rectangle = entry.second.rectangle;
+			manifest << entry.second.page << " " << rectangle.x << " "
+				<< rectangle.y << " " << rectangle.z << " " << rectangle.w << " "
+				<< entry.second.timestamp << " " << entry.first << "\n";
+		}
+		if (!manifest.good()) {
+			LUNALL_LOG(LunaLL, ERROR, "Failed to write atlas manifest in \"",
+				directory, "\"");
+			return false;
+		}
+		return true;
+	}
+
+	const TextureCacheMetrics& TextureCache::getMetrics() const {
+		return m_metrics;
+	}
+
+	void TextureCache::destroy() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		m_condition.notify_all();
+		for (std::thread& thread : m_threads) {
+			thread.join();
+		}
+		m_threads.clear();
+		m_stopping = false;
+		m_requests.clear();
+		m_decoded.clear();
+
+		for (std::pair<const std::string, GLuint>& texture : m_textures) {
+			if (texture.second != 0) {
+				glDeleteTextures(1, &texture.second);
+			}
+		}
+		m_textures.clear();
+		for (GLuint texture : m_unatlasedTextures) {
+			glDeleteTextures(1, &texture);
+		}
+		m_unatlasedTextures.clear();
+		for (GLuint page : m_pages) {
+			if (page != 0) {
+				glDeleteTextures(1, &page);
+			}
+		}
+		m_pages.clear();
+		if (m_placeholder != 0) {
+			glDeleteTextures(1, &m_placeholder);
+			m_placeholder = 0;
+		}
+		m_regions.clear();
+		m_atlasEntries.clear();
+		m_packer.initialize(m_configuration.atlasPageSize);
+		m_metrics = TextureCacheMetrics();
+		m_generation++;
+	}
+
+	void TextureCache::decode() {
+		while (true) {
+			DecodedImage image;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this]() {
+					return m_stopping || !m_requests.empty();
+				});
+				if (m_stopping) {
+					return;
+				}
+				image.request = std::move(m_requests.front());
+				m_requests.pop_front();
+			}
+
+			std::chrono::steady_clock::time_point start
+				= std::chrono::steady_clock::now();
+			unsigned int width = 0, height = 0;
+			image.error = lodepng::decode(image.pixels, width, height,
+				image.request.fileName);
+			if (image.error == 0) {
+				flipRows(image.pixels, width, height);
+				image.dimensions = glm::ivec2(width, height);
+				if (image.request.page < 0 && m_configuration.atlasing
+					&& width <= m_configuration.maximumAtlasedSize
+					&& height <= m_configuration.maximumAtlasedSize) {
+					padImage(image.pixels, image.dimensions);
+					image.padded = true;
+				}
+			}
+			image.decodeSeconds = getSecondsSince(start);
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_decoded.push_back(std::move(image));
+		}
+	}
+
+	void TextureCache::request(const DecodeRequest& decodeRequest) {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_requests.push_back(decodeRequest);
+		}
+		m_condition.notify_one();
+		m_metrics.texturesPending++;
+	}
+
+	void TextureCache::upload(DecodedImage& image) {
+		const std::string& fileName = image.request.fileName;
+		m_metrics.texturesPending--;
+		if (image.error != 0) {
+			LUNALL_LOG(LunaLL, ERROR, "Failed to decode texture \"",
+				fileName, "\": ", lodepng_error_text(image.error));
+			m_metrics.failures++;
+			if (image.request.page >= 0) {
+				// Rebuild the cached page by decoding its textures individually
+				// and packing them into it again
+				const unsigned int page = (unsigned int)image.request.page;
+				size_t usedArea = 0;
+				for (std::unordered_map<std::string, AtlasEntry>::iterator it
+					= m_atlasEntries.begin(); it != m_atlasEntries.end();) {
+					if (it->second.page != page) {
+						it++;
+						continue;
+					}
+					usedArea += (size_t)(it->second.rectangle.z + 2)
+						* (it->second.rectangle.w + 2);
+					if (m_regions.count(it->first) != 0) {
+						DecodeRequest decodeRequest;
+						decodeRequest.fileName = it->first;
+						request(decodeRequest);
+					}
+					it = m_atlasEntries.erase(it);
+				}
+				m_packer.reopenPage(page, usedArea);
+				m_pages[page] = createTexture(glm::ivec2(
+					m_configuration.atlasPageSize), 0);
+			}
+			return;
+		}
+		m_metrics.texturesDecoded++;
+		m_metrics.decodeSeconds += image.decodeSeconds;
+		m_metrics.maximumDecodeSeconds = std::max(
+			m_metrics.maximumDecodeSeconds, image.decodeSeconds);
+
+		std::chrono::steady_clock::time_point start
+			= std::chrono::steady_clock::now();
+		unsigned int page = 0;
+		glm::ivec2 position = glm::ivec2();
+		if (image.request.page >= 0) {
+			// Point the requested textures in a cached page at it
+			page = (unsigned int)image.request.page;
+			m_pages[page] = createTexture(image.dimensions,
+				image.pixels.data());
+			for (const std::pair<const std::string, AtlasEntry>& entry
+				: m_atlasEntries) {
+				std::unordered_map<std::string, TextureRegion>::iterator region
+					= m_regions.find(entry.first);
+				if (entry.second.page == page && region != m_regions.end()) {
+					setRegion(region->second, entry.second);
+				}
+			}
+			m_metrics.cachedPagesLoaded++;
+		}
+		else if (image.padded && !m_packer.pack(image.dimensions, page,
+			position)) {
+			LUNALL_LOG(LunaLL, WARNING, "Texture \"", fileName,
+				"\" fits in no atlas page, uploading it on its own");
+			uploadTexture(fileName, image);
+		}
+		else if (image.padded) {
+			while (m_pages.size() <= page) {
+				m_pages.push_back(createTexture(glm::ivec2(
+					m_configuration.atlasPageSize), 0));
+			}
+			glBindTexture(GL_TEXTURE_2D, m_pages[page]);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, position.x, position.y,
+				image.dimensions.x, image.dimensions.y, GL_RGBA,
+				GL_UNSIGNED_BYTE, image.pixels.data());
+			glBindTexture(GL_TEXTURE_2D, 0);
+
+			AtlasEntry& entry = m_atlasEntries[fileName];
+			entry.page = page;
+			entry.rectangle = glm::ivec4(position + 1, image.dimensions - 2);
+			entry.timestamp = getTimestamp(fileName);
+			setRegion(m_regions[fileName], entry);
+			m_metrics.texturesAtlased++;
+		}
+		else {
+			uploadTexture(fileName, image);
+		}
+		double seconds = getSecondsSince(start);
+		m_metrics.texturesUploaded++;
+		m_metrics.uploadSeconds += seconds;
+		m_metrics.maximumUploadSeconds = std::max(
+			m_metrics.maximumUploadSeconds, seconds);
+	}
+
+	void TextureCache::uploadTexture(const std::string& fileName,
+		const DecodedImage& image) {
+		GLuint texture = createTexture(image.dimensions, image.pixels.data());
+		m_unatlasedTextures.push_back(texture);
+		TextureRegion& region = m_regions[fileName];
+		region.texture = texture;
+		region.box = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+		if (image.padded) {
+			// Leave out the border added for packing
+			const glm::vec2 dimensions = glm::vec2(image.dimensions);
+			region.box = glm::vec4(1.0f / dimensions,
+				(dimensions - 2.0f) / dimensions);
+		}
+		region.loaded = true;
+		m_generation++;
+	}
+
+	void TextureCache::setRegion(TextureRegion& region,
+		const AtlasEntry& entry) {
+		region.texture = m_pages[entry.page];
+		region.box = glm::vec4(entry.rectangle)
+			/ (float)m_configuration.atlasPageSize;
+		region.loaded = true;
+		m_generation++;
+	}
+
+	void TextureCache::loadAtlasCache() {
+		const std::string& directory = m_configuration.cacheDirectory;
+		std::ifstream manifest(directory + "/" + ATLAS_MANIFEST_FILE_NAME);
+		if (!manifest.is_open()) {
+			return;
+		}
+		std::string magic = "";
+		unsigned int version = 0, pageSize = 0, pageCount = 0;
+		manifest >> magic >> version >> pageSize >> pageCount;
+		if (!manifest.good() || magic != ATLAS_MANIFEST_MAGIC
+			|| version != ATLAS_MANIFEST_VERSION
+			|| pageSize != m_configuration.atlasPageSize) {
+			LUNALL_LOG(LunaLL, WARNING, "Ignoring outdated atlas cache in \"",
+				directory, "\"");
+			return;
+		}
+
+		// Keep the entries whose files have not changed since they were packed
+		std::vector<std::pair<std::string, AtlasEntry>> entries;
+		std::vector<size_t> usedAreas(pageCount);
+		AtlasEntry entry;
+		while (manifest >> entry.page >> entry.rectangle.x >> entry.rectangle.y
+			>> entry.rectangle.z >> entry.rectangle.w >> entry.timestamp) {
+			std::string fileName = "";
+			std::getline(manifest >> std::ws, fileName);
+			if (entry.page < pageCount && entry.timestamp != 0
+				&& getTimestamp(fileName) == entry.timestamp) {
+				usedAreas[entry.page] += (size_t)(entry.rectangle.z + 2)
+					* (entry.rectangle.w + 2);
+				entries.push_back(std::pair<std::string, AtlasEntry>(fileName,
+					entry));
+			}
+		}
+
+		// Load only the pages still holding current entries
+		std::vector<int> pageIndices(pageCount, -1);
+		for (unsigned int page = 0; page < pageCount; page++) {
+			if (usedAreas[page] == 0) {
+				continue;
+			}
+			pageIndices[page] = (int)m_packer.addClosedPage(usedAreas[page]);
+			m_pages.push_back(0);
+			DecodeRequest decodeRequest;
+			decodeRequest.fileName = getPageFileName(directory, page);
+			decodeRequest.page = pageIndices[page];
+			request(decodeRequest);
+		}
+		for (std::pair<std::string, AtlasEntry>& cached : entries) {
+			cached.second.page = (unsigned int)pageIndices[cached.second.page];
+			m_atlasEntries[cached.first] = cached.second;
+		}
+	}
+
+	GLuint TextureCache::createTexture(const glm::ivec2& dimensions,
+		const unsigned char* pixels) {
+		GLuint textureID = 0;
+		glGenTextures(1, &textureID);
+		glBindTexture(GL_TEXTURE_2D, textureID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, dimensions.x, dimensions.y, 0,
+			GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		return textureID;
+	}
+}
@@ -0,0 +1,522 @@
+/*
+File:		UIComponents.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@23:45
+Purpose:	Implementation of the virtualized list box and carousel UI
+			components
+*/
+
+#include "UIComponents.h"
+
+#include <ActiasFW/ActiasFW.h>
+
+#include <algorithm>
+
+using ActiasFW::Application;
+
+namespace LunaLL {
+	namespace {
+		// Texture box for unselected list box rows
+		const glm::vec4 UNSELECTED_ROW_TEXTURE_BOX(0.0f, 0.0f, 0.5f, 1.0f);
+		// Texture box for selected list box rows
+		const glm::vec4 SELECTED_ROW_TEXTURE_BOX(0.5f, 0.0f, 0.5f, 1.0f);
+		// Texture box for unselected buttons
+		const glm::vec4 UNSELECTED_BUTTON_TEXTURE_BOX(0.0f, 0.0f, 1.0f / 3.0f,
+			1.0f);
+		// Texture box for selected (moused over) buttons
+		const glm::vec4 SELECTED_BUTTON_TEXTURE_BOX(1.0f / 3.0f, 0.0f,
+			1.0f / 3.0f, 1.0f);
+		// Texture box for clicked buttons
+		const glm::vec4 CLICKED_BUTTON_TEXTURE_BOX(2.0f / 3.0f, 0.0f,
+			1.0f / 3.0f, 1.0f);
+
+		/*
+		Get the position of the mouse cursor measured from the bottom left
+		corner of the window, as the UI components are placed
+		Parameter: const UIGroup& group - The group of the component testing
+		the cursor
+		Returns: glm::vec2 - The cursor's position in pixels
+		*/
+		glm::vec2 getCursorPosition(const UIGroup& group) {
+			glm::vec2 cursor = Application::Input.getMouseCursorPosition();
+			cursor.y = group.getWindowDimensions().y - cursor.y;
+			return cursor;
+		}
+
+		/*
+		Test whether a point is inside a box
+		Parameter: const glm::vec4& box - The box (x, y, width, height)
+		Parameter: const glm::vec2& point - The point
+		Returns: bool - Whether the point is inside the box
+		*/
+		bool contains(const glm::vec4& box, const glm::vec2& point) {
+			return point.x >= box.x && point.x < box.x + box.z
+				&& point.y >= box.y && point.y < box.y + box.w;
+		}
+	}
+
+	void UIListBox::initialize(const glm::vec3& position,
+		const glm::vec2& dimensions, const std::string& textureFileName,
+		const std::vector<std::string>& values, unsigned int valueCount,
+		const std::string& valueTextureFileName,
+		ActiasFW::Alignment horizontalTextAlignment,
+		ActiasFW::Alignment verticalTextAlignment) {
+		destroyRows();
+		m_position = position;
+		m_dimensions = dimensions;
+		m_backgroundSprite.initialize(glm::vec3(), glm::vec2(),
+			textureFileName);
+		m_valueTextureFileName = valueTextureFileName;
+		m_values = values;
+		m_currentValueIndex = -1;
+		m_valueCount = valueCount;
+		m_topValueIndex = 0;
+		m_horizontalTextAlignment = horizontalTextAlignment;
+		m_verticalTextAlignment = verticalTextAlignment;
+		m_enabled = true;
+		m_visible = true;
+		markDirty();
+	}
+
+	const std::vector<std::string>& UIListBox::getValues() const {
+		return m_values;
+	}
+
+	void UIListBox::setValues(const std::vector<std::string>& values) {
+		m_values = values;
+		m_currentValueIndex = -1;
+		m_topValueIndex = 0;
+		markDirty();
+	}
+
+	std::string UIListBox::getValue(unsigned int index) const {
+		return index < m_values.size() ? m_values[index] : "";
+	}
+
+	int UIListBox::getValueIndex(const std::string& value) const {
+		std::vector<std::string>::const_iterator it = std::find(
+			m_values.begin(), m_values.end(), value);
+		return it != m_values.end() ? (int)(it - m_values.begin()) : -1;
+	}
+
+	bool UIListBox::addValue(const std::string& value, int index) {
+		if (index > (int)m_values.size()) {
+			return false;
+		}
+		if (index < 0) {
+			index = (int)m_values.size();
+		}
+		m_values.insert(m_values.begin() + index, value);
+		if (m_currentValueIndex >= index) {
+			m_currentValueIndex++;
+		}
+		// Rows only need rebinding if the value shifted the shown values
+		if ((unsigned int)index < m_topValueIndex + m_valueCount) {
+			markDirty();
+		}
+		return true;
+	}
+
+	bool UIListBox::removeValue(const std::string& value) {
+		const int index = getValueIndex(value);
+		return index >= 0 && removeValue((unsigned int)index);
+	}
+
+	bool UIListBox::removeValue(unsigned int index) {
+		if (index >= m_values.size()) {
+			return false;
+		}
+		m_values.erase(m_values.begin() + index);
+		if (m_currentValueIndex == (int)index) {
+			m_currentValueIndex = -1;
+		}
+		else if (m_currentValueIndex > (int)index) {
+			m_currentValueIndex--;
+		}
+		setTopValueIndex(m_topValueIndex);
+		if (index < m_topValueIndex + m_valueCount) {
+			markDirty();
+		}
+		return true;
+	}
+
+	std::string UIListBox::getCurrentValue() const {
+		return m_currentValueIndex >= 0 ? m_values[m_currentValueIndex] : "";
+	}
+
+	void UIListBox::setCurrentValue(const std::string& value) {
+		setCurrentValueIndex(getValueIndex(value));
+	}
+
+	int UIListBox::getCurrentValueIndex() const {
+		return m_currentValueIndex;
+	}
+
+	void UIListBox::setCurrentValueIndex(int index) {
+		if (index >= (int)m_values.size()) {
+			return;
+		}
+		index = std::max(index, -1);
+		if (index != m_currentValueIndex) {
+			m_currentValueIndex = index;
+			markDirty();
+		}
+	}
+
+	unsigned int UIListBox::getValueCount() const {
+		return m_valueCount;
+	}
+
+	void UIListBox::setValueCount(unsigned int valueCount) {
+		if (valueCount != m_valueCount) {
+			m_valueCount = valueCount;
+			setTopValueIndex(m_topValueIndex);
+			markDirty();
+		}
+	}
+
+	unsigned int UIListBox::getTopValueIndex() const {
+		return m_topValueIndex;
+	}
+
+	void UIListBox::setTopValueIndex(unsigned int topValueIndex) {
+		const unsigned int maximum = m_values.size() > m_valueCount
+			? (unsigned int)m_values.size() - m_valueCount : 0;
+		topValueIndex = std::min(topValueIndex, maximum);
+		if (topValueIndex != m_topValueIndex) {
+			m_topValueIndex = topValueIndex;
+			markDirty();
+		}
+	}
+
+	ActiasFW::Alignment UIListBox::getHorizontalTextAlignment() const {
+		return m_horizontalTextAlignment;
+	}
+
+	void UIListBox::setHorizontalTextAlignment(
+		ActiasFW::Alignment horizontalTextAlignment) {
+		m_horizontalTextAlignment = horizontalTextAlignment;
+		markDirty();
+	}
+
+	ActiasFW::Alignment UIListBox::getVerticalTextAlignment() const {
+		return m_verticalTextAlignment;
+	}
+
+	void UIListBox::setVerticalTextAlignment(
+		ActiasFW::Alignment verticalTextAlignment) {
+		m_verticalTextAlignment = verticalTextAlignment;
+		markDirty();
+	}
+
+	size_t UIListBox::getRowCount() const {
+		return m_rows.size();
+	}
+
+	const std::string& UIListBox::getRowText(size_t row) const {
+		return m_rows[row].text.getText();
+	}
+
+	void UIListBox::build() {
+		UIGroup& group = *m_parent;
+		if (m_rows.size() != m_valueCount) {
+			// The rows hold their sprites' addresses in the batch, so they are
+			// only reallocated when the number of rows changes
+			destroyRows();
+			m_rows.resize(m_valueCount);
+			for (Row& row : m_rows) {
+				row.sprite.initialize(glm::vec3(), glm::vec2(),
+					m_valueTextureFileName);
+				addSprite(row.sprite, row.spriteID);
+				row.text.initialize(group.getBatch(), group.getLayouts(),
+					group.getShader());
+			}
+		}
+		addSprite(m_backgroundSprite, m_backgroundID);
+
+		// Hidden rows keep their place in the batch with no area
+		const glm::vec4 box = getBox();
+		const bool visible = m_visible && m_valueCount > 0;
+		m_backgroundSprite.setPosition(glm::vec3(box.x, box.y, m_position.z));
+		m_backgroundSprite.setDimensions(visible ? glm::vec2(box.z, box.w)
+			: glm::vec2());
+		const float rowHeight = visible ? box.w / m_valueCount : 0.0f;
+		for (unsigned int i = 0; i < m_rows.size(); i++) {
+			Row& row = m_rows[i];
+			const size_t index = (size_t)m_topValueIndex + i;
+			const bool shown = visible && index < m_values.size();
+			const glm::vec4 rowBox(box.x, box.y + box.w - (i + 1) * rowHeight,
+				box.z, rowHeight);
+			row.sprite.setPosition(glm::vec3(rowBox.x, rowBox.y,
+				m_position.z + LAYER_DEPTH));
+			row.sprite.setDimensions(shown ? glm::vec2(rowBox.z, rowBox.w)
+				: glm::vec2());
+			row.sprite.setTextureBox((int)index == m_currentValueIndex
+				? SELECTED_ROW_TEXTURE_BOX : UNSELECTED_ROW_TEXTURE_BOX);
+			row.text.set(shown ? m_values[index] : "", rowBox,
+				m_position.z + 2.0f * LAYER_DEPTH, group.getTextScale(),
+				group.getTextColor(), group.getAtlas(),
+				m_horizontalTextAlignment, m_verticalTextAlignment);
+		}
+	}
+
+	void UIListBox::processInput() {
+		const glm::vec4 box = getBox();
+		const glm::vec2 cursor = getCursorPosition(*m_parent);
+		if (m_valueCount == 0 || !contains(box, cursor)) {
+			return;
+		}
+		if (Application::Input.isMouseScrolled()) {
+			const int rows = (int)Application::Input.getMouseScrollMovement().y;
+			setTopValueIndex((unsigned int)std::max((int)m_topValueIndex
+				- rows, 0));
+		}
+		if (Application::Input.isMouseButtonPressed(
+			ActiasFW::MOUSE_BUTTON_LEFT)) {
+			const unsigned int row = std::min((unsigned int)((box.y + box.w
+				- cursor.y) / box.w * m_valueCount), m_valueCount - 1);
+			const size_t index = (size_t)m_topValueIndex + row;
+			if (index < m_values.size() && (int)index != m_currentValueIndex) {
+				setCurrentValueIndex((int)index);
+				m_parent->UIEvent(m_ID, ValueSetEventID);
+			}
+		}
+	}
+
+	void UIListBox::update(float) {}
+
+	void UIListBox::destroy() {
+		destroyRows();
+		removeSprite(m_backgroundID);
+	}
+
+	void UIListBox::destroyRows() {
+		for (Row& row : m_rows) {
+			removeSprite(row.spriteID);
+			row.text.destroy();
+		}
+		m_rows.clear();
+	}
+
+	void UICarousel::initialize(const glm::vec3& position,
+		const glm::vec2& dimensions, const std::string& textureFileName,
+		const std::vector<std::string>& values, const std::string& value,
+		float buttonWidth, const std::string& buttonTextureFileName,
+		ActiasFW::Alignment horizontalTextAlignment,
+		ActiasFW::Alignment verticalTextAlignment) {
+		m_position = position;
+		m_dimensions = dimensions;
+		m_backgroundSprite.initialize(glm::vec3(), glm::vec2(),
+			textureFileName);
+		m_lastButton.sprite.initialize(glm::vec3(), glm::vec2(),
+			buttonTextureFileName);
+		m_lastButton.sprite.setReflectedHorizontally(true);
+		m_nextButton.sprite.initialize(glm::vec3(), glm::vec2(),
+			buttonTextureFileName);
+		clear();
+		for (const std::string& added : values) {
+			addValue(added);
+		}
+		m_buttonWidth = buttonWidth;
+		m_horizontalTextAlignment = horizontalTextAlignment;
+		m_verticalTextAlignment = verticalTextAlignment;
+		m_enabled = true;
+		m_visible = true;
+		setCurrentValue(value);
+		markDirty();
+	}
+
+	const std::vector<std::string>& UICarousel::getValues() const {
+		return m_values;
+	}
+
+	std::string UICarousel::getValue(unsigned int index) const {
+		return index < m_values.size() ? m_values[index] : "";
+	}
+
+	int UICarousel::getValueIndex(const std::string& value) const {
+		std::unordered_map<std::string, unsigned int>::const_iterator it
+			= m_valueIndices.find(value);
+		return it != m_valueIndices.end() ? (int)it->second : -1;
+	}
+
+	bool UICarousel::addValue(const std::string& value, int index) {
+		if (index > (int)m_values.size()
+			|| m_valueIndices.find(value) != m_valueIndices.end()) {
+			return false;
+		}
+		if (index < 0) {
+			index = (int)m_values.size();
+		}
+		m_values.insert(m_values.begin() + index, value);
+		reindex(index);
+		if (m_values.size() > 1 && (unsigned int)index <= m_currentValueIndex) {
+			m_currentValueIndex++;
+		}
+		else if (m_values.size() == 1) {
+			markDirty();
+		}
+		return true;
+	}
+
+	bool UICarousel::removeValue(const std::string& value) {
+		const int index = getValueIndex(value);
+		return index >= 0 && removeValue((unsigned int)index);
+	}
+
+	bool UICarousel::removeValue(unsigned int index) {
+		if (index >= m_values.size()) {
+			return false;
+		}
+		m_valueIndices.erase(m_values[index]);
+		m_values.erase(m_values.begin() + index);
+		reindex(index);
+		if (index < m_currentValueIndex) {
+			m_currentValueIndex--;
+		}
+		else if (index == m_currentValueIndex) {
+			if (m_currentValueIndex >= m_values.size()) {
+				m_currentValueIndex = 0;
+			}
+			markDirty();
+		}
+		return true;
+	}
+
+	void UICarousel::clear() {
+		m_values.clear();
+		m_valueIndices.clear();
+		m_currentValueIndex = 0;
+		markDirty();
+	}
+
+	std::string UICarousel::getCurrentValue() const {
+		return getValue(m_currentValueIndex);
+	}
+
+	void UICarousel::setCurrentValue(const std::string& value) {
+		const int index = getValueIndex(value);
+		if (index >= 0) {
+			setCurrentValueIndex((unsigned int)index);
+		}
+	}
+
+	unsigned int UICarousel::getCurrentValueIndex() const {
+		return m_currentValueIndex;
+	}
+
+	void UICarousel::setCurrentValueIndex(unsigned int index) {
+		if (index < m_values.size() && index != m_currentValueIndex) {
+			m_currentValueIndex = index;
+			markDirty();
+		}
+	}
+
+	float UICarousel::getButtonWidth() const {
+		return m_buttonWidth;
+	}
+
+	void UICarousel::setButtonWidth(float buttonWidth) {
+		m_buttonWidth = buttonWidth;
+		markDirty();
+	}
+
+	ActiasFW::Alignment UICarousel::getHorizontalTextAlignment() const {
+		return m_horizontalTextAlignment;
+	}
+
+	void UICarousel::setHorizontalTextAlignment(
+		ActiasFW::Alignment horizontalTextAlignment) {
+		m_horizontalTextAlignment = horizontalTextAlignment;
+		markDirty();
+	}
+
+	ActiasFW::Alignment UICarousel::getVerticalTextAlignment() const {
+		return m_verticalTextAlignment;
+	}
+
+	void UICarousel::setVerticalTextAlignment(
+		ActiasFW::Alignment verticalTextAlignment) {
+		m_verticalTextAlignment = verticalTextAlignment;
+		markDirty();
+	}
+
+	void UICarousel::build() {
+		UIGroup& group = *m_parent;
+		if (m_backgroundID == SpriteBatch::INVALID_ID) {
+			addSprite(m_backgroundSprite, m_backgroundID);
+			addSprite(m_lastButton.sprite, m_lastButton.spriteID);
+			addSprite(m_nextButton.sprite, m_nextButton.spriteID);
+			m_text.initialize(group.getBatch(), group.getLayouts(),
+				group.getShader());
+		}
+
+		const glm::vec4 box = getBox();
+		const float buttonWidth = box.z * m_buttonWidth;
+		const glm::vec2 buttonDimensions = m_visible ? glm::vec2(buttonWidth,
+			box.w) : glm::vec2();
+		m_backgroundSprite.setPosition(glm::vec3(box.x, box.y, m_position.z));
+		m_backgroundSprite.setDimensions(m_visible ? glm::vec2(box.z, box.w)
+			: glm::vec2());
+		for (Button* button : { &m_lastButton, &m_nextButton }) {
+			const float x = button == &m_lastButton ? box.x
+				: box.x + box.z - buttonWidth;
+			button->sprite.setPosition(glm::vec3(x, box.y,
+				m_position.z + LAYER_DEPTH));
+			button->sprite.setDimensions(buttonDimensions);
+			button->sprite.setTextureBox(button->clicked
+				? CLICKED_BUTTON_TEXTURE_BOX : button->selected
+				? SELECTED_BUTTON_TEXTURE_BOX : UNSELECTED_BUTTON_TEXTURE_BOX);
+		}
+		m_text.set(m_visible ? getCurrentValue() : "", glm::vec4(box.x
+			+ buttonWidth, box.y, box.z - 2.0f * buttonWidth, box.w),
+			m_position.z + LAYER_DEPTH, group.getTextScale(),
+			group.getTextColor(), group.getAtlas(), m_horizontalTextAlignment,
+			m_verticalTextAlignment);
+	}
+
+	void UICarousel::processInput() {
+		const glm::vec4 box = getBox();
+		const float buttonWidth = box.z * m_buttonWidth;
+		const glm::vec2 cursor = getCursorPosition(*m_parent);
+		const bool last = processButton(m_lastButton, glm::vec4(box.x, box.y,
+			buttonWidth, box.w), cursor);
+		const bool next = processButton(m_nextButton, glm::vec4(box.x + box.z
+			- buttonWidth, box.y, buttonWidth, box.w), cursor);
+		if ((last || next) && m_values.size() > 1) {
+			const size_t count = m_values.size();
+			setCurrentValueIndex((unsigned int)((m_currentValueIndex
+				+ (next ? 1 : count - 1)) % count));
+			m_parent->UIEvent(m_ID, ValueSetEventID);
+		}
+	}
+
+	void UICarousel::update(float) {}
+
+	void UICarousel::destroy() {
+		removeSprite(m_backgroundID);
+		removeSprite(m_lastButton.spriteID);
+		removeSprite(m_nextButton.spriteID);
+		m_text.destroy();
+	}
+
+	bool UICarousel::processButton(Button& button, const glm::vec4& box,
+		const glm::vec2& cursor) {
+		const bool selected = contains(box, cursor);
+		const bool clicked = selected && Application::Input.isMouseButtonDown(
+			ActiasFW::MOUSE_BUTTON_LEFT);
+		const bool released = button.clicked && selected && !clicked;
+		if (selected != button.selected || clicked != button.clicked) {
+			button.selected = selected;
+			button.clicked = clicked;
+			markDirty();
+		}
+		return released;
+	}
+
+	void UICarousel::reindex(size_t first) {
+		for (size_t i = first; i < m_values.size(); i++) {
+			m_valueIndices[m_values[i]] = (unsigned int)i;
+		}
+	}
+}
@@ -0,0 +1,316 @@
+/*
+File:		UIGroup.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@23:20
+Purpose:	Implementation of retained UI components and UI groups
+*/
+
+#include "UIGroup.h"
+#include "AsyncLog.h"
+
+#include <ActiasFW/ActiasFW.h>
+
+#include <algorithm>
+
+using ActiasFW::Application;
+
+namespace LunaLL {
+	UIGroup* UIComponent::getParent() const {
+		return m_parent;
+	}
+
+	unsigned int UIComponent::getID() const {
+		return m_ID;
+	}
+
+	bool UIComponent::isEnabled() const {
+		return m_enabled;
+	}
+
+	void UIComponent::setEnabled(bool enabled) {
+		m_enabled = enabled;
+	}
+
+	bool UIComponent::isVisible() const {
+		return m_visible;
+	}
+
+	void UIComponent::setVisible(bool visible) {
+		if (visible != m_visible) {
+			m_visible = visible;
+			markDirty();
+		}
+	}
+
+	const glm::vec3& UIComponent::getPosition() const {
+		return m_position;
+	}
+
+	void UIComponent::setPosition(const glm::vec3& position) {
+		if (position != m_position) {
+			m_position = position;
+			markDirty();
+		}
+	}
+
+	const glm::vec2& UIComponent::getDimensions() const {
+		return m_dimensions;
+	}
+
+	void UIComponent::setDimensions(const glm::vec2& dimensions) {
+		if (dimensions != m_dimensions) {
+			m_dimensions = dimensions;
+			markDirty();
+		}
+	}
+
+	bool UIComponent::isDirty() const {
+		return m_dirty;
+	}
+
+	void UIComponent::markDirty() {
+		if (m_dirty) {
+			return;
+		}
+		m_dirty = true;
+		if (m_parent != 0) {
+			m_parent->m_dirtyComponents.push_back(this);
+		}
+	}
+
+	glm::vec4 UIComponent::getBox() const {
+		if (m_parent == 0) {
+			return glm::vec4();
+		}
+		const glm::vec2 window = glm::vec2(m_parent->getWindowDimensions());
+		return glm::vec4(m_position.x * window.x, m_position.y * window.y,
+			m_dimensions.x * window.x, m_dimensions.y * window.y);
+	}
+
+	void UIComponent::addSprite(ActiasFW::Sprite& sprite, unsigned int& ID) {
+		if (m_parent != 0 && ID == SpriteBatch::INVALID_ID) {
+			ID = m_parent->m_batch.add(sprite, m_parent->getShader());
+		}
+	}
+
+	void UIComponent::removeSprite(unsigned int& ID) {
+		if (m_parent != 0 && ID != SpriteBatch::INVALID_ID) {
+			m_parent->m_batch.remove(ID);
+		}
+		ID = SpriteBatch::INVALID_ID;
+	}
+
+	bool UIGroup::initialize(TextureCache& textures, const GlyphAtlas& atlas,
+		ActiasFW::GLSLShader& shader, float textScale,
+		const glm::vec4& textColor, UIEventListener* listener,
+		unsigned int ID) {
+		if (m_initialized) {
+			LUNALL_LOG(LunaLL, ERROR, "Cannot initialize UI group ", ID,
+				", it is already initialized");
+			return false;
+		}
+		m_ID = ID;
+		m_listener = listener;
+		m_batch.initialize(textures);
+		m_layouts.initialize();
+		m_atlas = &atlas;
+		m_shader = &shader;
+		m_textScale = textScale;
+		m_textColor = textColor;
+		m_enabled = true;
+		m_visible = true;
+		m_windowDimensions = Application::Window.getDimensions();
+		m_initialized = true;
+		return true;
+	}
+
+	bool UIGroup::addComponent(UIComponent& component) {
+		if (!m_initialized || component.m_parent != 0) {
+			return false;
+		}
+		component.m_parent = this;
+		component.m_ID = m_nextID++;
+		m_components.push_back(&component);
+		component.m_dirty = false;
+		component.markDirty();
+		return true;
+	}
+
+	bool UIGroup::removeComponent(UIComponent& component) {
+		std::vector<UIComponent*>::iterator it = std::find(
+			m_components.begin(), m_components.end(), &component);
+		if (it == m_components.end()) {
+			return false;
+		}
+		m_components.erase(it);
+		m_dirtyComponents.erase(std::remove(m_dirtyComponents.begin(),
+			m_dirtyComponents.end(), &component), m_dirtyComponents.end());
+		component.destroy();
+		component.m_parent = 0;
+		component.m_dirty = false;
+		return true;
+	}
+
+	void UIGroup::processInput() {
+		if (!m_enabled || !m_visible) {
+			return;
+		}
+		for (UIComponent* component : m_components) {
+			if (component->m_enabled && component->m_visible) {
+				component->processInput();
+			}
+		}
+	}
+
+	void UIGroup::update(float timeStep) {
+		// A minimized or hidden window keeps the components where they were
+		const glm::ivec2& dimensions = Application::Window.getDimensions();
+		if (dimensions.x > 0 && dimensions.y > 0) {
+			setWindowDimensions(dimensions);
+		}
+		for (UIComponent* component : m_components) {
+			component->update(timeStep);
+		}
+		m_layouts.update();
+	}
+
+	void UIGroup::build() {
+		// Components may mark others dirty while building, so the queue is
+		// read by index, and each flag is cleared before its component builds
+		// so a component which marks itself dirty stays queued
+		m_statistics.componentsBuilt = 0;
+		std::vector<UIComponent*> deferred;
+		for (size_t i = 0; i < m_dirtyComponents.size(); i++) {
+			UIComponent* component = m_dirtyComponents[i];
+			component->m_dirty = false;
+			component->build();
+			m_statistics.componentsBuilt++;
+			if (component->m_dirty) {
+				// Build it again in the next build rather than repeatedly in
+				// this one
+				m_dirtyComponents.erase(std::find(m_dirtyComponents.begin()
+					+ i + 1, m_dirtyComponents.end(), component));
+				deferred.push_back(component);
+			}
+		}
+		m_dirtyComponents.clear();
+		m_dirtyComponents.insert(m_dirtyComponents.end(), deferred.begin(),
+			deferred.end());
+		m_batch.build();
+
+		const SpriteBatchStatistics& statistics = m_batch.getStatistics();
+		m_statistics.componentCount = m_components.size();
+		m_statistics.spriteCount = statistics.spriteCount;
+		m_statistics.spritesEncoded = statistics.spritesEncoded;
+	}
+
+	void UIGroup::draw() {
+		build();
+		if (m_visible) {
+			m_batch.render();
+		}
+	}
+
+	void UIGroup::UIEvent(unsigned int componentID, unsigned int eventID) {
+		if (m_listener != 0) {
+			m_listener->UIEvent(m_ID, componentID, eventID);
+		}
+	}
+
+	bool UIGroup::destroy() {
+		if (!m_initialized) {
+			return false;
+		}
+		for (UIComponent* component : m_components) {
+			component->destroy();
+			component->m_parent = 0;
+			component->m_dirty = false;
+		}
+		m_components.clear();
+		m_dirtyComponents.clear();
+		m_nextID = 0;
+		m_batch.destroy();
+		m_layouts.destroy();
+		m_listener = 0;
+		m_atlas = 0;
+		m_shader = 0;
+		m_statistics = UIGroupStatistics();
+		m_initialized = false;
+		return true;
+	}
+
+	unsigned int UIGroup::getID() const {
+		return m_ID;
+	}
+
+	bool UIGroup::isEnabled() const {
+		return m_enabled;
+	}
+
+	void UIGroup::setEnabled(bool enabled) {
+		m_enabled = enabled;
+	}
+
+	bool UIGroup::isVisible() const {
+		return m_visible;
+	}
+
+	void UIGroup::setVisible(bool visible) {
+		m_visible = visible;
+	}
+
+	const glm::ivec2& UIGroup::getWindowDimensions() const {
+		return m_windowDimensions;
+	}
+
+	void UIGroup::setWindowDimensions(const glm::ivec2& windowDimensions) {
+		if (windowDimensions != m_windowDimensions) {
+			m_windowDimensions = windowDimensions;
+			markAllDirty();
+		}
+	}
+
+	const GlyphAtlas& UIGroup::getAtlas() const {
+		return *m_atlas;
+	}
+
+	ActiasFW::GLSLShader& UIGroup::getShader() {
+		return *m_shader;
+	}
+
+	float UIGroup::getTextScale() const {
+		return m_textScale;
+	}
+
+	void UIGroup::setTextScale(float textScale) {
+		m_textScale = textScale;
+		markAllDirty();
+	}
+
+	const glm::vec4& UIGroup::getTextColor() const {
+		return m_textColor;
+	}
+
+	void UIGroup::setTextColor(const glm::vec4& textColor) {
+		m_textColor = textColor;
+		markAllDirty();
+	}
+
+	SpriteBatch& UIGroup::getBatch() {
+		return m_batch;
+	}
+
+	TextLayoutCache& UIGroup::getLayouts() {
+		return m_layouts;
+	}
+
+	const UIGroupStatistics& UIGroup::getStatistics() const {
+		return m_statistics;
+	}
+
+	void UIGroup::markAllDirty() {
+		for (UIComponent* component : m_components) {
+			component->markDirty();
+		}
+	}
+}
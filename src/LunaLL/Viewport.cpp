@@ -0,0 +1,24 @@
+/*
+File:		Viewport.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@09:20
+Purpose:	Implementation of the camera visibility utilities
+*/
+
+#include "Viewport.h"
+
+#include <algorithm>
+
+namespace LunaLL {
+	glm::vec4 getVisibleBox(const ActiasFW::Camera& camera) {
+		// Unproject the corners of normalized device space into the world
+		glm::mat4 inverse = glm::inverse(camera.getMatrix());
+		glm::vec4 a = inverse * glm::vec4(-1.0f, -1.0f, 0.0f, 1.0f);
+		glm::vec4 b = inverse * glm::vec4(1.0f, 1.0f, 0.0f, 1.0f);
+		a /= a.w;
+		b /= b.w;
+		glm::vec2 minimum(std::min(a.x, b.x), std::min(a.y, b.y));
+		glm::vec2 maximum(std::max(a.x, b.x), std::max(a.y, b.y));
+		return glm::vec4(minimum, maximum - minimum);
+	}
+}
@@ -0,0 +1,220 @@
+/*
+File:		AudioBenchmark.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@22:40
+Purpose:	Benchmark of decoding sound effects on the game thread against
+			background effect banks, streamed music, and effect voice limits
+*/
+
+#include "Benchmark.h"
+
+#include <LunaLL/AudioManager.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace TestDriver {
+	namespace {
+		/*
+		Write a 16 bit stereo WAV file of a tone
+		Parameter: const std::string& fileName - The file to write
+		Parameter: double seconds - The length of the tone
+		Parameter: double frequency - The frequency of the tone in hertz
+		*/
+		void writeTone(const std::string& fileName, double seconds,
+			double frequency) {
+			const uint32_t sampleRate = 44100;
+			const uint16_t channelCount = 2;
+			const uint32_t frameCount = (uint32_t)(seconds * sampleRate);
+			std::vector<int16_t> samples((size_t)frameCount * channelCount);
+			for (uint32_t i = 0; i < frameCount; i++) {
+				const int16_t sample = (int16_t)(std::sin(2.0 * 3.14159265
+					* frequency * i / sampleRate) * 12000.0);
+				samples[(size_t)i * 2] = sample;
+				samples[(size_t)i * 2 + 1] = sample;
+			}
+
+			const uint32_t dataSize = (uint32_t)(samples.size()
+				* sizeof(int16_t));
+			const uint32_t riffSize = 36 + dataSize;
+			const uint32_t formatSize = 16;
+			const uint16_t format = 1;
+			const uint32_t byteRate = sampleRate * channelCount * 2;
+			const uint16_t blockAlign = channelCount * 2;
+			const uint16_t bitsPerSample = 16;
+			std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+			file.write("RIFF", 4);
+			file.write((const char*)&riffSize, 4);
+			file.write("WAVEfmt ", 8);
+			file.write((const char*)&formatSize, 4);
+			file.write((const char*)&format, 2);
+			file.write((const char*)&channelCount, 2);
+			file.write((const char*)&sampleRate, 4);
+			file.write((const char*)&byteRate, 4);
+			file.write((const char*)&blockAlign, 2);
+			file.write((const char*)&bitsPerSample, 2);
+			file.write("data", 4);
+			file.write((const char*)&dataSize, 4);
+			file.write((const char*)samples.data(), dataSize);
+		}
+	}
+
+	int runAudioBenchmark(const std::vector<std::string>& arguments) {
+		const size_t effectCount = std::stoul(getArgument(arguments, 0,
+			"64"));
+		const double musicSeconds = std::stod(getArgument(arguments, 1,
+			"180"));
+		const double mebibyte = 1024.0 * 1024.0;
+		if (effectCount < 1) {
+			std::cout << "The benchmark needs at least one effect\n";
+			return 1;
+		}
+
+		// Generate short effects and a long music track
+		const std::filesystem::path directory
+			= std::filesystem::temp_directory_path() / "LunaLLAudioBenchmark";
+		std::filesystem::remove_all(directory);
+		std::filesystem::create_directories(directory);
+		// Declared before the audio manager so its decoding thread stops
+		// before the files are removed
+		DirectoryRemover remover(directory);
+		std::vector<std::string> fileNames(effectCount);
+		for (size_t i = 0; i < effectCount; i++) {
+			fileNames[i] = (directory / ("effect" + std::to_string(i)
+				+ ".wav")).string();
+			writeTone(fileNames[i], 0.25 + (i % 8) * 0.25,
+				220.0 + i * 10.0);
+		}
+		const std::string musicFileName = (directory / "music.wav").string();
+		writeTone(musicFileName, musicSeconds, 110.0);
+		std::cout << "Effects: " << effectCount << ", music: "
+			<< musicSeconds << " s\n";
+
+		// Decode each effect on the calling thread as a first play would
+		std::vector<double> loadTimes;
+		{
+			std::vector<SoLoud::Wav> effects(effectCount);
+			for (size_t i = 0; i < effectCount; i++) {
+				Timer timer;
+				effects[i].load(fileNames[i].c_str());
+				loadTimes.push_back(timer.getMilliseconds());
+			}
+			SoLoud::Wav music;
+			Timer timer;
+			music.load(musicFileName.c_str());
+			std::cout << "Decoding on the game thread\n";
+			report("  Effect first play stall p50",
+				getPercentile(loadTimes, 50.0), "ms");
+			report("  Effect first play stall maximum",
+				getPercentile(loadTimes, 100.0), "ms");
+			report("  Music first play stall", timer.getMilliseconds(),
+				"ms");
+			report("  Music decoded memory", (double)music.mSampleCount
+				* music.mChannels * sizeof(float) / mebibyte, "MiB");
+		}
+
+		LunaLL::AudioManager audio;
+		LunaLL::AudioConfiguration configuration;
+		configuration.headless = true;
+		if (!audio.initialize(configuration)) {
+			std::cout << "Failed to initialize the audio manager\n";
+			return 1;
+		}
+
+		// Load the effects as a bank while simulating 60 Hz frames
+		std::cout << "Background effect bank\n";
+		Timer timer;
+		audio.loadBank("Level", fileNames);
+		report("  Bank request", timer.getMilliseconds(), "ms");
+		std::vector<double> frameTimes;
+		std::chrono::steady_clock::time_point frameEnd
+			= std::chrono::steady_clock::now();
+		while (audio.getBankStatus("Level") == LunaLL::BANK_LOADING) {
+			Timer frame;
+			audio.update();
+			audio.playEffect(fileNames[0]);
+			frameTimes.push_back(frame.getMilliseconds());
+			frameEnd += std::chrono::microseconds(16667);
+			std::this_thread::sleep_until(frameEnd);
+		}
+		report("  Time until loaded", timer.getMilliseconds(), "ms");
+		report("  Frames until loaded", (double)frameTimes.size(), "frames");
+		report("  Frame audio time p99", getPercentile(frameTimes, 99.0),
+			"ms");
+		report("  Frame audio time maximum", getPercentile(frameTimes,
+			100.0), "ms");
+		if (audio.getBankStatus("Level") != LunaLL::BANK_LOADED
+			|| audio.getBankProgress("Level") != 1.0f) {
+			std::cout << "Failed to load the effect bank\n";
+			return 1;
+		}
+
+		// Play loaded effects
+		std::vector<double> playTimes;
+		for (size_t i = 0; i < effectCount; i++) {
+			Timer play;
+			audio.playEffect(fileNames[i]);
+			playTimes.push_back(play.getMilliseconds() * 1000.0);
+		}
+		report("  Effect play p50", getPercentile(playTimes, 50.0), "us");
+		report("  Effect play p99", getPercentile(playTimes, 99.0), "us");
+
+		// Burst one effect within a frame, then play it every few frames
+		const std::string& burstFileName = fileNames[effectCount - 1];
+		audio.setVoiceLimit(burstFileName, 4);
+		audio.update();
+		const LunaLL::AudioMetrics before = audio.getMetrics();
+		for (int i = 0; i < 200; i++) {
+			audio.playEffect(burstFileName);
+		}
+		unsigned int maximumVoices = audio.getVoiceCount(burstFileName);
+		for (int i = 0; i < 12; i++) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(40));
+			audio.update();
+			audio.playEffect(burstFileName);
+			maximumVoices = std::max(maximumVoices,
+				audio.getVoiceCount(burstFileName));
+		}
+		std::cout << "Voice limits\n";
+		report("  Plays merged", (double)(audio.getMetrics().effectsMerged
+			- before.effectsMerged), "plays");
+		report("  Voices stolen", (double)(audio.getMetrics().voicesStolen
+			- before.voicesStolen), "voices");
+		report("  Most voices of one effect", (double)maximumVoices,
+			"voices");
+		if (maximumVoices > 4) {
+			std::cout << "Exceeded an effect's voice limit\n";
+			return 1;
+		}
+
+		// Stream the music track
+		std::cout << "Streamed music\n";
+		timer.restart();
+		if (!audio.playMusic(musicFileName)) {
+			std::cout << "Failed to stream the music track\n";
+			return 1;
+		}
+		report("  Music first play stall", timer.getMilliseconds(), "ms");
+		const LunaLL::AudioMetrics& metrics = audio.getMetrics();
+		report("  Decoded memory avoided", metrics.musicDecodedBytes
+			/ mebibyte, "MiB");
+		report("  Effect memory", metrics.effectBytes / mebibyte, "MiB");
+		report("  Effects loaded", (double)metrics.effectsLoaded, "effects");
+		report("  Mean effect decode time", metrics.decodeSeconds * 1000.0
+			/ effectCount, "ms");
+		audio.stopMusic();
+
+		audio.unloadBank("Level");
+		if (audio.getMetrics().effectBytes != 0) {
+			std::cout << "Unloading the bank left effects in memory\n";
+			return 1;
+		}
+		audio.destroy();
+		return 0;
+	}
+}
@@ -0,0 +1,105 @@
+/*
+File:		BatchBenchmark.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@11:58
+Purpose:	Benchmark of the CPU side of the retained sprite batch against
+			rebuilding every sprite's vertices each frame
+*/
+
+#include "Benchmark.h"
+
+#include <LunaLL/SpriteBatch.h>
+
+#include <iostream>
+#include <random>
+
+namespace TestDriver {
+	namespace {
+		// A sprite whose vertex generation can be called directly, as the
+		// graphics manager does when sprites are submitted
+		class BenchmarkSprite : public ActiasFW::Sprite {
+		public:
+			using ActiasFW::Sprite::draw;
+		};
+	}
+
+	int runBatchBenchmark(const std::vector<std::string>& arguments) {
+		const size_t spriteCount = std::stoul(getArgument(arguments, 0,
+			"100000"));
+		const unsigned int frameCount = std::stoul(getArgument(arguments, 1,
+			"200"));
+
+		std::mt19937 random(1);
+		std::vector<BenchmarkSprite> sprites(spriteCount);
+		for (size_t i = 0; i < spriteCount; i++) {
+			sprites[i].initialize(glm::vec3((float)(i % 1000) * 16.0f,
+				(float)(i / 1000) * 16.0f, 0.0f), glm::vec2(16.0f, 16.0f),
+				"Textures/tile" + std::to_string(random() % 16) + ".png");
+			sprites[i].setColor(glm::vec4(1.0f));
+		}
+		std::cout << "Sprites: " << spriteCount << ", frames: " << frameCount
+			<< "\n";
+
+		// Rebuild and gather every sprite's vertices each frame
+		std::vector<float> vertices;
+		std::vector<unsigned int> indices;
+		Timer timer;
+		for (unsigned int frame = 0; frame < frameCount; frame++) {
+			vertices.clear();
+			indices.clear();
+			for (BenchmarkSprite& sprite : sprites) {
+				sprite.draw();
+				vertices.insert(vertices.end(), sprite.getVertices().begin(),
+					sprite.getVertices().end());
+				indices.insert(indices.end(), sprite.getIndices().begin(),
+					sprite.getIndices().end());
+			}
+		}
+		double seconds = timer.getSeconds();
+		report("Per-frame rebuild frame time", seconds * 1000.0 / frameCount,
+			"ms");
+		report("Per-frame rebuild throughput",
+			spriteCount * 4.0 * frameCount / seconds / 1.0e6, "Mvertices/s");
+
+		// Build the retained batch with a fraction of the sprites moving
+		ActiasFW::GLSLShader shader;
+		LunaLL::TextureCache textures;
+		LunaLL::SpriteBatch batch;
+		batch.initialize(textures);
+		std::vector<unsigned int> IDs;
+		batch.add(sprites, shader, IDs);
+		timer.restart();
+		batch.build();
+		report("Retained initial build", timer.getMilliseconds(), "ms");
+		report("Retained draw commands", (double)batch.getCommands().size(),
+			"commands");
+
+		for (double fraction : { 0.0, 0.01, 0.1, 1.0 }) {
+			const size_t moving = (size_t)(spriteCount * fraction);
+			size_t encoded = 0;
+			double buildSeconds = 0.0;
+			for (unsigned int frame = 0; frame < frameCount; frame++) {
+				for (size_t i = 0; i < moving; i++) {
+					BenchmarkSprite& sprite = sprites[(i * 7919 + frame)
+						% spriteCount];
+					sprite.setPosition(sprite.getPosition()
+						+ glm::vec3(0.5f, 0.0f, 0.0f));
+				}
+				timer.restart();
+				batch.build();
+				buildSeconds += timer.getSeconds();
+				encoded += batch.getStatistics().spritesEncoded;
+			}
+			std::string name = "Retained build (" + std::to_string(
+				(int)(fraction * 100.0)) + "% moving)";
+			report(name + " frame time", buildSeconds * 1000.0 / frameCount,
+				"ms");
+			report(name + " throughput", spriteCount * 4.0 * frameCount
+				/ buildSeconds / 1.0e6, "Mvertices/s");
+			report(name + " encoded", encoded * 4.0 / buildSeconds / 1.0e6,
+				"Mvertices/s");
+		}
+		batch.destroy();
+		return 0;
+	}
+}
@@ -0,0 +1,137 @@
+/*
+File:		Benchmark.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@10:02
+Purpose:	Implementation of the TestDriver benchmark utilities
+*/
+
+#include "Benchmark.h"
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace TestDriver {
+	namespace {
+		// The hidden window holding the benchmarks' OpenGL context
+		GLFWwindow* hiddenWindow = 0;
+	}
+
+	Timer::Timer() {
+		restart();
+	}
+
+	void Timer::restart() {
+		m_start = std::chrono::steady_clock::now();
+	}
+
+	double Timer::getSeconds() const {
+		return std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - m_start).count();
+	}
+
+	double Timer::getMilliseconds() const {
+		return getSeconds() * 1000.0;
+	}
+
+	size_t getPeakResidentMemory() {
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters;
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+			sizeof(counters))) {
+			return counters.PeakWorkingSetSize;
+		}
+		return 0;
+#else
+		struct rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) == 0) {
+			return (size_t)usage.ru_maxrss * 1024;
+		}
+		return 0;
+#endif
+	}
+
+	double getPercentile(std::vector<double> samples, double percentile) {
+		if (samples.empty()) {
+			return 0.0;
+		}
+		size_t index = (size_t)(percentile / 100.0 * (samples.size() - 1)
+			+ 0.5);
+		index = std::min(index, samples.size() - 1);
+		std::nth_element(samples.begin(), samples.begin() + index,
+			samples.end());
+		return samples[index];
+	}
+
+	void report(const std::string& name, double value,
+		const std::string& unit) {
+		std::cout << std::left << std::setw(40) << name << std::right
+			<< std::setw(16) << std::fixed << std::setprecision(3) << value
+			<< " " << unit << "\n";
+	}
+
+	std::string getArgument(const std::vector<std::string>& arguments,
+		size_t index, const std::string& defaultValue) {
+		return index < arguments.size() ? arguments[index] : defaultValue;
+	}
+
+	bool createHiddenContext() {
+		if (hiddenWindow != 0) {
+			return true;
+		}
+		if (glfwInit() != GLFW_TRUE) {
+			std::cout << "Failed to initialize GLFW\n";
+			return false;
+		}
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+		hiddenWindow = glfwCreateWindow(64, 64, "TestDriver", 0, 0);
+		if (hiddenWindow == 0) {
+			std::cout << "Failed to create an OpenGL context\n";
+			glfwTerminate();
+			return false;
+		}
+		glfwMakeContextCurrent(hiddenWindow);
+		glewExperimental = GL_TRUE;
+		if (glewInit() != GLEW_OK) {
+			std::cout << "Failed to initialize GLEW\n";
+			destroyHiddenContext();
+			return false;
+		}
+		return true;
+	}
+
+	void destroyHiddenContext() {
+		if (hiddenWindow != 0) {
+			glfwDestroyWindow(hiddenWindow);
+			hiddenWindow = 0;
+			glfwTerminate();
+		}
+	}
+
+	HiddenContextGuard::~HiddenContextGuard() {
+		destroyHiddenContext();
+	}
+
+	DirectoryRemover::DirectoryRemover(const std::filesystem::path& directory)
+		: m_directory(directory) {}
+
+	DirectoryRemover::~DirectoryRemover() {
+		std::error_code error;
+		std::filesystem::remove_all(m_directory, error);
+	}
+}
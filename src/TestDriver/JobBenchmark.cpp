@@ -0,0 +1,199 @@
+/*
+File:		JobBenchmark.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@21:20
+Purpose:	Benchmark of parallel entity updates on the job system from one
+			thread up to a maximum number of threads
+*/
+
+#include "Benchmark.h"
+
+#include <LunaLL/EntityStore.h>
+#include <LunaLL/JobSystem.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+namespace TestDriver {
+	namespace {
+		/*
+		Mix a float's bits into a checksum
+		Parameter: uint64_t checksum - The checksum so far
+		Parameter: float value - The value to mix in
+		Returns: uint64_t - The new checksum
+		*/
+		uint64_t mix(uint64_t checksum, float value) {
+			uint32_t bits = 0;
+			std::memcpy(&bits, &value, sizeof(bits));
+			return (checksum ^ bits) * 1099511628211ull;
+		}
+
+		/*
+		Get a checksum of the exact state of a list of animations
+		Parameter: const std::vector<ActiasFW::Animation>& animations - The
+		animations
+		Returns: uint64_t - The checksum
+		*/
+		uint64_t getChecksum(
+			const std::vector<ActiasFW::Animation>& animations) {
+			uint64_t checksum = 14695981039346656037ull;
+			for (const ActiasFW::Animation& animation : animations) {
+				checksum = mix(checksum, animation.getPosition().x);
+				checksum = mix(checksum, animation.getPosition().y);
+				checksum = mix(checksum, animation.getRotation());
+				checksum = mix(checksum,
+					(float)animation.getCurrentFrame());
+			}
+			return checksum;
+		}
+
+		/*
+		Get a checksum of the exact state of an entity store
+		Parameter: const LunaLL::EntityStore& store - The store
+		Returns: uint64_t - The checksum
+		*/
+		uint64_t getChecksum(const LunaLL::EntityStore& store) {
+			uint64_t checksum = 14695981039346656037ull;
+			for (size_t i = 0; i < store.getSize(); i++) {
+				checksum = mix(checksum, store.getPosition(i).x);
+				checksum = mix(checksum, store.getPosition(i).y);
+				checksum = mix(checksum, store.getRotation(i));
+				checksum = mix(checksum, (float)store.getCurrentFrame(i));
+			}
+			return checksum;
+		}
+	}
+
+	int runJobBenchmark(const std::vector<std::string>& arguments) {
+		const size_t entityCount = std::stoul(getArgument(arguments, 0,
+			"250000"));
+		const size_t updateCount = std::stoul(getArgument(arguments, 1,
+			"300"));
+		const unsigned int maximumThreadCount = (unsigned int)std::stoul(
+			getArgument(arguments, 2, std::to_string(std::max(
+			std::thread::hardware_concurrency(), 1u))));
+		const unsigned int frameCount = 4;
+
+		// Generate moving, spinning animations with varied frame times
+		std::mt19937 random(1);
+		std::uniform_real_distribution<float> coordinate(0.0f, 8192.0f);
+		std::uniform_real_distribution<float> speed(-2.0f, 2.0f);
+		std::uniform_real_distribution<float> frameTime(3.0f, 12.0f);
+		std::vector<ActiasFW::Animation> initial(entityCount);
+		for (ActiasFW::Animation& animation : initial) {
+			animation.initialize(glm::vec3(coordinate(random),
+				coordinate(random), 0.0f), glm::vec2(16.0f, 16.0f),
+				"Tiles.png", glm::ivec2(frameCount, 1), frameTime(random));
+			animation.setVelocity(glm::vec2(speed(random), speed(random)));
+			animation.setRotationVelocity(speed(random));
+			animation.play();
+			// Start part way through a frame, as frame times are at least
+			// three updates, so the store must copy the animation's timer
+			animation.update(1.0f);
+		}
+		std::cout << "Entities: " << entityCount << ", updates: "
+			<< updateCount << "\n";
+
+		// A fixed step sequence where every eighth frame catches up twice
+		std::vector<float> timeSteps(updateCount, 1.0f);
+		for (size_t i = 7; i < updateCount; i += 8) {
+			timeSteps[i] = 2.0f;
+		}
+
+		double virtualBaseline = 0.0;
+		double storeBaseline = 0.0;
+		uint64_t virtualChecksum = 0;
+		uint64_t storeChecksum = 0;
+		bool deterministic = true;
+		bool matched = true;
+		for (unsigned int threadCount = 1; threadCount <= maximumThreadCount;
+			threadCount++) {
+			LunaLL::JobConfiguration configuration;
+			configuration.threadCount = threadCount;
+			if (!LunaLL::JobSystem::Jobs.initialize(configuration)) {
+				std::cout << "Failed to start " << threadCount << " threads\n";
+				return 1;
+			}
+			std::cout << "Threads: " << threadCount << "\n";
+
+			// Update each animation through its virtual update
+			std::vector<ActiasFW::Animation> animations = initial;
+			Timer timer;
+			for (float timeStep : timeSteps) {
+				LunaLL::JobSystem::Jobs.updateEntities(animations, timeStep);
+			}
+			const double virtualTime = timer.getMilliseconds() / updateCount;
+			report("  Virtual update", virtualTime, "ms/update");
+
+			// Update the same state in the entity store's arrays
+			LunaLL::EntityStore store;
+			store.reserve(entityCount);
+			for (const ActiasFW::Animation& animation : initial) {
+				store.add(animation, frameCount);
+			}
+			timer.restart();
+			for (float timeStep : timeSteps) {
+				store.update(timeStep);
+			}
+			const double storeTime = timer.getMilliseconds() / updateCount;
+			report("  Entity store update", storeTime, "ms/update");
+
+			// Time loops too small to split to find the cost of a loop
+			const size_t loopCount = 20000;
+			size_t counted = 0;
+			timer.restart();
+			for (size_t i = 0; i < loopCount; i++) {
+				LunaLL::JobSystem::Jobs.parallelFor(0, 64, 1,
+					[&counted](size_t begin, size_t end) {
+						if (begin == 0) {
+							counted += end;
+						}
+					});
+			}
+			report("  Parallel for overhead", timer.getMilliseconds()
+				* 1000.0 / loopCount, "us/loop");
+
+			// The store must reach the animations' exact state, on any
+			// number of threads
+			const uint64_t animationsChecksum = getChecksum(animations);
+			const uint64_t entitiesChecksum = getChecksum(store);
+			matched = matched && entitiesChecksum == animationsChecksum;
+			if (threadCount == 1) {
+				virtualBaseline = virtualTime;
+				storeBaseline = storeTime;
+				virtualChecksum = animationsChecksum;
+				storeChecksum = entitiesChecksum;
+			}
+			else {
+				deterministic = deterministic
+					&& animationsChecksum == virtualChecksum
+					&& entitiesChecksum == storeChecksum;
+			}
+			report("  Virtual speedup", virtualBaseline / virtualTime, "x");
+			report("  Entity store speedup", storeBaseline / storeTime, "x");
+			report("  Entity store over virtual", virtualTime / storeTime,
+				"x");
+			for (ActiasFW::Animation& animation : animations) {
+				animation.destroy();
+			}
+			LunaLL::JobSystem::Jobs.destroy();
+		}
+		for (ActiasFW::Animation& animation : initial) {
+			animation.destroy();
+		}
+
+		if (!deterministic) {
+			std::cout << "Updates differed between thread counts\n";
+			return 1;
+		}
+		if (!matched) {
+			std::cout << "The entity store differed from the animations\n";
+			return 1;
+		}
+		std::cout << "Updates matched on every thread count and the entity "
+			"store matched the animations\n";
+		return 0;
+	}
+}
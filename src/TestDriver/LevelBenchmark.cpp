@@ -0,0 +1,202 @@
+/*
+File:		LevelBenchmark.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@10:14
+Purpose:	Benchmark of opening, decoding, and streaming large levels in the
+			LunaLL binary level format
+*/
+
+#include "Benchmark.h"
+
+#include <LunaLL/Level.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+
+namespace TestDriver {
+	namespace {
+		/*
+		Generate the tile kind at a position in the benchmark level, regions of
+		terrain with scattered detail tiles and empty holes
+		*/
+		uint16_t generateTile(unsigned int x, unsigned int y) {
+			uint32_t region = (x / 24) * 73856093u ^ (y / 24) * 19349663u;
+			region ^= region >> 13;
+			if (region % 11 == 0) {
+				return LunaLL::EMPTY_TILE;
+			}
+			uint32_t detail = x * 2654435761u ^ y * 2246822519u;
+			detail ^= detail >> 15;
+			if (detail % 17 == 0) {
+				return (uint16_t)(4 + detail % 4);
+			}
+			return (uint16_t)(region % 4);
+		}
+	}
+
+	int runLevelBenchmark(const std::vector<std::string>& arguments) {
+		const std::string fileName = getArgument(arguments, 0,
+			"LevelBenchmark.lvl");
+		const unsigned int width = std::stoul(getArgument(arguments, 1,
+			"10000"));
+		const unsigned int height = std::stoul(getArgument(arguments, 2,
+			"10000"));
+
+		// Generate the level
+		LunaLL::LevelProperties properties;
+		properties.dimensions = glm::uvec2(width, height);
+		properties.tileDimensions = glm::vec2(32.0f, 32.0f);
+		properties.chunkSize = 64;
+		LunaLL::LevelWriter writer;
+		if (!writer.initialize(properties)) {
+			return 1;
+		}
+		for (int i = 0; i < 8; i++) {
+			LunaLL::TileKind tileKind;
+			tileKind.textureFileName = "Textures/tile" + std::to_string(i)
+				+ ".png";
+			if (i == 7) {
+				tileKind.frameDimensions = glm::ivec2(4, 1);
+				tileKind.frameTime = 10.0f;
+			}
+			writer.addTileKind(tileKind);
+		}
+		Timer timer;
+		if (!writer.write(fileName, generateTile)) {
+			std::cout << "Failed to write " << fileName << "\n";
+			return 1;
+		}
+		std::cout << "Level: " << width << "x" << height << " tiles, chunk size "
+			<< properties.chunkSize << "\n";
+		report("Write time", timer.getMilliseconds(), "ms");
+		size_t baselineMemory = getPeakResidentMemory();
+
+		// Open the level by mapping it
+		LunaLL::LevelFile file;
+		timer.restart();
+		if (!file.open(fileName)) {
+			std::cout << "Failed to open " << fileName << "\n";
+			return 1;
+		}
+		report("Open time", timer.getMilliseconds(), "ms");
+
+		// Decode randomly chosen chunks one at a time
+		std::mt19937 random(1);
+		const glm::uvec2& chunkCounts = file.getChunkCounts();
+		std::vector<uint16_t> tiles;
+		std::vector<double> decodeTimes;
+		for (int i = 0; i < 2000; i++) {
+			glm::uvec2 chunk(random() % chunkCounts.x,
+				random() % chunkCounts.y);
+			timer.restart();
+			file.decodeChunk(chunk, tiles);
+			decodeTimes.push_back(timer.getMilliseconds() * 1000.0);
+		}
+		report("Chunk decode p50", getPercentile(decodeTimes, 50.0), "us");
+		report("Chunk decode p99", getPercentile(decodeTimes, 99.0), "us");
+		report("Chunk decode max", getPercentile(decodeTimes, 100.0), "us");
+		file.close();
+
+		// A chunk index offset which wraps past the end of the address space
+		// must be rejected rather than mapped
+		const std::string corruptFileName = fileName + ".corrupt";
+		std::filesystem::copy_file(fileName, corruptFileName,
+			std::filesystem::copy_options::overwrite_existing);
+		{
+			std::fstream corrupt(corruptFileName, std::ios::binary
+				| std::ios::in | std::ios::out);
+			const uint64_t chunkIndexOffset = ~(uint64_t)0 - 15;
+			corrupt.seekp(56);
+			corrupt.write((const char*)&chunkIndexOffset,
+				sizeof(chunkIndexOffset));
+		}
+		const bool openedCorrupt = file.open(corruptFileName);
+		file.close();
+		if (openedCorrupt) {
+			std::filesystem::remove(corruptFileName);
+			std::cout << "Opened a level with an overflowing chunk index\n";
+			return 1;
+		}
+
+		// A chunk which fails to decode is only tried once
+		std::filesystem::copy_file(fileName, corruptFileName,
+			std::filesystem::copy_options::overwrite_existing);
+		{
+			std::fstream corrupt(corruptFileName, std::ios::binary
+				| std::ios::in | std::ios::out);
+			uint64_t chunkIndexOffset = 0;
+			corrupt.seekg(56);
+			corrupt.read((char*)&chunkIndexOffset, sizeof(chunkIndexOffset));
+			const uint32_t encoding = 0xFFFFFFFF;
+			corrupt.seekp((std::streamoff)chunkIndexOffset + 12);
+			corrupt.write((const char*)&encoding, sizeof(encoding));
+		}
+		size_t chunksFailed = 0;
+		{
+			LunaLL::Level corruptLevel;
+			corruptLevel.initialize(corruptFileName, LunaLL::LOAD_STREAMED);
+			for (int i = 0; i < 3; i++) {
+				corruptLevel.update(glm::vec4(0.0f, 0.0f, 64.0f, 64.0f),
+					1.0f);
+			}
+			chunksFailed = corruptLevel.getStatistics().chunksFailed;
+			corruptLevel.destroy();
+		}
+		std::filesystem::remove(corruptFileName);
+		if (chunksFailed != 1) {
+			std::cout << "Retried a chunk which failed to decode\n";
+			return 1;
+		}
+
+		// Stream the level under a camera panning diagonally across it
+		LunaLL::Level level;
+		timer.restart();
+		if (!level.initialize(fileName, LunaLL::LOAD_STREAMED)) {
+			return 1;
+		}
+		report("Streamed initialize time", timer.getMilliseconds(), "ms");
+		const glm::vec2 viewDimensions(1920.0f, 1080.0f);
+		const glm::vec2 levelDimensions = glm::vec2(properties.dimensions)
+			* properties.tileDimensions;
+		std::vector<double> updateTimes;
+		size_t maximumResidentChunks = 0;
+		for (int i = 0; i < 3000; i++) {
+			glm::vec2 position = (levelDimensions - viewDimensions)
+				* ((float)i / 3000.0f);
+			timer.restart();
+			level.update(glm::vec4(position, viewDimensions), 1.0f);
+			updateTimes.push_back(timer.getMilliseconds());
+			maximumResidentChunks = std::max(maximumResidentChunks,
+				level.getResidentChunkCount());
+		}
+		const LunaLL::LevelStatistics& statistics = level.getStatistics();
+		report("Stream update p50", getPercentile(updateTimes, 50.0), "ms");
+		report("Stream update p99", getPercentile(updateTimes, 99.0), "ms");
+		report("Chunks decoded", (double)statistics.chunksDecoded, "chunks");
+		report("Mean chunk load latency", statistics.chunksDecoded == 0 ? 0.0
+			: statistics.totalDecodeTime * 1.0e6 / statistics.chunksDecoded,
+			"us");
+		report("Max chunk load latency", statistics.maximumDecodeTime * 1.0e6,
+			"us");
+		report("Max resident chunks", (double)maximumResidentChunks, "chunks");
+
+		// Views far off the level or not finite must decode nothing
+		const size_t chunksDecoded = statistics.chunksDecoded;
+		level.update(glm::vec4(1.0e30f, -1.0e30f, 1.0e3f, 1.0e3f), 1.0f);
+		level.update(glm::vec4(std::nanf(""), 0.0f, 1.0e3f, 1.0e3f), 1.0f);
+		if (statistics.chunksDecoded != chunksDecoded
+			|| level.getResidentChunkCount() != 0) {
+			std::cout << "Streamed chunks outside the level\n";
+			level.destroy();
+			return 1;
+		}
+		report("Peak RSS before open", baselineMemory / 1048576.0, "MiB");
+		report("Peak RSS", getPeakResidentMemory() / 1048576.0, "MiB");
+		level.destroy();
+		return 0;
+	}
+}
@@ -0,0 +1,240 @@
+/*
+File:		LogBenchmark.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@17:55
+Purpose:	Benchmark of the caller's cost of asynchronous logging against
+			the synchronous ActiasFW log, and the binary log decoder
+*/
+
+#include "Benchmark.h"
+
+#include <LunaLL/AsyncLog.h>
+#include <ActiasFW/ActiasFW.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using ActiasFW::Application;
+
+namespace TestDriver {
+	namespace {
+		// A stream buffer which discards everything written to it
+		class NullBuffer : public std::streambuf {
+		protected:
+			int overflow(int character) override {
+				return character;
+			}
+		};
+
+		/*
+		Write records from the calling thread, timing each call
+		Parameter: size_t count - The number of records to write
+		Parameter: size_t first - The index of the first record
+		Parameter: std::vector<double>* samples - Populated with the time of
+		each call in nanoseconds, or 0 to time nothing
+		*/
+		void writeRecords(size_t count, size_t first,
+			std::vector<double>* samples) {
+			for (size_t i = first; i < first + count; i++) {
+				std::chrono::steady_clock::time_point start
+					= std::chrono::steady_clock::now();
+				LUNALL_LOG(TestDriver, INFO, "Entity ", i, " moved to (",
+					(float)(i % 640), ", ", (float)(i % 480), ") in ",
+					0.016, " s");
+				if (samples != 0) {
+					samples->push_back(std::chrono::duration<double,
+						std::nano>(std::chrono::steady_clock::now()
+						- start).count());
+				}
+			}
+		}
+
+		/*
+		Report the distribution of per-call latencies
+		Parameter: const std::string& name - The name of the measurement
+		Parameter: const std::vector<double>& samples - The latencies in
+		nanoseconds
+		*/
+		void reportLatency(const std::string& name,
+			const std::vector<double>& samples) {
+			report(name + " p50", getPercentile(samples, 50.0), "ns");
+			report(name + " p99", getPercentile(samples, 99.0), "ns");
+			report(name + " p99.9", getPercentile(samples, 99.9), "ns");
+		}
+	}
+
+	int runLogBenchmark(const std::vector<std::string>& arguments) {
+		const size_t recordCount = std::stoul(getArgument(arguments, 0,
+			"200000"));
+		const unsigned int threadCount = std::max(2u, std::min(8u,
+			std::thread::hardware_concurrency()));
+		const std::string textFileName = "LogBenchmark.log";
+		const std::string binaryFileName = "LogBenchmark.llog";
+		std::filesystem::remove(textFileName);
+		std::cout << "Records: " << recordCount << "\n";
+
+		// Write every record synchronously through the ActiasFW log, with
+		// the console discarded so only formatting and the file are measured
+		NullBuffer nullBuffer;
+		std::streambuf* console = std::cout.rdbuf(&nullBuffer);
+		Application::Log.initialize(true, { textFileName },
+			"%Y-%m-%d %H:%M:%S");
+		std::vector<double> samples;
+		samples.reserve(recordCount);
+		Timer timer;
+		for (size_t i = 0; i < recordCount; i++) {
+			std::chrono::steady_clock::time_point start
+				= std::chrono::steady_clock::now();
+			ACTIASFW_LOG(TestDriver, Info, "Entity ", i, " moved to (",
+				(float)(i % 640), ", ", (float)(i % 480), ") in ", 0.016,
+				" s");
+			samples.push_back(std::chrono::duration<double, std::nano>(
+				std::chrono::steady_clock::now() - start).count());
+		}
+		double seconds = timer.getSeconds();
+		Application::Log.destroy();
+		std::cout.rdbuf(console);
+		reportLatency("Synchronous log call", samples);
+		report("Synchronous log throughput", recordCount / seconds / 1000.0,
+			"records/ms");
+		std::filesystem::remove(textFileName);
+
+		// Write the same records through the asynchronous log
+		LunaLL::LogConfiguration configuration;
+		configuration.console = false;
+		configuration.textFileNames = { textFileName };
+		configuration.threadBufferSize = 1 << 22;
+		LunaLL::AsyncLogManager::Log.initialize(configuration);
+		samples.clear();
+		timer.restart();
+		writeRecords(recordCount, 0, &samples);
+		const double callerSeconds = timer.getSeconds();
+		LunaLL::AsyncLogManager::Log.flush();
+		seconds = timer.getSeconds();
+		LunaLL::LogStatistics statistics
+			= LunaLL::AsyncLogManager::Log.getStatistics();
+		LunaLL::AsyncLogManager::Log.destroy();
+		reportLatency("Asynchronous log call", samples);
+		report("Asynchronous log caller throughput", recordCount
+			/ callerSeconds / 1000.0, "records/ms");
+		report("Asynchronous log throughput including flush", recordCount
+			/ seconds / 1000.0, "records/ms");
+		report("Asynchronous log batches", (double)statistics.batchesWritten,
+			"batches");
+		report("Asynchronous log records dropped",
+			(double)statistics.recordsDropped, "records");
+		std::filesystem::remove(textFileName);
+
+		// Log from several threads into small buffers to exercise the drop
+		// policy
+		configuration.threadBufferSize = 1 << 14;
+		LunaLL::AsyncLogManager::Log.initialize(configuration);
+		std::vector<std::thread> threads;
+		timer.restart();
+		for (unsigned int thread = 0; thread < threadCount; thread++) {
+			threads.emplace_back(writeRecords, recordCount / threadCount,
+				recordCount / threadCount * thread, nullptr);
+		}
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		LunaLL::AsyncLogManager::Log.flush();
+		seconds = timer.getSeconds();
+		statistics = LunaLL::AsyncLogManager::Log.getStatistics();
+		LunaLL::AsyncLogManager::Log.destroy();
+		const std::string name = "Asynchronous log with "
+			+ std::to_string(threadCount) + " threads and 16KB buffers";
+		report(name + " throughput", recordCount / seconds / 1000.0,
+			"records/ms");
+		report(name + " records written", (double)statistics.recordsWritten,
+			"records");
+		report(name + " records dropped", (double)statistics.recordsDropped,
+			"records");
+		std::filesystem::remove(textFileName);
+
+		// Threads which exit give their buffers back to later threads
+		configuration.maximumThreadCount = 2;
+		LunaLL::AsyncLogManager::Log.initialize(configuration);
+		for (unsigned int thread = 0; thread < 8; thread++) {
+			std::thread(writeRecords, 10, 0, nullptr).join();
+			LunaLL::AsyncLogManager::Log.flush();
+		}
+		statistics = LunaLL::AsyncLogManager::Log.getStatistics();
+		LunaLL::AsyncLogManager::Log.destroy();
+		configuration.maximumThreadCount
+			= LunaLL::LogConfiguration().maximumThreadCount;
+		std::filesystem::remove(textFileName);
+		if (statistics.recordsWritten != 80 || statistics.recordsDropped != 0) {
+			std::cout << "Short-lived threads were refused log buffers\n";
+			return 1;
+		}
+
+		// Measure a call at a level which is disabled at runtime
+		LunaLL::AsyncLogManager::Log.setLevel(LunaLL::LOG_WARNING);
+		timer.restart();
+		writeRecords(recordCount, 0, nullptr);
+		seconds = timer.getSeconds();
+		LunaLL::AsyncLogManager::Log.setLevel(LunaLL::LOG_INFO);
+		report("Disabled level log call", seconds * 1.0e9 / recordCount,
+			"ns");
+
+		// Write binary records and decode them again
+		configuration.textFileNames.clear();
+		configuration.binaryFileName = binaryFileName;
+		configuration.threadBufferSize = 1 << 22;
+		LunaLL::AsyncLogManager::Log.initialize(configuration);
+		timer.restart();
+		writeRecords(recordCount, 0, nullptr);
+		LunaLL::AsyncLogManager::Log.flush();
+		seconds = timer.getSeconds();
+		statistics = LunaLL::AsyncLogManager::Log.getStatistics();
+		LunaLL::AsyncLogManager::Log.destroy();
+		report("Binary log throughput including flush", recordCount
+			/ seconds / 1000.0, "records/ms");
+		report("Binary log records dropped", (double)statistics.recordsDropped,
+			"records");
+		report("Binary log size", (double)std::filesystem::file_size(
+			binaryFileName) / recordCount, "bytes/record");
+		std::ostringstream decoded;
+		timer.restart();
+		const bool valid = LunaLL::AsyncLogManager::decode(binaryFileName,
+			decoded);
+		seconds = timer.getSeconds();
+		const std::string text = decoded.str();
+		const size_t lineCount = std::count(text.begin(), text.end(), '\n');
+		size_t decodedCount = 0;
+		for (size_t position = text.find("[TestDriver]");
+			position != std::string::npos;
+			position = text.find("[TestDriver]", position + 1)) {
+			decodedCount++;
+		}
+		report("Binary log decode throughput", lineCount / seconds / 1000.0,
+			"records/ms");
+		report("Text log size", (double)text.size() / std::max(lineCount,
+			(size_t)1), "bytes/record");
+		std::filesystem::remove(binaryFileName);
+		if (!valid || decodedCount != statistics.recordsWritten) {
+			std::cout << "Decoded " << decodedCount << " of "
+				<< statistics.recordsWritten << " binary log records\n";
+			return 1;
+		}
+		return 0;
+	}
+
+	int runLogDecoder(const std::vector<std::string>& arguments) {
+		if (arguments.empty()) {
+			std::cout << "Usage: TestDriver logdecode <binary log file>\n";
+			return 1;
+		}
+		if (!LunaLL::AsyncLogManager::decode(arguments[0], std::cout)) {
+			std::cout << "Failed to decode binary log \"" << arguments[0]
+				<< "\"\n";
+			return 1;
+		}
+		return 0;
+	}
+}
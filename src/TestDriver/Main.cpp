@@ -0,0 +1,43 @@
+/*
+File:		Main.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@10:02
+Purpose:	Entry point for the TestDriver which runs LunaLE and LunaLL
+			benchmarks by name
+*/
+
+#include "Benchmark.h"
+
+#include <iostream>
+#include <map>
+
+int main(int argc, char** argv) {
+	// The set of benchmarks associated with their names
+	const std::map<std::string, int(*)(const std::vector<std::string>&)>
+		benchmarks = {
+		{ "audio", TestDriver::runAudioBenchmark },
+		{ "batch", TestDriver::runBatchBenchmark },
+		{ "jobs", TestDriver::runJobBenchmark },
+		{ "level", TestDriver::runLevelBenchmark },
+		{ "log", TestDriver::runLogBenchmark },
+		{ "logdecode", TestDriver::runLogDecoder },
+		{ "replay", TestDriver::runReplayBenchmark },
+		{ "spatial", TestDriver::runSpatialBenchmark },
+		{ "text", TestDriver::runTextBenchmark },
+		{ "texture", TestDriver::runTextureBenchmark },
+		{ "ui", TestDriver::runUIBenchmark },
+	};
+
+	if (argc < 2 || benchmarks.find(argv[1]) == benchmarks.end()) {
+		std::cout << "Usage: TestDriver <benchmark> [arguments...]\n"
+			<< "Benchmarks:\n";
+		for (const std::pair<const std::string,
+			int(*)(const std::vector<std::string>&)>& benchmark : benchmarks) {
+			std::cout << "\t" << benchmark.first << "\n";
+		}
+		return 1;
+	}
+
+	std::vector<std::string> arguments(argv + 2, argv + argc);
+	return benchmarks.at(argv[1])(arguments);
+}
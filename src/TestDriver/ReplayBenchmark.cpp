@@ -0,0 +1,606 @@
+/*
+File:		ReplayBenchmark.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@19:30
+Purpose:	Headless replay of a recorded level editing session through a
+			profiled scene, reporting frame time percentiles and a Chrome trace
+*/
+
+#include "Benchmark.h"
+
+#include <LunaLL/InputRecording.h>
+#include <LunaLL/Profiler.h>
+#include <LunaLL/SpriteBatch.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <unordered_map>
+
+namespace TestDriver {
+	namespace {
+		// The width and height of a painted tile in pixels
+		const float TILE_SIZE = 32.0f;
+		// The number of tiles painted on each side of the cursor's tile
+		const int BRUSH_RADIUS = 2;
+
+		// A headless level editing scene, the left mouse button paints tiles
+		// under the cursor in strokes, the right mouse button pans, scrolling
+		// zooms, control and Z undoes the last stroke, delete clears the
+		// tiles in view, and typed characters rename the level
+		class EditorScene : public ActiasFW::Scene {
+		public:
+			/*
+			Start editing an empty level drawn with a batch
+			Parameter: LunaLL::SpriteBatch& batch - The batch to draw tiles
+			with
+			Parameter: ActiasFW::GLSLShader& shader - The shader to draw tiles
+			with
+			*/
+			void start(LunaLL::SpriteBatch& batch,
+				ActiasFW::GLSLShader& shader) {
+				m_batch = &batch;
+				m_shader = &shader;
+				m_cursorID = m_batch->addQuad(LunaLL::SpriteBatchQuad(), 0,
+					shader);
+			}
+			/*
+			Get a hash of the level and editor state to compare replays
+			Returns: uint64_t - The hash
+			*/
+			uint64_t getChecksum() const {
+				uint64_t hash = 14695981039346656037ull;
+				const auto combine = [&hash](uint64_t value) {
+					hash = (hash ^ value) * 1099511628211ull;
+				};
+				uint64_t tiles = 0;
+				for (const std::pair<const uint64_t, unsigned int>& tile
+					: m_tiles) {
+					tiles += tile.first * 0x9E3779B97F4A7C15ull;
+				}
+				combine(tiles);
+				combine(m_tiles.size());
+				combine(std::hash<float>()(m_camera.x));
+				combine(std::hash<float>()(m_camera.y));
+				combine(std::hash<float>()(m_zoom));
+				combine(std::hash<float>()(m_time));
+				combine(std::hash<std::string>()(m_levelName));
+				return hash;
+			}
+			/*
+			Get the number of tiles in the level
+			Returns: size_t - The number of tiles
+			*/
+			size_t getTileCount() const {
+				return m_tiles.size();
+			}
+
+			/*
+			Track the control key, undo, and clear the view
+			Parameter: ActiasFW::KeyCode key - The key pressed
+			*/
+			void keyPressed(ActiasFW::KeyCode key) override {
+				if (key == ActiasFW::KEY_LEFT_CONTROL) {
+					m_control = true;
+				}
+				else if (key == ActiasFW::KEY_Z && m_control) {
+					undo();
+				}
+				else if (key == ActiasFW::KEY_DELETE) {
+					clearView();
+				}
+			}
+			/*
+			Track the control key
+			Parameter: ActiasFW::KeyCode key - The key released
+			*/
+			void keyReleased(ActiasFW::KeyCode key) override {
+				if (key == ActiasFW::KEY_LEFT_CONTROL) {
+					m_control = false;
+				}
+			}
+			/*
+			Add a character to the level's name
+			Parameter: char character - The character typed
+			*/
+			void characterTyped(char character) override {
+				m_levelName += character;
+			}
+			/*
+			Start a painting stroke or panning
+			Parameter: ActiasFW::MouseButtonCode button - The button pressed
+			*/
+			void mouseButtonPressed(ActiasFW::MouseButtonCode button)
+				override {
+				if (button == ActiasFW::MOUSE_BUTTON_LEFT) {
+					m_painting = true;
+					m_strokes.emplace_back();
+					paint();
+				}
+				else if (button == ActiasFW::MOUSE_BUTTON_RIGHT) {
+					m_panning = true;
+				}
+			}
+			/*
+			End a painting stroke or panning
+			Parameter: ActiasFW::MouseButtonCode button - The button released
+			*/
+			void mouseButtonReleased(ActiasFW::MouseButtonCode button)
+				override {
+				if (button == ActiasFW::MOUSE_BUTTON_LEFT) {
+					m_painting = false;
+				}
+				else if (button == ActiasFW::MOUSE_BUTTON_RIGHT) {
+					m_panning = false;
+				}
+			}
+			/*
+			Move the cursor, panning or painting under it
+			Parameter: const glm::vec2& distance - The distance moved
+			*/
+			void mouseCursorMoved(const glm::vec2& distance) override {
+				m_cursor += distance;
+				if (m_panning) {
+					m_targetCamera -= distance * m_zoom;
+				}
+				if (m_painting) {
+					paint();
+				}
+			}
+			/*
+			Zoom the view
+			Parameter: const glm::vec2& distance - The distance scrolled
+			*/
+			void mouseScrolled(const glm::vec2& distance) override {
+				m_zoom = glm::clamp(m_zoom * (1.0f - distance.y * 0.1f), 0.25f,
+					4.0f);
+			}
+
+		protected:
+			/*
+			Continue editing, input is handled by the listener callbacks
+			Returns: bool - Always true
+			*/
+			bool processInput() override {
+				return true;
+			}
+			/*
+			Ease the camera toward its target and pulse the cursor
+			Parameter: float timeStep - The number of frames elapsed
+			*/
+			void update(float timeStep) override {
+				m_time += timeStep;
+				m_camera += (m_targetCamera - m_camera) * std::min(1.0f,
+					0.2f * timeStep);
+				LunaLL::SpriteBatchQuad quad;
+				quad.position = glm::vec3(getCursorTile() * TILE_SIZE, 1.0f);
+				quad.dimensions = glm::vec2(TILE_SIZE);
+				quad.color = glm::vec4(1.0f, 1.0f, 1.0f, 0.5f + 0.5f
+					* std::sin(m_time * 0.1f));
+				m_batch->setQuad(m_cursorID, quad, 0);
+			}
+			/*
+			Build the batch of tiles
+			*/
+			void draw() override {
+				m_batch->build();
+			}
+
+		private:
+			// The batch drawing the tiles
+			LunaLL::SpriteBatch* m_batch = 0;
+			// The shader drawing the tiles
+			ActiasFW::GLSLShader* m_shader = 0;
+			// The ID of the cursor's quad in the batch
+			unsigned int m_cursorID = 0;
+			// The IDs of the tiles' quads by the keys of their cells
+			std::unordered_map<uint64_t, unsigned int> m_tiles;
+			// The keys of the cells painted in each stroke
+			std::vector<std::vector<uint64_t>> m_strokes;
+			// The cursor's position on the window
+			glm::vec2 m_cursor = glm::vec2(400.0f, 300.0f);
+			// The position of the camera
+			glm::vec2 m_camera = glm::vec2();
+			// The position the camera is easing toward
+			glm::vec2 m_targetCamera = glm::vec2();
+			// The scale of the view
+			float m_zoom = 1.0f;
+			// The time steps elapsed
+			float m_time = 0.0f;
+			// Whether the left mouse button is painting
+			bool m_painting = false;
+			// Whether the right mouse button is panning
+			bool m_panning = false;
+			// Whether the control key is down
+			bool m_control = false;
+			// The name of the level
+			std::string m_levelName = "";
+
+			/*
+			Get the cell under the cursor
+			Returns: glm::vec2 - The cell's coordinates
+			*/
+			glm::vec2 getCursorTile() const {
+				return glm::floor((m_camera + m_cursor * m_zoom) / TILE_SIZE);
+			}
+			/*
+			Get the key of a cell
+			Parameter: const glm::vec2& tile - The cell's coordinates
+			Returns: uint64_t - The key
+			*/
+			static uint64_t getKey(const glm::vec2& tile) {
+				return (uint64_t)(uint32_t)(int32_t)tile.x << 32
+					| (uint32_t)(int32_t)tile.y;
+			}
+			/*
+			Paint the tiles under the cursor's brush in the current stroke
+			*/
+			void paint() {
+				LUNALL_PROFILE_ZONE("Paint");
+				const glm::vec2 center = getCursorTile();
+				for (int y = -BRUSH_RADIUS; y <= BRUSH_RADIUS; y++) {
+					for (int x = -BRUSH_RADIUS; x <= BRUSH_RADIUS; x++) {
+						const glm::vec2 tile = center + glm::vec2(x, y);
+						const uint64_t key = getKey(tile);
+						if (m_tiles.find(key) != m_tiles.end()) {
+							continue;
+						}
+						LunaLL::SpriteBatchQuad quad;
+						quad.position = glm::vec3(tile * TILE_SIZE, 0.0f);
+						quad.dimensions = glm::vec2(TILE_SIZE);
+						quad.color = glm::vec4(glm::fract(tile.x * 0.13f),
+							glm::fract(tile.y * 0.17f), 0.5f, 1.0f);
+						m_tiles[key] = m_batch->addQuad(quad, 0, *m_shader);
+						m_strokes.back().push_back(key);
+					}
+				}
+			}
+			/*
+			Remove the tiles painted in the last stroke
+			*/
+			void undo() {
+				LUNALL_PROFILE_ZONE("Undo");
+				if (m_strokes.empty()) {
+					return;
+				}
+				for (uint64_t key : m_strokes.back()) {
+					std::unordered_map<uint64_t, unsigned int>::iterator it
+						= m_tiles.find(key);
+					if (it != m_tiles.end()) {
+						m_batch->remove(it->second);
+						m_tiles.erase(it);
+					}
+				}
+				m_strokes.pop_back();
+			}
+			/*
+			Remove the tiles in view
+			*/
+			void clearView() {
+				LUNALL_PROFILE_ZONE("Clear");
+				const glm::vec2 first = glm::floor(m_camera / TILE_SIZE);
+				const glm::vec2 last = glm::floor((m_camera
+					+ glm::vec2(800.0f, 600.0f) * m_zoom) / TILE_SIZE);
+				for (std::unordered_map<uint64_t, unsigned int>::iterator it
+					= m_tiles.begin(); it != m_tiles.end();) {
+					const glm::vec2 tile((float)(int32_t)(it->first >> 32),
+						(float)(int32_t)(uint32_t)it->first);
+					if (glm::all(glm::greaterThanEqual(tile, first))
+						&& glm::all(glm::lessThanEqual(tile, last))) {
+						m_batch->remove(it->second);
+						it = m_tiles.erase(it);
+					}
+					else {
+						it++;
+					}
+				}
+			}
+		};
+
+		// An editor scene run frame by frame from a recording instead of by
+		// the application, with its phases profiled
+		class HeadlessEditor : public LunaLL::ProfiledScene<EditorScene> {
+		public:
+			/*
+			Deliver a recorded frame's events then process input, update, and
+			draw as the application would
+			Parameter: const LunaLL::InputFrame& frame - The frame
+			*/
+			void runFrame(const LunaLL::InputFrame& frame) {
+				LunaLL::InputRecording::dispatch(frame, *this);
+				processInput();
+				for (float timeStep : frame.timeSteps) {
+					update(timeStep);
+				}
+				draw();
+			}
+		};
+
+		/*
+		Script an editing session of painting strokes, pans, zooms, undos,
+		clears, and renames at 60 updates per second, occasionally catching up
+		with two updates in a frame
+		Parameter: LunaLL::InputRecording& recording - Populated with the
+		session
+		Parameter: unsigned int frameCount - The number of frames
+		*/
+		void scriptSession(LunaLL::InputRecording& recording,
+			unsigned int frameCount) {
+			recording.clear();
+			uint32_t random = 12345;
+			const auto next = [&random]() {
+				random = random * 1664525u + 1013904223u;
+				return random >> 8;
+			};
+			const auto event = [](LunaLL::InputFrame& frame,
+				LunaLL::InputEventType type, int32_t code,
+				const glm::vec2& value) {
+				LunaLL::InputEvent event;
+				event.type = type;
+				event.code = code;
+				event.value = value;
+				frame.events.push_back(event);
+			};
+
+			unsigned int actionFrame = 0;
+			unsigned int action = 0;
+			glm::vec2 direction = glm::vec2(1.0f, 0.0f);
+			for (unsigned int i = 0; i < frameCount; i++) {
+				LunaLL::InputFrame& frame = recording.addFrame();
+				frame.timeSteps.push_back(1.0f);
+				if (next() % 100 == 0) {
+					frame.timeSteps.push_back(1.0f);
+				}
+
+				// Change action every two seconds, ending the last one
+				if (i == actionFrame) {
+					if (action == 0) {
+						event(frame, LunaLL::INPUT_MOUSE_BUTTON_RELEASED,
+							ActiasFW::MOUSE_BUTTON_LEFT, glm::vec2());
+					}
+					else if (action == 1) {
+						event(frame, LunaLL::INPUT_MOUSE_BUTTON_RELEASED,
+							ActiasFW::MOUSE_BUTTON_RIGHT, glm::vec2());
+					}
+					action = next() % 10;
+					actionFrame = i + 120;
+					direction = glm::normalize(glm::vec2((float)(next() % 200)
+						- 100.0f, (float)(next() % 200) - 100.0f)
+						+ glm::vec2(0.01f));
+					if (action == 0) {
+						event(frame, LunaLL::INPUT_MOUSE_BUTTON_PRESSED,
+							ActiasFW::MOUSE_BUTTON_LEFT, glm::vec2());
+					}
+					else if (action == 1) {
+						event(frame, LunaLL::INPUT_MOUSE_BUTTON_PRESSED,
+							ActiasFW::MOUSE_BUTTON_RIGHT, glm::vec2());
+					}
+					else if (action == 2) {
+						event(frame, LunaLL::INPUT_KEY_PRESSED,
+							ActiasFW::KEY_LEFT_CONTROL, glm::vec2());
+						event(frame, LunaLL::INPUT_KEY_PRESSED,
+							ActiasFW::KEY_Z, glm::vec2());
+						event(frame, LunaLL::INPUT_KEY_RELEASED,
+							ActiasFW::KEY_Z, glm::vec2());
+						event(frame, LunaLL::INPUT_KEY_RELEASED,
+							ActiasFW::KEY_LEFT_CONTROL, glm::vec2());
+					}
+					else if (action == 3 && next() % 4 == 0) {
+						event(frame, LunaLL::INPUT_KEY_PRESSED,
+							ActiasFW::KEY_DELETE, glm::vec2());
+						event(frame, LunaLL::INPUT_KEY_RELEASED,
+							ActiasFW::KEY_DELETE, glm::vec2());
+					}
+					else if (action == 4) {
+						for (char character : std::string("level")) {
+							event(frame, LunaLL::INPUT_CHARACTER_TYPED,
+								character, glm::vec2());
+						}
+					}
+				}
+
+				// Paint and pan strokes sweep the cursor, others wander it
+				const float speed = action <= 1 ? 6.0f : 2.0f;
+				for (int j = 0; j < 2; j++) {
+					event(frame, LunaLL::INPUT_MOUSE_CURSOR_MOVED, 0,
+						direction * speed * 0.5f);
+				}
+				if (action == 5 && i % 10 == 0) {
+					event(frame, LunaLL::INPUT_MOUSE_SCROLLED, 0, glm::vec2(
+						0.0f, next() % 2 == 0 ? 1.0f : -1.0f));
+				}
+			}
+		}
+
+		/*
+		Record a scripted session through an input recorder, delivering each
+		frame's events to it as the application's input manager would
+		Parameter: const LunaLL::InputRecording& script - The scripted session
+		Parameter: LunaLL::InputRecording& recording - Populated with the
+		recorded session
+		Returns: bool - Whether the recorder started
+		*/
+		bool recordSession(const LunaLL::InputRecording& script,
+			LunaLL::InputRecording& recording) {
+			recording.clear();
+			LunaLL::InputRecorder recorder;
+			if (!recorder.start(recording)) {
+				return false;
+			}
+			for (const LunaLL::InputFrame& frame : script.getFrames()) {
+				LunaLL::InputRecording::dispatch(frame, recorder);
+				recorder.beginFrame();
+				for (float timeStep : frame.timeSteps) {
+					recorder.addTimeStep(timeStep);
+				}
+			}
+			recorder.stop();
+			return true;
+		}
+
+		/*
+		Test whether two recordings hold the same events and time steps
+		Parameter: const LunaLL::InputRecording& first - The first recording
+		Parameter: const LunaLL::InputRecording& second - The second recording
+		Returns: bool - Whether the recordings are equal
+		*/
+		bool isSameSession(const LunaLL::InputRecording& first,
+			const LunaLL::InputRecording& second) {
+			const std::vector<LunaLL::InputFrame>& firstFrames
+				= first.getFrames();
+			const std::vector<LunaLL::InputFrame>& secondFrames
+				= second.getFrames();
+			if (firstFrames.size() != secondFrames.size()) {
+				return false;
+			}
+			for (size_t i = 0; i < firstFrames.size(); i++) {
+				const LunaLL::InputFrame& a = firstFrames[i];
+				const LunaLL::InputFrame& b = secondFrames[i];
+				if (a.timeSteps != b.timeSteps
+					|| a.events.size() != b.events.size()) {
+					return false;
+				}
+				for (size_t j = 0; j < a.events.size(); j++) {
+					if (a.events[j].type != b.events[j].type
+						|| a.events[j].code != b.events[j].code
+						|| a.events[j].controller != b.events[j].controller
+						|| a.events[j].value != b.events[j].value) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		/*
+		Replay a recording through a fresh headless editor
+		Parameter: const LunaLL::InputRecording& recording - The recording
+		Parameter: std::vector<double>& frameTimes - Populated with the time
+		of each frame in milliseconds
+		Parameter: size_t& tileCount - Set to the number of tiles at the end
+		Returns: uint64_t - The checksum of the editor's final state
+		*/
+		uint64_t replay(const LunaLL::InputRecording& recording,
+			std::vector<double>& frameTimes, size_t& tileCount) {
+			ActiasFW::GLSLShader shader;
+			LunaLL::TextureCache textures;
+			LunaLL::SpriteBatch batch;
+			batch.initialize(textures);
+			HeadlessEditor editor;
+			editor.start(batch, shader);
+			frameTimes.clear();
+			frameTimes.reserve(recording.getFrames().size());
+			Timer timer;
+			for (const LunaLL::InputFrame& frame : recording.getFrames()) {
+				timer.restart();
+				editor.runFrame(frame);
+				frameTimes.push_back(timer.getMilliseconds());
+			}
+			LunaLL::FrameProfiler::Profiler.endFrame();
+			tileCount = editor.getTileCount();
+			const uint64_t checksum = editor.getChecksum();
+			batch.destroy();
+			return checksum;
+		}
+	}
+
+	int runReplayBenchmark(const std::vector<std::string>& arguments) {
+		const std::string recordingFileName = getArgument(arguments, 0,
+			"ReplaySession.llin");
+		const unsigned int frameCount = std::stoul(getArgument(arguments, 1,
+			"3600"));
+		if (!createHiddenContext()) {
+			return 1;
+		}
+		HiddenContextGuard context;
+
+		// Capture a scripted session through a recorder and check it is
+		// unchanged after saving and loading it
+		LunaLL::InputRecording script;
+		scriptSession(script, frameCount);
+		LunaLL::InputRecording recording;
+		if (!recordSession(script, recording)) {
+			std::cout << "Failed to start the input recorder\n";
+			return 1;
+		}
+		const std::filesystem::path directory
+			= std::filesystem::temp_directory_path() / "LunaLLReplayBenchmark";
+		std::filesystem::create_directories(directory);
+		DirectoryRemover remover(directory);
+		const std::string roundTripFileName
+			= (directory / "RoundTrip.llin").string();
+		LunaLL::InputRecording loaded;
+		if (!recording.save(roundTripFileName)
+			|| !loaded.load(roundTripFileName)
+			|| !isSameSession(script, loaded)) {
+			std::cout << "The recorded session changed when saved and "
+				"loaded\n";
+			return 1;
+		}
+
+		// Save the recorded session when there is no recording to replay
+		if (!std::filesystem::exists(recordingFileName)) {
+			if (!recording.save(recordingFileName)) {
+				return 1;
+			}
+			std::cout << "Recorded session saved to \"" << recordingFileName
+				<< "\"\n";
+		}
+		if (!recording.load(recordingFileName)) {
+			return 1;
+		}
+		std::cout << "Frames: " << recording.getFrames().size()
+			<< ", events: " << recording.getEventCount() << "\n";
+
+		// Replay with the profiler tracing, then again without it to check
+		// the replay is deterministic and measure the profiler's overhead
+		std::vector<double> frameTimes;
+		size_t tileCount = 0;
+		LunaLL::FrameProfiler& profiler = LunaLL::FrameProfiler::Profiler;
+		profiler.initialize();
+		const uint64_t checksum = replay(recording, frameTimes, tileCount);
+		report("Frame time p50", getPercentile(frameTimes, 50.0), "ms");
+		report("Frame time p99", getPercentile(frameTimes, 99.0), "ms");
+		report("Frame time maximum", getPercentile(frameTimes, 100.0), "ms");
+		for (unsigned int zone = 0; zone < profiler.getZoneCount(); zone++) {
+			const LunaLL::FrameHistogram histogram = profiler.getHistogram(
+				zone);
+			if (histogram.getCount() == 0) {
+				continue;
+			}
+			const std::string name = "Zone " + profiler.getZoneName(zone);
+			report(name + " p50", histogram.getPercentile(50.0), "ms");
+			report(name + " p99", histogram.getPercentile(99.0), "ms");
+		}
+		report("Tiles at end", (double)tileCount, "tiles");
+		const std::string traceFileName = "ReplayTrace.json";
+		if (profiler.exportChromeTrace(traceFileName)) {
+			std::cout << "Trace written to \"" << traceFileName << "\"\n";
+		}
+		double profiledTotal = 0.0;
+		for (double time : frameTimes) {
+			profiledTotal += time;
+		}
+		profiler.destroy();
+
+		const uint64_t unprofiledChecksum = replay(recording, frameTimes,
+			tileCount);
+		double unprofiledTotal = 0.0;
+		for (double time : frameTimes) {
+			unprofiledTotal += time;
+		}
+		report("Unprofiled frame time p50", getPercentile(frameTimes, 50.0),
+			"ms");
+		report("Unprofiled frame time p99", getPercentile(frameTimes, 99.0),
+			"ms");
+		report("Profiler overhead", (profiledTotal - unprofiledTotal)
+			* 1000.0 / frameTimes.size(), "us/frame");
+		if (checksum != unprofiledChecksum) {
+			std::cout << "Replays diverged\n";
+			return 1;
+		}
+		std::cout << "Replays matched\n";
+		return 0;
+	}
+}
@@ -0,0 +1,184 @@
+/*
+File:		SpatialBenchmark.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@13:46
+Purpose:	Benchmark of spatial index queries and updates against brute force
+			searches
+*/
+
+#include "Benchmark.h"
+
+#include <LunaLL/SpatialIndex.h>
+#include <LunaLL/Viewport.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+
+namespace TestDriver {
+	int runSpatialBenchmark(const std::vector<std::string>& arguments) {
+		const size_t maximumCount = std::stoul(getArgument(arguments, 0,
+			"1000000"));
+		const glm::vec2 entityDimensions(16.0f, 16.0f);
+		const glm::vec2 viewDimensions(1920.0f, 1080.0f);
+
+		for (size_t count = 1000; count <= maximumCount; count *= 10) {
+			// Scatter the entities at a constant density
+			std::mt19937 random(1);
+			const float worldSize = std::sqrt((float)count) * 48.0f;
+			std::uniform_real_distribution<float> coordinate(0.0f, worldSize);
+			std::vector<ActiasFW::Entity> entities(count);
+			std::vector<glm::vec4> boxes(count);
+			for (size_t i = 0; i < count; i++) {
+				boxes[i] = glm::vec4(coordinate(random), coordinate(random),
+					entityDimensions);
+			}
+			std::cout << "Entities: " << count << "\n";
+
+			LunaLL::SpatialIndex index;
+			index.initialize(entityDimensions * 4.0f);
+			Timer timer;
+			for (size_t i = 0; i < count; i++) {
+				index.insert(entities[i], boxes[i]);
+			}
+			report("  Index insert", count / timer.getSeconds() / 1.0e6,
+				"Minserts/s");
+
+			// Query camera sized boxes
+			const size_t queryCount = std::max<size_t>(20, 20000000 / count);
+			std::vector<glm::vec4> queries(queryCount);
+			for (glm::vec4& query : queries) {
+				query = glm::vec4(coordinate(random), coordinate(random),
+					viewDimensions);
+			}
+			std::vector<unsigned int> IDs;
+			size_t found = 0;
+			timer.restart();
+			for (const glm::vec4& query : queries) {
+				index.query(query, IDs);
+				found += IDs.size();
+			}
+			report("  Index box query", queryCount / timer.getSeconds(),
+				"queries/s");
+			size_t bruteFound = 0;
+			timer.restart();
+			for (const glm::vec4& query : queries) {
+				IDs.clear();
+				for (unsigned int i = 0; i < count; i++) {
+					if (LunaLL::boxesOverlap(query, boxes[i])) {
+						IDs.push_back(i);
+					}
+				}
+				bruteFound += IDs.size();
+			}
+			report("  Brute force box query", queryCount / timer.getSeconds(),
+				"queries/s");
+			if (found != bruteFound) {
+				std::cout << "  Mismatched box query results\n";
+				return 1;
+			}
+
+			// Pick single points
+			timer.restart();
+			for (const glm::vec4& query : queries) {
+				index.query(glm::vec2(query), IDs);
+			}
+			report("  Index point query", queryCount / timer.getSeconds(),
+				"queries/s");
+
+			// Move a tenth of the entities a short distance
+			const size_t updateCount = count / 10;
+			std::uniform_real_distribution<float> step(-8.0f, 8.0f);
+			timer.restart();
+			for (int pass = 0; pass < 10; pass++) {
+				for (size_t i = 0; i < updateCount; i++) {
+					size_t moved = (i * 7919 + pass) % count;
+					boxes[moved].x += step(random);
+					boxes[moved].y += step(random);
+					index.update((unsigned int)moved, boxes[moved]);
+				}
+			}
+			report("  Index update", updateCount * 10.0 / timer.getSeconds()
+				/ 1.0e6, "Mupdates/s");
+
+			// Find every overlapping pair
+			std::vector<std::pair<unsigned int, unsigned int>> pairs;
+			timer.restart();
+			index.findIntersections(pairs);
+			report("  Index overlapping pairs", timer.getMilliseconds(), "ms");
+			if (count <= 10000) {
+				size_t brutePairs = 0;
+				timer.restart();
+				for (size_t i = 0; i < count; i++) {
+					for (size_t j = i + 1; j < count; j++) {
+						brutePairs += LunaLL::boxesOverlap(boxes[i], boxes[j]);
+					}
+				}
+				report("  Brute force overlapping pairs",
+					timer.getMilliseconds(), "ms");
+				if (brutePairs != pairs.size()) {
+					std::cout << "  Mismatched overlapping pair results\n";
+					return 1;
+				}
+			}
+			index.destroy();
+		}
+
+		// Indexed sprites keep their place in the index when they are moved
+		// and leave alone an index destroyed since they were inserted
+		LunaLL::SpatialIndex index;
+		index.initialize(entityDimensions * 4.0f);
+		std::vector<LunaLL::IndexedSprite<>> sprites(2);
+		for (size_t i = 0; i < sprites.size(); i++) {
+			sprites[i].initialize(glm::vec3((float)i * 100.0f, 0.0f, 0.0f),
+				entityDimensions, "");
+			sprites[i].setIndex(index);
+		}
+		sprites.reserve(sprites.size() * 16);
+		sprites[0].setPosition(glm::vec3(500.0f, 500.0f, 0.0f));
+		std::vector<unsigned int> IDs;
+		index.query(glm::vec2(508.0f, 508.0f), IDs);
+		bool correct = index.getSize() == 2 && IDs.size() == 1
+			&& index.getSprite(IDs[0]) == &sprites[0];
+		index.initialize(entityDimensions * 4.0f);
+		ActiasFW::Entity entity;
+		const unsigned int ID = index.insert(entity, glm::vec4(0.0f, 0.0f,
+			entityDimensions));
+		sprites[0].setPosition(glm::vec3(900.0f, 900.0f, 0.0f));
+		sprites.clear();
+		correct = correct && index.getSize() == 1
+			&& index.getEntity(ID) == &entity;
+		{
+			LunaLL::IndexedSprite<> survivor;
+			survivor.initialize(glm::vec3(), entityDimensions, "");
+			{
+				LunaLL::SpatialIndex scoped;
+				scoped.initialize(entityDimensions * 4.0f);
+				survivor.setIndex(scoped);
+			}
+			survivor.setPosition(glm::vec3(100.0f, 100.0f, 0.0f));
+			correct = correct && survivor.getIndex() == 0;
+		}
+
+		// Boxes which are not finite are rejected and far away boxes are
+		// kept in the outermost cells
+		const float infinity = std::numeric_limits<float>::infinity();
+		ActiasFW::Entity farEntity;
+		correct = correct && index.insert(farEntity, glm::vec4(std::nanf(""),
+			0.0f, entityDimensions)) == LunaLL::SpatialIndex::INVALID_ID
+			&& index.insert(farEntity, glm::vec4(1.0e30f, -1.0e30f,
+			entityDimensions)) != LunaLL::SpatialIndex::INVALID_ID;
+		index.query(glm::vec4(-infinity, 0.0f, infinity, 1.0f), IDs);
+		correct = correct && IDs.empty();
+		index.query(glm::vec4(-2.0e30f, -2.0e30f, 4.0e30f, 4.0e30f), IDs);
+		correct = correct && IDs.size() == 2;
+		index.destroy();
+		if (!correct) {
+			std::cout << "Indexed sprites lost track of their index\n";
+			return 1;
+		}
+		return 0;
+	}
+}
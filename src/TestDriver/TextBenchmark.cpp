@@ -0,0 +1,187 @@
+/*
+File:		TextBenchmark.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@16:30
+Purpose:	Benchmark of glyph throughput of cached text layout drawn through
+			the sprite batch against copying a glyph sprite per character each
+			frame
+*/
+
+#include "Benchmark.h"
+
+#include <LunaLL/TextLayout.h>
+
+#include <iostream>
+#include <map>
+
+namespace TestDriver {
+	namespace {
+#ifdef _WIN32
+		// The font drawn when no font is given
+		const std::string DEFAULT_FONT_FILE_NAME = "C:/Windows/Fonts/arial.ttf";
+#else
+		// The font drawn when no font is given
+		const std::string DEFAULT_FONT_FILE_NAME
+			= "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+#endif
+
+		/*
+		Get the text of a property panel row
+		Parameter: size_t row - The index of the row
+		Parameter: size_t value - The value shown in the row
+		Returns: std::string - The row's text
+		*/
+		std::string getRowText(size_t row, size_t value) {
+			return "Property " + std::to_string(row) + " position: ("
+				+ std::to_string(value % 4096) + ", "
+				+ std::to_string(value * 7 % 4096) + ")";
+		}
+	}
+
+	int runTextBenchmark(const std::vector<std::string>& arguments) {
+		const std::string fontFileName = getArgument(arguments, 0,
+			DEFAULT_FONT_FILE_NAME);
+		const size_t rowCount = std::stoul(getArgument(arguments, 1, "500"));
+		const unsigned int frameCount = std::stoul(getArgument(arguments, 2,
+			"300"));
+		if (!createHiddenContext()) {
+			return 1;
+		}
+
+		LunaLL::FontCache fonts;
+		fonts.initialize();
+		Timer timer;
+		const LunaLL::GlyphAtlas* atlas = fonts.getAtlas(fontFileName, 16);
+		if (atlas == 0) {
+			std::cout << "Failed to load font \"" << fontFileName << "\"\n";
+			return 1;
+		}
+		report("Glyph atlas build", timer.getMilliseconds(), "ms");
+		report("Glyph atlas size", (double)atlas->getDimensions().x,
+			"pixels");
+
+		std::vector<std::string> texts(rowCount);
+		std::vector<glm::vec4> boxes(rowCount);
+		size_t glyphCount = 0;
+		for (size_t row = 0; row < rowCount; row++) {
+			texts[row] = getRowText(row, row);
+			boxes[row] = glm::vec4(0.0f, row * 20.0f, 400.0f, 20.0f);
+			glyphCount += texts[row].size();
+		}
+		std::cout << "Rows: " << rowCount << ", characters: " << glyphCount
+			<< ", frames: " << frameCount << "\n";
+
+		// Copy a glyph sprite from an ordered map for each character each
+		// frame, as the graphics manager does when text is submitted
+		std::map<char, ActiasFW::Glyph> glyphs;
+		for (unsigned int character = 32; character < 127; character++) {
+			const LunaLL::GlyphMetrics& metrics = atlas->getGlyph(
+				(char)character);
+			ActiasFW::Glyph& glyph = glyphs[(char)character];
+			glyph.initialize(glm::vec3(), metrics.dimensions, fontFileName);
+			glyph.setTextureBox(metrics.textureBox);
+			glyph.setBearing(glm::ivec2(metrics.bearing));
+			glyph.setOffset((unsigned int)metrics.advance);
+		}
+		std::vector<ActiasFW::Glyph> submitted;
+		timer.restart();
+		for (unsigned int frame = 0; frame < frameCount; frame++) {
+			submitted.clear();
+			for (size_t row = 0; row < rowCount; row++) {
+				float pen = boxes[row].x;
+				for (char character : texts[row]) {
+					std::map<char, ActiasFW::Glyph>::const_iterator it
+						= glyphs.find(character);
+					if (it == glyphs.end()) {
+						continue;
+					}
+					submitted.push_back(it->second);
+					submitted.back().setPosition(glm::vec3(pen
+						+ it->second.getBearing().x, boxes[row].y, 0.0f));
+					pen += it->second.getOffset();
+				}
+			}
+		}
+		double seconds = timer.getSeconds();
+		report("Per-frame glyph copies", glyphCount * frameCount / seconds
+			/ 1000.0, "glyphs/ms");
+		submitted.clear();
+
+		// Draw the rows as text blocks in a retained batch
+		ActiasFW::GLSLShader shader;
+		LunaLL::TextureCache textures;
+		LunaLL::SpriteBatch batch;
+		batch.initialize(textures);
+		LunaLL::TextLayoutCache layouts;
+		layouts.initialize();
+		std::vector<LunaLL::TextBlock> blocks(rowCount);
+		for (LunaLL::TextBlock& block : blocks) {
+			block.initialize(batch, layouts, shader);
+		}
+
+		for (double fraction : { 0.0, 0.1, 1.0 }) {
+			const size_t changing = (size_t)(rowCount * fraction);
+			layouts.destroy();
+			layouts.initialize();
+			timer.restart();
+			for (unsigned int frame = 0; frame < frameCount; frame++) {
+				for (size_t i = 0; i < changing; i++) {
+					size_t row = (i * 7919 + frame) % rowCount;
+					texts[row] = getRowText(row, row + frame + 1);
+				}
+				for (size_t row = 0; row < rowCount; row++) {
+					blocks[row].set(texts[row], boxes[row], 0.0f, 1.0f,
+						glm::vec4(1.0f), *atlas, ActiasFW::ALIGN_LEFT,
+						ActiasFW::ALIGN_CENTER);
+				}
+				layouts.update();
+				batch.build();
+			}
+			seconds = timer.getSeconds();
+			const LunaLL::TextLayoutStatistics& statistics
+				= layouts.getStatistics();
+			std::string name = "Text blocks (" + std::to_string(
+				(int)(fraction * 100.0)) + "% changing)";
+			report(name, glyphCount * frameCount / seconds / 1000.0,
+				"glyphs/ms");
+			report(name + " layout hits", (double)statistics.hits, "lookups");
+			report(name + " layout misses", (double)statistics.misses,
+				"lookups");
+		}
+		report("Text block draw commands", (double)batch.getCommands().size(),
+			"commands");
+
+		// Look up the same rows' layouts each frame without text blocks
+		std::vector<LunaLL::TextQuad> quads;
+		timer.restart();
+		for (unsigned int frame = 0; frame < frameCount; frame++) {
+			for (size_t row = 0; row < rowCount; row++) {
+				LunaLL::TextLayoutCache::layout(*atlas, texts[row], boxes[row],
+					1.0f, ActiasFW::ALIGN_LEFT, ActiasFW::ALIGN_CENTER, quads);
+			}
+		}
+		seconds = timer.getSeconds();
+		report("Uncached layout", glyphCount * frameCount / seconds / 1000.0,
+			"glyphs/ms");
+		timer.restart();
+		for (unsigned int frame = 0; frame < frameCount; frame++) {
+			for (size_t row = 0; row < rowCount; row++) {
+				layouts.getLayout(*atlas, texts[row], boxes[row], 1.0f,
+					ActiasFW::ALIGN_LEFT, ActiasFW::ALIGN_CENTER);
+			}
+			layouts.update();
+		}
+		seconds = timer.getSeconds();
+		report("Cached layout lookup", glyphCount * frameCount / seconds
+			/ 1000.0, "glyphs/ms");
+
+		for (LunaLL::TextBlock& block : blocks) {
+			block.destroy();
+		}
+		batch.destroy();
+		layouts.destroy();
+		fonts.destroy();
+		destroyHiddenContext();
+		return 0;
+	}
+}
@@ -0,0 +1,204 @@
+/*
+File:		TextureBenchmark.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.15@14:55
+Purpose:	Benchmark of synchronous texture loading against background
+			decoding and atlasing in the texture cache
+*/
+
+#include "Benchmark.h"
+
+#include <LunaLL/SpriteBatch.h>
+#include <lodepng.h>
+
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <thread>
+
+namespace TestDriver {
+	namespace {
+		/*
+		Upload a texture cache's decoded textures once per simulated 60 Hz
+		frame until every requested texture is loaded
+		Parameter: LunaLL::TextureCache& textures - The texture cache
+		Parameter: std::vector<double>& frameTimes - Populated with the time
+		spent in each frame's update in milliseconds
+		*/
+		void waitForTextures(LunaLL::TextureCache& textures,
+			std::vector<double>& frameTimes) {
+			frameTimes.clear();
+			std::chrono::steady_clock::time_point frameEnd
+				= std::chrono::steady_clock::now();
+			while (textures.isLoading()) {
+				Timer frame;
+				textures.update();
+				frameTimes.push_back(frame.getMilliseconds());
+				frameEnd += std::chrono::microseconds(16667);
+				std::this_thread::sleep_until(frameEnd);
+			}
+		}
+
+		/*
+		Write the metrics of a texture cache to the console
+		Parameter: const LunaLL::TextureCache& textures - The texture cache
+		Parameter: const std::vector<double>& frameTimes - The time spent in
+		each frame's update in milliseconds
+		*/
+		void reportMetrics(const LunaLL::TextureCache& textures,
+			const std::vector<double>& frameTimes) {
+			const LunaLL::TextureCacheMetrics& metrics = textures.getMetrics();
+			report("  Frames until loaded", (double)frameTimes.size(),
+				"frames");
+			report("  Update time p50", getPercentile(frameTimes, 50.0), "ms");
+			report("  Update time p99", getPercentile(frameTimes, 99.0), "ms");
+			report("  Update time maximum", getPercentile(frameTimes, 100.0),
+				"ms");
+			report("  Mean decode time", metrics.texturesDecoded == 0 ? 0.0
+				: metrics.decodeSeconds * 1000.0 / metrics.texturesDecoded,
+				"ms");
+			report("  Mean upload time", metrics.texturesUploaded == 0 ? 0.0
+				: metrics.uploadSeconds * 1000.0 / metrics.texturesUploaded,
+				"ms");
+			report("  Textures atlased", (double)metrics.texturesAtlased,
+				"textures");
+			report("  Atlas pages", (double)metrics.atlasPages, "pages");
+			report("  Atlas occupancy", metrics.atlasOccupancy * 100.0, "%");
+			report("  Cached pages loaded", (double)metrics.cachedPagesLoaded,
+				"pages");
+		}
+	}
+
+	int runTextureBenchmark(const std::vector<std::string>& arguments) {
+		const size_t textureCount = std::stoul(getArgument(arguments, 0,
+			"1000"));
+		if (!createHiddenContext()) {
+			return 1;
+		}
+		HiddenContextGuard context;
+
+		// Generate small noisy textures with a few too large to atlas
+		const std::filesystem::path directory
+			= std::filesystem::temp_directory_path() / "LunaLLTextureBenchmark";
+		std::filesystem::remove_all(directory);
+		std::filesystem::create_directories(directory);
+		DirectoryRemover remover(directory);
+		std::mt19937 random(1);
+		std::uniform_int_distribution<unsigned int> size(8, 128);
+		std::vector<std::string> fileNames(textureCount);
+		for (size_t i = 0; i < textureCount; i++) {
+			unsigned int width = i % 50 == 0 ? 512 : size(random);
+			unsigned int height = i % 50 == 0 ? 512 : size(random);
+			std::vector<unsigned char> pixels((size_t)width * height * 4);
+			for (size_t p = 0; p < pixels.size(); p++) {
+				pixels[p] = (p & 3) == 3 ? 255
+					: (unsigned char)(random() & 0xF0);
+			}
+			fileNames[i] = (directory / ("texture" + std::to_string(i)
+				+ ".png")).string();
+			lodepng::encode(fileNames[i], pixels, width, height);
+		}
+		std::cout << "Textures: " << textureCount << "\n";
+
+		// Load every texture on the OpenGL thread
+		LunaLL::TextureCache textures;
+		Timer timer;
+		for (const std::string& fileName : fileNames) {
+			textures.getTexture(fileName);
+		}
+		glFinish();
+		report("Synchronous load stall", timer.getMilliseconds(), "ms");
+		textures.destroy();
+
+		// Decode in the background and upload within a budget each frame
+		LunaLL::TextureCacheConfiguration configuration;
+		configuration.cacheDirectory = (directory / "Cache").string();
+		std::vector<double> frameTimes;
+		textures.initialize(configuration);
+		timer.restart();
+		for (const std::string& fileName : fileNames) {
+			textures.getRegion(fileName);
+		}
+		waitForTextures(textures, frameTimes);
+		glFinish();
+		std::cout << "Background cold load\n";
+		report("  Time until loaded", timer.getMilliseconds(), "ms");
+		reportMetrics(textures, frameTimes);
+
+		// Draw one sprite per texture with their textures in atlas pages
+		ActiasFW::GLSLShader shader;
+		std::vector<ActiasFW::Sprite> sprites(textureCount);
+		for (size_t i = 0; i < textureCount; i++) {
+			sprites[i].initialize(glm::vec3((float)i * 16.0f, 0.0f, 0.0f),
+				glm::vec2(16.0f, 16.0f), fileNames[i]);
+		}
+		LunaLL::SpriteBatch batch;
+		batch.initialize(textures);
+		std::vector<unsigned int> IDs;
+		batch.add(sprites, shader, IDs);
+		batch.build();
+		report("  Draw commands", (double)batch.getCommands().size(),
+			"commands");
+
+		// Swapping a sprite between two atlased textures must move its
+		// texture coordinates into the new texture's region
+		bool swapped = true;
+		for (size_t i = 1; i < 3 && textureCount > 2; i++) {
+			sprites[1].setTextureFileName(fileNames[i]);
+			batch.build();
+			const glm::vec4& box = textures.getRegion(fileNames[i]).box;
+			for (size_t v = 0; v < 4; v++) {
+				const glm::vec2& coordinates = batch.getVertices()[IDs[1] * 4
+					+ v].textureCoordinates;
+				swapped = swapped && coordinates.x >= box.x
+					&& coordinates.x <= box.x + box.z && coordinates.y >= box.y
+					&& coordinates.y <= box.y + box.w;
+			}
+		}
+		batch.destroy();
+		if (!swapped) {
+			std::cout << "A sprite kept its old texture's coordinates\n";
+			return 1;
+		}
+
+		Timer saveTimer;
+		if (!textures.saveAtlasCache()) {
+			std::cout << "Failed to save the atlas cache\n";
+			return 1;
+		}
+		report("  Atlas cache save", saveTimer.getMilliseconds(), "ms");
+		textures.destroy();
+
+		// Reload the packed pages from the disk cache
+		textures.initialize(configuration);
+		timer.restart();
+		for (const std::string& fileName : fileNames) {
+			textures.getRegion(fileName);
+		}
+		waitForTextures(textures, frameTimes);
+		glFinish();
+		std::cout << "Background warm load\n";
+		report("  Time until loaded", timer.getMilliseconds(), "ms");
+		reportMetrics(textures, frameTimes);
+		textures.destroy();
+
+		// Rebuild a cached page which was lost since the cache was saved
+		std::filesystem::remove(directory / "Cache" / "atlas0.png");
+		textures.initialize(configuration);
+		for (const std::string& fileName : fileNames) {
+			textures.getRegion(fileName);
+		}
+		waitForTextures(textures, frameTimes);
+		bool rebuilt = true;
+		for (const std::string& fileName : fileNames) {
+			rebuilt = rebuilt && textures.getRegion(fileName).loaded;
+		}
+		rebuilt = rebuilt && textures.saveAtlasCache();
+		textures.destroy();
+		if (!rebuilt) {
+			std::cout << "Failed to rebuild a lost atlas page\n";
+			return 1;
+		}
+		return 0;
+	}
+}
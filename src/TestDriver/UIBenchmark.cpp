@@ -0,0 +1,277 @@
+/*
+File:		UIBenchmark.cpp
+Author:		Keegan MacDonald (keeganm742@gmail.com)
+Created:	2026.10.16@00:20
+Purpose:	Benchmark of scrolling a large list box at 60 Hz with a component
+			per value against a virtualized list box in a dirty-tracked UI
+			group
+*/
+
+#include "Benchmark.h"
+
+#include <LunaLL/UIComponents.h>
+
+#include <iostream>
+
+namespace TestDriver {
+	namespace {
+#ifdef _WIN32
+		// The font drawn when no font is given
+		const std::string DEFAULT_FONT_FILE_NAME = "C:/Windows/Fonts/arial.ttf";
+#else
+		// The font drawn when no font is given
+		const std::string DEFAULT_FONT_FILE_NAME
+			= "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+#endif
+		// The dimensions of the window the UI is placed in
+		const glm::ivec2 WINDOW_DIMENSIONS(1280, 720);
+		// The time of a frame at 60 Hz in milliseconds
+		const double FRAME_MILLISECONDS = 1000.0 / 60.0;
+
+		// A list box row drawn for every value, as a list box which keeps a
+		// component for each of its values does
+		struct ValueRow {
+			// The row's background
+			ActiasFW::Sprite sprite;
+			// The row's text
+			LunaLL::TextBlock text;
+		};
+
+		// A component which marks itself dirty in its first build, as one
+		// waiting on a texture or layout would
+		class SelfMarkingComponent : public LunaLL::UIComponent {
+		public:
+			// The number of times this component was built
+			unsigned int buildCount = 0;
+
+		protected:
+			/*
+			Count the build and mark this component dirty the first time
+			*/
+			void build() override {
+				if (++buildCount == 1) {
+					markDirty();
+				}
+			}
+			/*
+			Process no input
+			*/
+			void processInput() override {}
+			/*
+			Update nothing
+			Parameter: float timeStep - The number of frames elapsed
+			*/
+			void update(float) override {}
+			/*
+			Free nothing
+			*/
+			void destroy() override {}
+		};
+
+		/*
+		Report the frame times of a scrolling list
+		Parameter: const std::string& name - The name of the list
+		Parameter: std::vector<double>& frameTimes - The frame times in
+		milliseconds
+		*/
+		void reportFrames(const std::string& name,
+			std::vector<double>& frameTimes) {
+			report("  " + name + " frame p50", getPercentile(frameTimes, 50.0),
+				"ms");
+			report("  " + name + " frame p99", getPercentile(frameTimes, 99.0),
+				"ms");
+			report("  " + name + " 60 Hz budget p99", getPercentile(
+				frameTimes, 99.0) / FRAME_MILLISECONDS * 100.0, "%");
+		}
+	}
+
+	int runUIBenchmark(const std::vector<std::string>& arguments) {
+		const size_t valueCount = std::stoul(getArgument(arguments, 0,
+			"50000"));
+		const unsigned int frameCount = std::stoul(getArgument(arguments, 1,
+			"600"));
+		const unsigned int rowCount = std::stoul(getArgument(arguments, 2,
+			"24"));
+		const std::string fontFileName = getArgument(arguments, 3,
+			DEFAULT_FONT_FILE_NAME);
+		if (!createHiddenContext()) {
+			return 1;
+		}
+
+		LunaLL::FontCache fonts;
+		fonts.initialize();
+		const LunaLL::GlyphAtlas* atlas = fonts.getAtlas(fontFileName, 16);
+		if (atlas == 0) {
+			std::cout << "Failed to load font \"" << fontFileName << "\"\n";
+			return 1;
+		}
+		std::vector<std::string> values(valueCount);
+		for (size_t i = 0; i < valueCount; i++) {
+			values[i] = "Textures/Tiles/tile" + std::to_string(i) + ".png";
+		}
+		std::cout << "Values: " << valueCount << ", rows shown: " << rowCount
+			<< ", frames: " << frameCount << "\n";
+
+		const glm::vec4 listBox(0.05f * WINDOW_DIMENSIONS.x,
+			0.1f * WINDOW_DIMENSIONS.y, 0.3f * WINDOW_DIMENSIONS.x,
+			0.8f * WINDOW_DIMENSIONS.y);
+		const float rowHeight = listBox.w / rowCount;
+		const unsigned int scrollRange = valueCount > rowCount
+			? (unsigned int)(valueCount - rowCount) : 1;
+		ActiasFW::GLSLShader shader;
+		LunaLL::TextureCache textures;
+
+		// Keep a row for every value, moving every row and hiding the ones
+		// outside the list box each frame
+		std::vector<double> frameTimes;
+		{
+			std::cout << "Row per value\n";
+			LunaLL::SpriteBatch batch;
+			batch.initialize(textures);
+			LunaLL::TextLayoutCache layouts;
+			layouts.initialize();
+			std::vector<ValueRow> rows(valueCount);
+			Timer timer;
+			for (size_t i = 0; i < valueCount; i++) {
+				rows[i].sprite.initialize(glm::vec3(), glm::vec2(),
+					"Textures/UI/row.png");
+				batch.add(rows[i].sprite, shader);
+				rows[i].text.initialize(batch, layouts, shader);
+			}
+			const unsigned int baselineFrames = std::min(frameCount, 60u);
+			for (unsigned int frame = 0; frame <= baselineFrames; frame++) {
+				Timer frameTimer;
+				const size_t top = frame % scrollRange;
+				for (size_t i = 0; i < valueCount; i++) {
+					const bool shown = i >= top && i < top + rowCount;
+					const glm::vec4 box(listBox.x, listBox.y + listBox.w
+						- ((float)i - top + 1.0f) * rowHeight, listBox.z,
+						rowHeight);
+					rows[i].sprite.setPosition(glm::vec3(box.x, box.y, 0.0f));
+					rows[i].sprite.setDimensions(shown ? glm::vec2(box.z,
+						box.w) : glm::vec2());
+					rows[i].text.set(shown ? values[i] : "", box, 0.001f, 1.0f,
+						glm::vec4(1.0f), *atlas, ActiasFW::ALIGN_LEFT,
+						ActiasFW::ALIGN_CENTER);
+				}
+				layouts.update();
+				batch.build();
+				// The first frame lays out the rows and is reported separately
+				if (frame == 0) {
+					report("  Build", timer.getMilliseconds(), "ms");
+				}
+				else {
+					frameTimes.push_back(frameTimer.getMilliseconds());
+				}
+			}
+			reportFrames("Row per value", frameTimes);
+			report("  Batch sprites", (double)batch.getStatistics()
+				.spriteCount, "sprites");
+			for (ValueRow& row : rows) {
+				row.text.destroy();
+			}
+			batch.destroy();
+			layouts.destroy();
+		}
+
+		// Scroll a virtualized list box beside a tile set carousel and a
+		// panel of carousels which do not change
+		LunaLL::UIGroup group;
+		group.initialize(textures, *atlas, shader, 1.0f, glm::vec4(1.0f));
+		group.setWindowDimensions(WINDOW_DIMENSIONS);
+		LunaLL::UIListBox list;
+		Timer timer;
+		list.initialize(glm::vec3(0.05f, 0.1f, 0.0f), glm::vec2(0.3f, 0.8f),
+			"Textures/UI/list.png", values, rowCount, "Textures/UI/row.png");
+		LunaLL::UICarousel tileSets;
+		tileSets.initialize(glm::vec3(0.4f, 0.85f, 0.0f),
+			glm::vec2(0.3f, 0.05f), "Textures/UI/carousel.png", values,
+			values[0], 0.15f, "Textures/UI/button.png");
+		std::vector<LunaLL::UICarousel> panel(100);
+		for (size_t i = 0; i < panel.size(); i++) {
+			panel[i].initialize(glm::vec3(0.4f + i % 2 * 0.3f, 0.05f
+				+ i / 2 * 0.015f, 0.0f), glm::vec2(0.28f, 0.014f),
+				"Textures/UI/carousel.png", { "Off", "On" }, "Off", 0.15f,
+				"Textures/UI/button.png");
+		}
+		group.addComponent(list);
+		group.addComponent(tileSets);
+		for (LunaLL::UICarousel& carousel : panel) {
+			group.addComponent(carousel);
+		}
+		group.build();
+		std::cout << "Virtualized list box\n";
+		report("  Build", timer.getMilliseconds(), "ms");
+
+		for (bool rebuildAll : { false, true }) {
+			const std::string name = rebuildAll ? "Rebuild all" : "Dirty only";
+			frameTimes.clear();
+			size_t componentsBuilt = 0;
+			size_t spritesEncoded = 0;
+			for (unsigned int frame = 1; frame <= frameCount; frame++) {
+				Timer frameTimer;
+				list.setTopValueIndex(frame % scrollRange);
+				if (frame % 30 == 0) {
+					tileSets.setCurrentValueIndex(frame % valueCount);
+				}
+				if (rebuildAll) {
+					list.markDirty();
+					tileSets.markDirty();
+					for (LunaLL::UICarousel& carousel : panel) {
+						carousel.markDirty();
+					}
+				}
+				group.processInput();
+				group.update(1.0f);
+				group.build();
+				frameTimes.push_back(frameTimer.getMilliseconds());
+				componentsBuilt += group.getStatistics().componentsBuilt;
+				spritesEncoded += group.getStatistics().spritesEncoded;
+			}
+			reportFrames(name, frameTimes);
+			report("  " + name + " components built", (double)componentsBuilt
+				/ frameCount, "per frame");
+			report("  " + name + " sprites encoded", (double)spritesEncoded
+				/ frameCount, "per frame");
+		}
+		const LunaLL::UIGroupStatistics& statistics = group.getStatistics();
+		report("  Components", (double)statistics.componentCount,
+			"components");
+		report("  Batch sprites", (double)statistics.spriteCount, "sprites");
+		report("  List rows", (double)list.getRowCount(), "rows");
+
+		// The rows must show the values from the top index down
+		bool correct = list.getRowCount() == rowCount;
+		list.setTopValueIndex((unsigned int)(valueCount / 2));
+		list.setCurrentValueIndex((int)(valueCount / 2 + 1));
+		group.build();
+		for (size_t i = 0; i < list.getRowCount(); i++) {
+			const size_t index = valueCount / 2 + i;
+			correct = correct && list.getRowText(i)
+				== (index < valueCount ? values[index] : "");
+		}
+		correct = correct && list.getCurrentValue()
+			== values[valueCount / 2 + 1]
+			&& tileSets.getValueIndex(values[valueCount - 1])
+			== (int)valueCount - 1;
+
+		// A component which marks itself dirty while building is built again
+		// in the next build
+		SelfMarkingComponent selfMarking;
+		group.addComponent(selfMarking);
+		group.build();
+		correct = correct && selfMarking.buildCount == 1
+			&& selfMarking.isDirty();
+		group.build();
+		correct = correct && selfMarking.buildCount == 2
+			&& !selfMarking.isDirty();
+		group.destroy();
+		fonts.destroy();
+		destroyHiddenContext();
+		if (!correct) {
+			std::cout << "The virtualized list box lost its values\n";
+			return 1;
+		}
+		return 0;
+	}
+}